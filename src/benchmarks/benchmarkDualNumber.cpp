@@ -0,0 +1,196 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "common/CArrayWrapper.hpp"
+#include "common/DualNumber.hpp"
+#include "reactions/geochemistry/GeochemicalSystems.hpp"
+#include "reactions/massActions/MassActions.hpp"
+#include "reactions/reactionsSystems/KineticReactions.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <type_traits>
+
+using namespace hpcReact;
+
+/*
+ * Cost of the derivatives from dual numbers compared to the hand-coded ones.
+ * The dual number versions are several times slower (about 6x for the
+ * carbonate aggregates and 14x for the carbonate species rates), which is why
+ * DualNumber is only used to verify the hand-coded derivatives in the tests.
+ */
+
+namespace
+{
+
+/// The carbonate equilibrium: 7 primary species, 10 secondary species.
+struct CarbonateCase
+{
+  static constexpr auto const & params = geochemistry::carbonateSystemAllEquilibrium;
+};
+
+/// The ultramafic equilibrium: 4 primary species, 21 secondary species.
+struct UltramaficCase
+{
+  static constexpr auto const & params = geochemistry::ultramaficSystemAllEquilibrium;
+};
+
+/// The carbonate reactions as kinetic reactions: 17 species, 10 reactions.
+struct CarbonateKineticCase
+{
+  static constexpr auto const & params = geochemistry::carbonateSystemAllKinetic;
+};
+
+template< typename CASE >
+using ParamsType = std::remove_cv_t< std::remove_reference_t< decltype( CASE::params ) > >;
+
+/**
+ * The aggregate concentrations and their hand-coded derivatives.
+ */
+template< typename CASE >
+void aggregatesHandCoded( benchmark::State & state )
+{
+  constexpr int numPrimarySpecies = ParamsType< CASE >::numPrimarySpecies();
+  constexpr int numSecondarySpecies = ParamsType< CASE >::numSecondarySpecies();
+
+  double logPrimarySpeciesConcentrations[numPrimarySpecies];
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    logPrimarySpeciesConcentrations[i] = log( 1.0e-3 );
+  }
+  double logSecondarySpeciesConcentrations[numSecondarySpecies];
+  double aggregates[numPrimarySpecies];
+  double mobileAggregates[numPrimarySpecies];
+  CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregates;
+  CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dMobileAggregates;
+
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( logPrimarySpeciesConcentrations );
+    massActions::calculateTotalAndMobileAggregatePrimaryConcentrationsWrtLogC< double, int, int >( CASE::params.equilibriumReactionsParameters(),
+                                                                                                   logPrimarySpeciesConcentrations,
+                                                                                                   logSecondarySpeciesConcentrations,
+                                                                                                   aggregates,
+                                                                                                   mobileAggregates,
+                                                                                                   dAggregates,
+                                                                                                   dMobileAggregates );
+    benchmark::DoNotOptimize( aggregates );
+    benchmark::DoNotOptimize( dAggregates );
+    benchmark::ClobberMemory();
+  }
+}
+
+/**
+ * The aggregate concentrations and their derivatives from dual numbers.
+ */
+template< typename CASE >
+void aggregatesDualNumber( benchmark::State & state )
+{
+  constexpr int numPrimarySpecies = ParamsType< CASE >::numPrimarySpecies();
+  constexpr int numSecondarySpecies = ParamsType< CASE >::numSecondarySpecies();
+  using DualType = DualNumber< double, numPrimarySpecies >;
+
+  double logPrimarySpeciesConcentrations[numPrimarySpecies];
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    logPrimarySpeciesConcentrations[i] = log( 1.0e-3 );
+  }
+  DualType logPrimarySpeciesConcentrationsDual[numPrimarySpecies];
+  DualType logSecondarySpeciesConcentrations[numSecondarySpecies];
+  DualType aggregates[numPrimarySpecies];
+  DualType mobileAggregates[numPrimarySpecies];
+
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( logPrimarySpeciesConcentrations );
+    dualNumbers::makeIndependentVariables( logPrimarySpeciesConcentrations, logPrimarySpeciesConcentrationsDual );
+    massActions::calculateTotalAndMobileAggregatePrimaryConcentrations< DualType, int, int >( CASE::params.equilibriumReactionsParameters(),
+                                                                                              logPrimarySpeciesConcentrationsDual,
+                                                                                              logSecondarySpeciesConcentrations,
+                                                                                              aggregates,
+                                                                                              mobileAggregates );
+    benchmark::DoNotOptimize( aggregates );
+    benchmark::ClobberMemory();
+  }
+}
+
+/**
+ * The kinetic species rates and their hand-coded derivatives.
+ */
+template< typename CASE >
+void speciesRatesHandCoded( benchmark::State & state )
+{
+  using KineticReactionsType = reactionsSystems::KineticReactions< double, int, int, true >;
+  constexpr int numSpecies = ParamsType< CASE >::numSpecies();
+
+  double logSpeciesConcentrations[numSpecies];
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    logSpeciesConcentrations[i] = log( 1.0e-3 );
+  }
+  double speciesRates[numSpecies];
+  CArrayWrapper< double, numSpecies, numSpecies > speciesRatesDerivatives;
+
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( logSpeciesConcentrations );
+    KineticReactionsType::computeSpeciesRates( 298.15,
+                                               CASE::params.kineticReactionsParameters(),
+                                               logSpeciesConcentrations,
+                                               speciesRates,
+                                               speciesRatesDerivatives );
+    benchmark::DoNotOptimize( speciesRates );
+    benchmark::DoNotOptimize( speciesRatesDerivatives );
+    benchmark::ClobberMemory();
+  }
+}
+
+/**
+ * The kinetic species rates and their derivatives from dual numbers.
+ */
+template< typename CASE >
+void speciesRatesDualNumber( benchmark::State & state )
+{
+  constexpr int numSpecies = ParamsType< CASE >::numSpecies();
+  using DualType = DualNumber< double, numSpecies >;
+  using KineticReactionsType = reactionsSystems::KineticReactions< DualType, int, int, true >;
+
+  double logSpeciesConcentrations[numSpecies];
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    logSpeciesConcentrations[i] = log( 1.0e-3 );
+  }
+  DualType logSpeciesConcentrationsDual[numSpecies];
+  DualType speciesRates[numSpecies];
+
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( logSpeciesConcentrations );
+    dualNumbers::makeIndependentVariables( logSpeciesConcentrations, logSpeciesConcentrationsDual );
+    KineticReactionsType::computeSpeciesRates( 298.15,
+                                               CASE::params.kineticReactionsParameters(),
+                                               logSpeciesConcentrationsDual,
+                                               speciesRates );
+    benchmark::DoNotOptimize( speciesRates );
+    benchmark::ClobberMemory();
+  }
+}
+
+}
+
+BENCHMARK_TEMPLATE( aggregatesHandCoded, CarbonateCase );
+BENCHMARK_TEMPLATE( aggregatesDualNumber, CarbonateCase );
+BENCHMARK_TEMPLATE( aggregatesHandCoded, UltramaficCase );
+BENCHMARK_TEMPLATE( aggregatesDualNumber, UltramaficCase );
+BENCHMARK_TEMPLATE( speciesRatesHandCoded, CarbonateKineticCase );
+BENCHMARK_TEMPLATE( speciesRatesDualNumber, CarbonateKineticCase );
+
+BENCHMARK_MAIN();
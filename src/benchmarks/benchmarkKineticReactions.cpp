@@ -0,0 +1,212 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "common/CArrayWrapper.hpp"
+#include "reactions/geochemistry/GeochemicalSystems.hpp"
+#include "reactions/reactionsSystems/KineticReactions.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+using namespace hpcReact;
+
+namespace
+{
+
+/// The carbonate reactions as kinetic reactions: 17 species, 10 reactions.
+struct CarbonateKineticCase
+{
+  static constexpr auto const & params = geochemistry::carbonateSystemAllKinetic;
+};
+
+/// The ultramafic reactions as kinetic reactions: 25 species, 21 reactions.
+struct UltramaficKineticCase
+{
+  static constexpr auto const & params = geochemistry::ultramaficSystemAllKinetic;
+};
+
+template< typename CASE >
+using ParamsType = std::remove_cv_t< std::remove_reference_t< decltype( CASE::params ) > >;
+
+/**
+ * The mass-action reaction rates and their derivatives.
+ * @tparam LOGE_CONCENTRATION Whether the concentrations are passed as natural logarithms.
+ */
+template< typename CASE, bool LOGE_CONCENTRATION >
+void reactionRates( benchmark::State & state )
+{
+  using KineticReactionsType = reactionsSystems::KineticReactions< double, int, int, LOGE_CONCENTRATION >;
+  constexpr int numSpecies = ParamsType< CASE >::numSpecies();
+  constexpr int numReactions = ParamsType< CASE >::numReactions();
+  // extracting the kinetic parameters builds a new sparse stoichiometry, so keep it out of the timed loop
+  static constexpr auto params = CASE::params.kineticReactionsParameters();
+
+  double speciesConcentrations[numSpecies];
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    double const concentration = 1.0e-3 * ( 1.0 + 0.1 * i );
+    speciesConcentrations[i] = LOGE_CONCENTRATION ? log( concentration ) : concentration;
+  }
+  double reactionRates[numReactions];
+  CArrayWrapper< double, numReactions, numSpecies > reactionRatesDerivatives;
+
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( speciesConcentrations );
+    KineticReactionsType::computeReactionRates( 298.15,
+                                                params,
+                                                speciesConcentrations,
+                                                reactionRates,
+                                                reactionRatesDerivatives );
+    benchmark::DoNotOptimize( reactionRates );
+    benchmark::DoNotOptimize( reactionRatesDerivatives );
+    benchmark::ClobberMemory();
+  }
+}
+
+/**
+ * The species rates and their derivatives.
+ * @tparam LOGE_CONCENTRATION Whether the concentrations are passed as natural logarithms.
+ */
+template< typename CASE, bool LOGE_CONCENTRATION >
+void speciesRates( benchmark::State & state )
+{
+  using KineticReactionsType = reactionsSystems::KineticReactions< double, int, int, LOGE_CONCENTRATION >;
+  constexpr int numSpecies = ParamsType< CASE >::numSpecies();
+  static constexpr auto params = CASE::params.kineticReactionsParameters();
+
+  double speciesConcentrations[numSpecies];
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    double const concentration = 1.0e-3 * ( 1.0 + 0.1 * i );
+    speciesConcentrations[i] = LOGE_CONCENTRATION ? log( concentration ) : concentration;
+  }
+  double speciesRates[numSpecies];
+  CArrayWrapper< double, numSpecies, numSpecies > speciesRatesDerivatives;
+
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( speciesConcentrations );
+    KineticReactionsType::computeSpeciesRates( 298.15,
+                                               params,
+                                               speciesConcentrations,
+                                               speciesRates,
+                                               speciesRatesDerivatives );
+    benchmark::DoNotOptimize( speciesRates );
+    benchmark::DoNotOptimize( speciesRatesDerivatives );
+    benchmark::ClobberMemory();
+  }
+}
+
+/**
+ * The log-space reaction rates of a batch of cells with unit surface areas, evaluated one cell at a time.
+ * The concentrations of each cell are contiguous.
+ */
+template< typename CASE >
+void reactionRatesPerCell( benchmark::State & state )
+{
+  using KineticReactionsType = reactionsSystems::KineticReactions< double, int, int, true >;
+  constexpr int numSpecies = ParamsType< CASE >::numSpecies();
+  constexpr int numReactions = ParamsType< CASE >::numReactions();
+  static constexpr auto params = CASE::params.kineticReactionsParameters();
+  int const numCells = state.range( 0 );
+
+  std::vector< double > logSpeciesConcentrations( numCells * numSpecies );
+  for( int c = 0; c < numCells; ++c )
+  {
+    for( int i = 0; i < numSpecies; ++i )
+    {
+      logSpeciesConcentrations[c * numSpecies + i] = log( 1.0e-3 * ( 1.0 + 0.1 * i + 1.0e-4 * c ) );
+    }
+  }
+  std::vector< double > reactionRates( numCells * numReactions );
+  double surfaceArea[numReactions];
+  for( int r = 0; r < numReactions; ++r )
+  {
+    surfaceArea[r] = 1.0;
+  }
+  char reactionRatesDerivatives;
+
+  for( auto _ : state )
+  {
+    for( int c = 0; c < numCells; ++c )
+    {
+      double const ( &logSpeciesConcentrations_c )[numSpecies] = *reinterpret_cast< double const (*)[numSpecies] >( logSpeciesConcentrations.data() + c * numSpecies );
+      double ( &reactionRates_c )[numReactions] = *reinterpret_cast< double (*)[numReactions] >( reactionRates.data() + c * numReactions );
+      KineticReactionsType::template computeReactionRates< false >( 298.15,
+                                                                    params,
+                                                                    logSpeciesConcentrations_c,
+                                                                    surfaceArea,
+                                                                    reactionRates_c,
+                                                                    reactionRatesDerivatives );
+    }
+    benchmark::DoNotOptimize( reactionRates.data() );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * numCells );
+}
+
+/**
+ * The log-space reaction rates of a batch of cells from computeReactionRatesBatched.
+ */
+template< typename CASE >
+void reactionRatesBatched( benchmark::State & state )
+{
+  using KineticReactionsType = reactionsSystems::KineticReactions< double, int, int, true >;
+  constexpr int numSpecies = ParamsType< CASE >::numSpecies();
+  constexpr int numReactions = ParamsType< CASE >::numReactions();
+  static constexpr auto params = CASE::params.kineticReactionsParameters();
+  std::ptrdiff_t const numCells = state.range( 0 );
+
+  std::vector< double > logSpeciesConcentrations( numCells * numSpecies );
+  for( std::ptrdiff_t c = 0; c < numCells; ++c )
+  {
+    for( int i = 0; i < numSpecies; ++i )
+    {
+      logSpeciesConcentrations[i * numCells + c] = log( 1.0e-3 * ( 1.0 + 0.1 * i + 1.0e-4 * c ) );
+    }
+  }
+  std::vector< double > surfaceAreas( numCells * numReactions, 1.0 );
+  std::vector< double > reactionRates( numCells * numReactions );
+
+  for( auto _ : state )
+  {
+    KineticReactionsType::computeReactionRatesBatched( 298.15,
+                                                       params,
+                                                       numCells,
+                                                       logSpeciesConcentrations.data(),
+                                                       surfaceAreas.data(),
+                                                       reactionRates.data() );
+    benchmark::DoNotOptimize( reactionRates.data() );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * numCells );
+}
+
+}
+
+BENCHMARK_TEMPLATE( reactionRates, CarbonateKineticCase, false );
+BENCHMARK_TEMPLATE( reactionRates, CarbonateKineticCase, true );
+BENCHMARK_TEMPLATE( reactionRates, UltramaficKineticCase, false );
+BENCHMARK_TEMPLATE( reactionRates, UltramaficKineticCase, true );
+BENCHMARK_TEMPLATE( speciesRates, CarbonateKineticCase, false );
+BENCHMARK_TEMPLATE( speciesRates, CarbonateKineticCase, true );
+BENCHMARK_TEMPLATE( speciesRates, UltramaficKineticCase, false );
+BENCHMARK_TEMPLATE( speciesRates, UltramaficKineticCase, true );
+BENCHMARK_TEMPLATE( reactionRatesPerCell, CarbonateKineticCase )->Arg( 4096 );
+BENCHMARK_TEMPLATE( reactionRatesBatched, CarbonateKineticCase )->Arg( 4096 );
+BENCHMARK_TEMPLATE( reactionRatesPerCell, UltramaficKineticCase )->Arg( 4096 );
+BENCHMARK_TEMPLATE( reactionRatesBatched, UltramaficKineticCase )->Arg( 4096 );
+
+BENCHMARK_MAIN();
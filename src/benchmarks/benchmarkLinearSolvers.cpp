@@ -0,0 +1,101 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "common/nonlinearSolvers.hpp"
+#include "reactions/exampleSystems/MoMasBenchmark.hpp"
+#include "reactions/reactionsSystems/EquilibriumReactions.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace hpcReact;
+
+namespace
+{
+
+using EquilibriumReactionsType = reactionsSystems::EquilibriumReactions< double, int, int >;
+
+constexpr auto momasMediumParams = MoMasBenchmark::mediumCaseParams.equilibriumReactionsParameters();
+constexpr int numPrimarySpecies = decltype( momasMediumParams )::numPrimarySpecies();
+
+/// Unit row scaling of the aggregate residual.
+constexpr double unitRowScale[numPrimarySpecies] = { 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+/// Row scaling of the aggregate residual as if every total were expressed in
+/// a different unit, spanning 60 orders of magnitude.
+constexpr double illScaledRowScale[numPrimarySpecies] = { 1.0e-30, 1.0e20, 1.0, 1.0e-25, 1.0e30 };
+
+/**
+ * Solve the MoMaS medium initial equilibrium with newtonRaphson and the given
+ * linear solver, with the rows of the aggregate residual scaled by ROW_SCALE.
+ * The residual weights undo the scaling, so the convergence criterion is the
+ * same for every ROW_SCALE. Reports the Newton iteration count as a counter.
+ */
+template< typename LINEAR_SOLVER, double const (& ROW_SCALE)[numPrimarySpecies] >
+void momasMediumEquilibrium( benchmark::State & state )
+{
+  double const targetAggregatePrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, -3.0, 1.0e-20, 1.0, 1.0 };
+  double const initialPrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, 0.02, 1.0e-20, 1.0, 1.0 };
+
+  nonlinearSolvers::SolverControls< numPrimarySpecies > controls( 150, 1.0e-12 );
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    controls.residualWeights[i] = 1.0 / ROW_SCALE[i];
+  }
+
+  nonlinearSolvers::SolverStats stats;
+  for( auto _ : state )
+  {
+    double logPrimarySpeciesConcentration[numPrimarySpecies];
+    for( int i = 0; i < numPrimarySpecies; ++i )
+    {
+      logPrimarySpeciesConcentration[i] = log( initialPrimarySpeciesConcentration[i] );
+    }
+
+    auto computeResidualAndJacobian = [&]( double const (&logC)[numPrimarySpecies],
+                                           double (& r)[numPrimarySpecies],
+                                           double (& J)[numPrimarySpecies][numPrimarySpecies] )
+    {
+      CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > jacobian;
+      EquilibriumReactionsType::computeResidualAndJacobianAggregatePrimaryConcentrations( 0.0,
+                                                                                          momasMediumParams,
+                                                                                          targetAggregatePrimarySpeciesConcentration,
+                                                                                          logC,
+                                                                                          r,
+                                                                                          jacobian );
+      // the aggregate jacobian is assembled as -dr/dlogC
+      for( int i = 0; i < numPrimarySpecies; ++i )
+      {
+        r[i] *= ROW_SCALE[i];
+        for( int j = 0; j < numPrimarySpecies; ++j )
+        {
+          J[i][j] = -ROW_SCALE[i] * jacobian( i, j );
+        }
+      }
+    };
+
+    stats = nonlinearSolvers::newtonRaphson< numPrimarySpecies >( logPrimarySpeciesConcentration,
+                                                                  computeResidualAndJacobian,
+                                                                  controls,
+                                                                  LINEAR_SOLVER{} );
+    benchmark::DoNotOptimize( logPrimarySpeciesConcentration );
+  }
+  state.counters["iterations"] = stats.numIterations;
+  state.counters["converged"] = stats.isConverged;
+}
+
+}
+
+BENCHMARK_TEMPLATE( momasMediumEquilibrium, PivotedLUSolver, unitRowScale );
+BENCHMARK_TEMPLATE( momasMediumEquilibrium, EquilibratedSolver< PivotedLUSolver >, unitRowScale );
+BENCHMARK_TEMPLATE( momasMediumEquilibrium, PivotedLUSolver, illScaledRowScale );
+BENCHMARK_TEMPLATE( momasMediumEquilibrium, EquilibratedSolver< PivotedLUSolver >, illScaledRowScale );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,149 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "common/CArrayWrapper.hpp"
+#include "reactions/geochemistry/GeochemicalSystems.hpp"
+#include "reactions/reactionsSystems/MixedEquilibriumKineticReactions.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <type_traits>
+
+using namespace hpcReact;
+
+namespace
+{
+
+using MixedReactionsType = reactionsSystems::MixedEquilibriumKineticReactions< double, int, int, true >;
+
+/// The carbonate system: 7 primary species, 9 equilibrium and 1 kinetic reaction.
+struct CarbonateCase
+{
+  static constexpr auto const & params = geochemistry::carbonateSystem;
+};
+
+/// The ultramafic system: 9 primary species, 16 equilibrium and 5 kinetic reactions.
+struct UltramaficCase
+{
+  static constexpr auto const & params = geochemistry::ultramaficSystem;
+};
+
+/// The forge system: 10 primary species, 16 equilibrium and 3 kinetic reactions.
+struct ForgeCase
+{
+  static constexpr auto const & params = geochemistry::forgeSystem;
+};
+
+/**
+ * Storage of the inputs and outputs of updateMixedSystem for one cell.
+ */
+template< typename CASE >
+struct MixedSystemData
+{
+  using ParamsType = std::remove_cv_t< std::remove_reference_t< decltype( CASE::params ) > >;
+  static constexpr int numPrimarySpecies   = ParamsType::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = ParamsType::numSecondarySpecies();
+  static constexpr int numKineticReactions = ParamsType::numKineticReactions();
+
+  MixedSystemData()
+  {
+    for( int i = 0; i < numPrimarySpecies; ++i )
+    {
+      logPrimarySpeciesConcentration[i] = log( 1.0e-3 );
+    }
+    for( int r = 0; r < numKineticReactions; ++r )
+    {
+      surfaceArea[r] = 1.0;
+    }
+  }
+
+  double logPrimarySpeciesConcentration[numPrimarySpecies];
+  double surfaceArea[numKineticReactions];
+  CArrayWrapper< double, numSecondarySpecies > logSecondarySpeciesConcentration;
+  CArrayWrapper< double, numPrimarySpecies > aggregatePrimarySpeciesConcentration;
+  CArrayWrapper< double, numPrimarySpecies > mobileAggregatePrimarySpeciesConcentration;
+  CArrayWrapper< double, numKineticReactions > reactionRates;
+  CArrayWrapper< double, numPrimarySpecies > aggregateSpeciesRates;
+};
+
+/**
+ * Evaluate the mixed system with all of its derivatives, as in a Newton iteration.
+ */
+template< typename CASE >
+void updateMixedSystemFull( benchmark::State & state )
+{
+  using DataType = MixedSystemData< CASE >;
+  constexpr int numPrimarySpecies = DataType::numPrimarySpecies;
+  constexpr int numKineticReactions = DataType::numKineticReactions;
+
+  DataType data;
+  CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregatePrimarySpeciesConcentration;
+  CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dMobileAggregatePrimarySpeciesConcentration;
+  CArrayWrapper< double, numKineticReactions, numPrimarySpecies > dReactionRates;
+  CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregateSpeciesRates;
+
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( data.logPrimarySpeciesConcentration );
+    MixedReactionsType::updateMixedSystem( 298.15,
+                                           CASE::params,
+                                           data.logPrimarySpeciesConcentration,
+                                           data.surfaceArea,
+                                           data.logSecondarySpeciesConcentration,
+                                           data.aggregatePrimarySpeciesConcentration,
+                                           data.mobileAggregatePrimarySpeciesConcentration,
+                                           dAggregatePrimarySpeciesConcentration,
+                                           dMobileAggregatePrimarySpeciesConcentration,
+                                           data.reactionRates,
+                                           dReactionRates,
+                                           data.aggregateSpeciesRates,
+                                           dAggregateSpeciesRates );
+    benchmark::DoNotOptimize( data.aggregateSpeciesRates );
+    benchmark::DoNotOptimize( dAggregateSpeciesRates );
+    benchmark::ClobberMemory();
+  }
+}
+
+/**
+ * Evaluate the mixed system without derivatives, as in a line search or convergence check.
+ */
+template< typename CASE >
+void updateMixedSystemResidualOnly( benchmark::State & state )
+{
+  MixedSystemData< CASE > data;
+
+  for( auto _ : state )
+  {
+    benchmark::DoNotOptimize( data.logPrimarySpeciesConcentration );
+    MixedReactionsType::updateMixedSystem( 298.15,
+                                           CASE::params,
+                                           data.logPrimarySpeciesConcentration,
+                                           data.surfaceArea,
+                                           data.logSecondarySpeciesConcentration,
+                                           data.aggregatePrimarySpeciesConcentration,
+                                           data.mobileAggregatePrimarySpeciesConcentration,
+                                           data.reactionRates,
+                                           data.aggregateSpeciesRates );
+    benchmark::DoNotOptimize( data.aggregateSpeciesRates );
+    benchmark::ClobberMemory();
+  }
+}
+
+}
+
+BENCHMARK_TEMPLATE( updateMixedSystemFull, CarbonateCase );
+BENCHMARK_TEMPLATE( updateMixedSystemResidualOnly, CarbonateCase );
+BENCHMARK_TEMPLATE( updateMixedSystemFull, UltramaficCase );
+BENCHMARK_TEMPLATE( updateMixedSystemResidualOnly, UltramaficCase );
+BENCHMARK_TEMPLATE( updateMixedSystemFull, ForgeCase );
+BENCHMARK_TEMPLATE( updateMixedSystemResidualOnly, ForgeCase );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "common/nonlinearSolvers.hpp"
+#include "reactions/exampleSystems/MoMasBenchmark.hpp"
+#include "reactions/reactionsSystems/EquilibriumReactions.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace hpcReact;
+
+namespace
+{
+
+using EquilibriumReactionsType = reactionsSystems::EquilibriumReactions< double, int, int >;
+
+constexpr int numPrimarySpecies = MoMasBenchmark::easyCaseParams.numPrimarySpecies();
+
+/// The MoMaS easy initial equilibrium.
+struct MomasEasyCase
+{
+  static constexpr auto params = MoMasBenchmark::easyCaseParams.equilibriumReactionsParameters();
+  static constexpr double targetAggregatePrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, -2.0, 1.0e-20, 2.0, 1.0 };
+  static constexpr double initialPrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, 0.02, 1.0e-20, 1.0, 1.0 };
+};
+
+/// The MoMaS medium initial equilibrium.
+struct MomasMediumCase
+{
+  static constexpr auto params = MoMasBenchmark::mediumCaseParams.equilibriumReactionsParameters();
+  static constexpr double targetAggregatePrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, -3.0, 1.0e-20, 1.0, 1.0 };
+  static constexpr double initialPrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, 0.02, 1.0e-20, 1.0, 1.0 };
+};
+
+template< typename CASE >
+void initialGuess( double (& logPrimarySpeciesConcentration)[numPrimarySpecies] )
+{
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    logPrimarySpeciesConcentration[i] = log( CASE::initialPrimarySpeciesConcentration[i] );
+  }
+}
+
+void reportStats( benchmark::State & state, nonlinearSolvers::SolverStats const & stats )
+{
+  state.counters["iterations"] = stats.numIterations;
+  state.counters["evaluations"] = stats.numResidualEvaluations;
+  state.counters["converged"] = stats.isConverged;
+}
+
+/**
+ * Solve the initial equilibrium with the current solver, enforceEquilibrium_Aggregate.
+ */
+template< typename CASE >
+void aggregateNewton( benchmark::State & state )
+{
+  nonlinearSolvers::SolverStats stats;
+  for( auto _ : state )
+  {
+    double logPrimarySpeciesConcentration0[numPrimarySpecies];
+    double logPrimarySpeciesConcentration[numPrimarySpecies];
+    initialGuess< CASE >( logPrimarySpeciesConcentration0 );
+
+    stats = EquilibriumReactionsType::enforceEquilibrium_Aggregate( 0.0,
+                                                                    CASE::params,
+                                                                    CASE::targetAggregatePrimarySpeciesConcentration,
+                                                                    logPrimarySpeciesConcentration0,
+                                                                    logPrimarySpeciesConcentration );
+    benchmark::DoNotOptimize( logPrimarySpeciesConcentration );
+  }
+  reportStats( state, stats );
+}
+
+/**
+ * Solve the initial equilibrium with the dogleg trust-region solver on the
+ * same residual and Jacobian. The trial steps only evaluate the residual.
+ */
+template< typename CASE >
+void aggregateDogleg( benchmark::State & state )
+{
+  nonlinearSolvers::SolverStats stats;
+  for( auto _ : state )
+  {
+    double logPrimarySpeciesConcentration[numPrimarySpecies];
+    initialGuess< CASE >( logPrimarySpeciesConcentration );
+
+    auto computeResidual = [&]( double const (&logC)[numPrimarySpecies],
+                                double (& r)[numPrimarySpecies] )
+    {
+      EquilibriumReactionsType::computeResidualAggregatePrimaryConcentrations( 0.0,
+                                                                               CASE::params,
+                                                                               CASE::targetAggregatePrimarySpeciesConcentration,
+                                                                               logC,
+                                                                               r );
+    };
+    auto computeResidualAndJacobian = [&]( double const (&logC)[numPrimarySpecies],
+                                           double (& r)[numPrimarySpecies],
+                                           double (& J)[numPrimarySpecies][numPrimarySpecies] )
+    {
+      CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > jacobian;
+      EquilibriumReactionsType::computeResidualAndJacobianAggregatePrimaryConcentrations( 0.0,
+                                                                                          CASE::params,
+                                                                                          CASE::targetAggregatePrimarySpeciesConcentration,
+                                                                                          logC,
+                                                                                          r,
+                                                                                          jacobian );
+      // the aggregate jacobian is assembled as -dr/dlogC
+      for( int i = 0; i < numPrimarySpecies; ++i )
+      {
+        for( int j = 0; j < numPrimarySpecies; ++j )
+        {
+          J[i][j] = -jacobian( i, j );
+        }
+      }
+    };
+
+    // the same limit on the log concentration change as enforceEquilibrium_Aggregate
+    nonlinearSolvers::TrustRegionParameters trustRegion;
+    trustRegion.initialRadius = 10.0;
+    stats = nonlinearSolvers::doglegTrustRegion< numPrimarySpecies >( logPrimarySpeciesConcentration,
+                                                                      computeResidual,
+                                                                      computeResidualAndJacobian,
+                                                                      nonlinearSolvers::SolverControls< numPrimarySpecies >( 150, 1.0e-12 ),
+                                                                      trustRegion );
+    benchmark::DoNotOptimize( logPrimarySpeciesConcentration );
+  }
+  reportStats( state, stats );
+}
+
+}
+
+BENCHMARK_TEMPLATE( aggregateNewton, MomasEasyCase );
+BENCHMARK_TEMPLATE( aggregateDogleg, MomasEasyCase );
+BENCHMARK_TEMPLATE( aggregateNewton, MomasMediumCase );
+BENCHMARK_TEMPLATE( aggregateDogleg, MomasMediumCase );
+
+BENCHMARK_MAIN();
@@ -19,6 +19,41 @@
 namespace hpcReact
 {
 
+namespace internal
+{
+/**
+ * @brief Access entry (i,j) of a dense matrix.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the matrix.
+ * @param A The matrix.
+ * @param i The row index.
+ * @param j The column index.
+ * @return A[i][j]
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+REAL_TYPE entry( REAL_TYPE const (&A)[N][N], int const i, int const j )
+{
+  return A[i][j];
+}
+
+/**
+ * @brief Access entry (i,j) of a symmetric matrix.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the matrix.
+ * @param A The matrix.
+ * @param i The row index.
+ * @param j The column index.
+ * @return A(i,j)
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+REAL_TYPE entry( symmetricMatrix< REAL_TYPE, int, N > const & A, int const i, int const j )
+{
+  return A( i, j );
+}
+} // namespace internal
+
 template< typename REAL_TYPE, int N >
 HPCREACT_HOST_DEVICE
 bool isPositiveDefinite( REAL_TYPE const (&A)[N][N] )
@@ -53,13 +88,57 @@ bool isPositiveDefinite( REAL_TYPE const (&A)[N][N] )
 }
 
 
+/**
+ * @brief Cholesky factor of a symmetric positive definite matrix.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @details L is stored packed (lower triangle only), A = L L^T.
+ */
 template< typename REAL_TYPE, int N >
+struct CholeskyFactorization
+{
+  /// The lower triangular factor.
+  symmetricMatrix< REAL_TYPE, int, N > L;
+};
+
+/**
+ * @brief LU factors of a matrix with partial pivoting.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @details
+ *   The rows are stored in pivoted order, P A = L U. The strictly lower part of
+ *   LU holds the multipliers of L (unit diagonal implied), and the upper part
+ *   including the diagonal holds U. pivot[i] is the row of A that ended up in
+ *   row i.
+ */
+template< typename REAL_TYPE, int N >
+struct LUFactorization
+{
+  /// Packed L and U factors.
+  REAL_TYPE LU[N][N];
+  /// Row permutation.
+  int pivot[N];
+};
+
+/**
+ * @brief Compute the Cholesky factorization of a matrix.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @tparam MATRIX_TYPE A dense REAL_TYPE[N][N] or a symmetricMatrix. Only the
+ *         lower triangle is read.
+ * @param A The matrix to factor. May be factor.L, which is then factored in
+ *          place: entry (i,j) of A is read just before L(i,j) is written.
+ * @param factor The resulting factorization.
+ * @return false if a nonpositive pivot was encountered, i.e. A is not positive definite.
+ */
+template< typename REAL_TYPE, int N, typename MATRIX_TYPE >
 HPCREACT_HOST_DEVICE
-void solveNxN_Cholesky( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N] )
+bool factorNxN_Cholesky( MATRIX_TYPE const & A,
+                         CholeskyFactorization< REAL_TYPE, N > & factor )
 {
-  REAL_TYPE L[N][N] = {{0}};
+  symmetricMatrix< REAL_TYPE, int, N > & L = factor.L;
+  bool isPositive = true;
 
-  // **Cholesky Decomposition**
   for( int i = 0; i < N; i++ )
   {
     for( int j = 0; j <= i; j++ )
@@ -67,149 +146,786 @@ void solveNxN_Cholesky( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REA
       REAL_TYPE sum = 0;
       for( int k = 0; k < j; k++ )
       {
-        sum += L[i][k] * L[j][k];
+        sum += L( i, k ) * L( j, k );
       }
       if( i == j )
-        L[i][j] = sqrt( A[i][i] - sum );
+      {
+        REAL_TYPE const d = internal::entry( A, i, i ) - sum;
+        isPositive = isPositive && d > 0;
+        L( i, j ) = sqrt( d );
+      }
       else
-        L[i][j] = (A[i][j] - sum) / L[j][j];
+      {
+        L( i, j ) = ( internal::entry( A, i, j ) - sum ) / L( j, j );
+      }
     }
   }
+  return isPositive;
+}
+
+/**
+ * @brief Solve A x = b using a Cholesky factorization of A.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param factor The factorization computed by factorNxN_Cholesky.
+ * @param b The right hand side.
+ * @param x The solution.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+void solveNxN_Cholesky( CholeskyFactorization< REAL_TYPE, N > const & factor,
+                        REAL_TYPE const (&b)[N],
+                        REAL_TYPE (& x)[N] )
+{
+  symmetricMatrix< REAL_TYPE, int, N > const & L = factor.L;
 
   // **Forward Substitution: Solve L y = b**
-  //REAL_TYPE y[N];
   for( int i = 0; i < N; i++ )
   {
     x[i] = b[i];
     for( int j = 0; j < i; j++ )
-      x[i] -= L[i][j] * x[j];
-    x[i] /= L[i][i];
+    {
+      x[i] -= L( i, j ) * x[j];
+    }
+    x[i] /= L( i, i );
   }
 
   // **Backward Substitution: Solve L^T x = y**
   for( int i = N - 1; i >= 0; i-- )
   {
-//    x[i] = y[i];
     for( int j = i + 1; j < N; j++ )
-      x[i] -= L[j][i] * x[j];
-    x[i] /= L[i][i];
+    {
+      x[i] -= L( j, i ) * x[j];
+    }
+    x[i] /= L( i, i );
   }
 }
 
+/**
+ * @brief Solve a symmetric positive definite system with a Cholesky factorization.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param A The matrix.
+ * @param b The right hand side.
+ * @param x The solution.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+void solveNxN_Cholesky( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N] )
+{
+  CholeskyFactorization< REAL_TYPE, N > factor;
+  factorNxN_Cholesky< REAL_TYPE, N >( A, factor );
+  solveNxN_Cholesky( factor, b, x );
+}
 
-
+/**
+ * @brief Solve a symmetric positive definite system with a Cholesky factorization.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param A The matrix in packed symmetric storage.
+ * @param b The right hand side.
+ * @param x The solution.
+ */
 template< typename REAL_TYPE, int N >
 HPCREACT_HOST_DEVICE
 void solveNxN_Cholesky( symmetricMatrix< REAL_TYPE, int, N > const & A,
                         REAL_TYPE const (&b)[N],
                         REAL_TYPE (& x)[N] )
 {
-  symmetricMatrix< REAL_TYPE, int, N > L = {0};
+  CholeskyFactorization< REAL_TYPE, N > factor;
+  factorNxN_Cholesky< REAL_TYPE, N >( A, factor );
+  solveNxN_Cholesky( factor, b, x );
+}
+
+/**
+ * @brief Compute the LU factorization with partial pivoting of a matrix.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param A The matrix to factor.
+ * @param factor The resulting factorization.
+ * @return false if a zero pivot was encountered, i.e. A is singular.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+bool factorNxN_LU( REAL_TYPE const (&A)[N][N], LUFactorization< REAL_TYPE, N > & factor )
+{
+  REAL_TYPE (& LU)[N][N] = factor.LU;
+  int (& pivot)[N] = factor.pivot;
 
-  // **Cholesky Decomposition**
   for( int i = 0; i < N; i++ )
   {
-    for( int j = 0; j <= i; j++ )
+    pivot[i] = i;
+    for( int j = 0; j < N; j++ )
     {
-      REAL_TYPE sum = 0;
-      for( int k = 0; k < j; k++ )
+      LU[i][j] = A[i][j];
+    }
+  }
+
+  for( int k = 0; k < N-1; k++ )
+  {
+    // **Find Pivot Row**
+    int max_row = k;
+    REAL_TYPE max_val = fabs( LU[k][k] );
+    for( int i = k + 1; i < N; i++ )
+    {
+      if( fabs( LU[i][k] ) > max_val )
       {
-        sum += L( i, k ) * L( j, k );
+        max_val = fabs( LU[i][k] );
+        max_row = i;
       }
-      if( i == j )
+    }
+
+    // **Swap Rows**
+    if( max_row != k )
+    {
+      int temp = pivot[k];
+      pivot[k] = pivot[max_row];
+      pivot[max_row] = temp;
+      for( int j = 0; j < N; j++ )
       {
-        L( i, j ) = sqrt( A( i, i ) - sum );
+        REAL_TYPE const tempValue = LU[k][j];
+        LU[k][j] = LU[max_row][j];
+        LU[max_row][j] = tempValue;
       }
-      else
+    }
+
+    // **Gaussian Elimination, keeping the multipliers**
+    for( int i = k + 1; i < N; i++ )
+    {
+      REAL_TYPE factor_ik = LU[i][k] / LU[k][k];
+      for( int j = k + 1; j < N; j++ )
       {
-        L( i, j ) = (A( i, j ) - sum) / L[j][j];
+        LU[i][j] -= factor_ik * LU[k][j];
       }
+      LU[i][k] = factor_ik;
     }
   }
 
-  // **Forward Substitution: Solve L y = b**
-  REAL_TYPE y[N];
+  bool isNonsingular = true;
   for( int i = 0; i < N; i++ )
   {
-    y[i] = b[i];
-    for( int j = 0; j < i; j++ )
+    isNonsingular = isNonsingular && fabs( LU[i][i] ) > 0;
+  }
+  return isNonsingular;
+}
+
+/**
+ * @brief Solve A x = b using an LU factorization of A.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param factor The factorization computed by factorNxN_LU.
+ * @param b The right hand side.
+ * @param x The solution.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+void solveNxN_LU( LUFactorization< REAL_TYPE, N > const & factor, REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N] )
+{
+  REAL_TYPE const (&LU)[N][N] = factor.LU;
+
+  // **Forward Substitution: Solve L y = P b**
+  for( int i = 0; i < N; i++ )
+  {
+    x[i] = b[factor.pivot[i]];
+    for( int k = 0; k < i; k++ )
     {
-      y[i] -= L( i, j ) * y[j];
+      x[i] -= LU[i][k] * x[k];
     }
-    y[i] /= L( i, i );
   }
 
-  // **Backward Substitution: Solve L^T x = y**
-  for( int i = N - 1; i >= 0; i-- )
+  // **Back-Substitution: Solve U x = y**
+  for( int i = N - 1; i >= 0; --i )
   {
-    x[i] = y[i];
     for( int j = i + 1; j < N; j++ )
     {
-      x[i] -= L( j, i ) * x[j];
+      x[i] -= LU[i][j] * x[j];
     }
-    x[i] /= L( i, i );
+    x[i] /= LU[i][i];
   }
 }
 
-
+/**
+ * @brief Compute the LU factorization of a matrix starting from a guessed pivot order.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param A The matrix to factor.
+ * @param factor The resulting factorization.
+ * @param pivotHint A row permutation of A, e.g. the pivot of the factorization
+ *        of a previous iteration or of a neighbouring cell. May alias factor.pivot.
+ * @param pivotThreshold The hinted pivot is kept while its magnitude is at
+ *        least pivotThreshold times the largest magnitude below it in its column.
+ * @return false if a zero pivot was encountered, i.e. A is singular.
+ * @details
+ *   The rows are first placed in the hinted order. At each elimination step
+ *   the hinted pivot is tested against the column maximum, which is a branch
+ *   free reduction, and the row search and swap of partial pivoting are only
+ *   done when the test fails. Jacobians of the same system in successive
+ *   iterations or neighbouring cells nearly always select the same pivots, so
+ *   the data dependent search is normally skipped. The threshold bounds the
+ *   multipliers by 1/pivotThreshold. With pivotThreshold = 1 this reduces to
+ *   partial pivoting. factor.pivot holds the order that was actually used and
+ *   can be passed as the hint of the next factorization.
+ */
 template< typename REAL_TYPE, int N >
 HPCREACT_HOST_DEVICE
-void solveNxN_pivoted( REAL_TYPE (& A)[N][N], REAL_TYPE (& b)[N], REAL_TYPE (& x)[N] )
+bool factorNxN_LU( REAL_TYPE const (&A)[N][N],
+                   LUFactorization< REAL_TYPE, N > & factor,
+                   int const (&pivotHint)[N],
+                   REAL_TYPE const pivotThreshold = 0.1 )
 {
+  REAL_TYPE (& LU)[N][N] = factor.LU;
+  int (& pivot)[N] = factor.pivot;
 
-
-  int pivot[N]; // Row index tracker
   for( int i = 0; i < N; i++ )
   {
-    pivot[i] = i;
+    pivot[i] = pivotHint[i];
+    for( int j = 0; j < N; j++ )
+    {
+      LU[i][j] = A[pivot[i]][j];
+    }
   }
 
-  // **Step 1: Forward Elimination with Pivoting**
   for( int k = 0; k < N-1; k++ )
   {
-    // **Find Pivot Row**
-    int max_row = k;
-    REAL_TYPE max_val = fabs( A[pivot[k]][k] );
+    // **Check the hinted pivot against the rest of the column**
+    REAL_TYPE columnMax = 0;
     for( int i = k + 1; i < N; i++ )
     {
-      if( fabs( A[pivot[i]][k] ) > max_val )
-      {
-        max_val = fabs( A[pivot[i]][k] );
-        max_row = i;
-      }
+      REAL_TYPE const value = fabs( LU[i][k] );
+      columnMax = value > columnMax ? value : columnMax;
     }
 
-    // **Swap Rows in Pivot Array**
-    if( max_row != k )
+    // **Fall back to the partial pivoting search and swap**
+    if( fabs( LU[k][k] ) < pivotThreshold * columnMax )
     {
+      int max_row = k;
+      REAL_TYPE max_val = fabs( LU[k][k] );
+      for( int i = k + 1; i < N; i++ )
+      {
+        if( fabs( LU[i][k] ) > max_val )
+        {
+          max_val = fabs( LU[i][k] );
+          max_row = i;
+        }
+      }
+
       int temp = pivot[k];
       pivot[k] = pivot[max_row];
       pivot[max_row] = temp;
+      for( int j = 0; j < N; j++ )
+      {
+        REAL_TYPE const tempValue = LU[k][j];
+        LU[k][j] = LU[max_row][j];
+        LU[max_row][j] = tempValue;
+      }
     }
 
-    // **Gaussian Elimination**
+    // **Gaussian Elimination, keeping the multipliers**
     for( int i = k + 1; i < N; i++ )
     {
-      REAL_TYPE factor = A[pivot[i]][k] / A[pivot[k]][k];
-      for( int j = k; j < N; j++ )
+      REAL_TYPE factor_ik = LU[i][k] / LU[k][k];
+      for( int j = k + 1; j < N; j++ )
       {
-        A[pivot[i]][j] -= factor * A[pivot[k]][j];
+        LU[i][j] -= factor_ik * LU[k][j];
       }
-      b[pivot[i]] -= factor * b[pivot[k]];
+      LU[i][k] = factor_ik;
     }
   }
 
-  // **Step 2: Back-Substitution**
-  for( int i = N - 1; i >= 0; --i )
+  bool isNonsingular = true;
+  for( int i = 0; i < N; i++ )
   {
-    x[i] = b[pivot[i]];
-    for( int j = i + 1; j < N; j++ )
+    isNonsingular = isNonsingular && fabs( LU[i][i] ) > 0;
+  }
+  return isNonsingular;
+}
+
+/**
+ * @brief Solve a linear system with LU and partial pivoting.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param A The matrix.
+ * @param b The right hand side.
+ * @param x The solution.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+void solveNxN_pivoted( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N] )
+{
+  LUFactorization< REAL_TYPE, N > factor;
+  factorNxN_LU( A, factor );
+  solveNxN_LU( factor, b, x );
+}
+
+/**
+ * @brief Solve a linear system with LU, starting from a guessed pivot order.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param A The matrix.
+ * @param b The right hand side.
+ * @param x The solution.
+ * @param pivotHint On entry, the guessed row permutation (the identity is a
+ *        valid first guess). On exit, the permutation that was used, to be
+ *        passed to the next solve of a similar system.
+ * @param pivotThreshold The threshold of the hinted pivot test, see factorNxN_LU.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+void solveNxN_pivoted( REAL_TYPE const (&A)[N][N],
+                       REAL_TYPE const (&b)[N],
+                       REAL_TYPE (& x)[N],
+                       int (& pivotHint)[N],
+                       REAL_TYPE const pivotThreshold = 0.1 )
+{
+  LUFactorization< REAL_TYPE, N > factor;
+  factorNxN_LU( A, factor, pivotHint, pivotThreshold );
+  solveNxN_LU( factor, b, x );
+  for( int i = 0; i < N; i++ )
+  {
+    pivotHint[i] = factor.pivot[i];
+  }
+}
+
+/**
+ * @brief Counters filled by the linear solver policies.
+ */
+struct LinearSolverStats
+{
+  /// Number of iterative refinement steps performed.
+  int numRefinements = 0;
+  /// Number of times a solver fell back to a full precision pivoted LU.
+  int numFallbacks = 0;
+  /// Number of solves in which a pivot hint was not followed entirely.
+  int numPivotHintRejections = 0;
+};
+
+/**
+ * @brief Linear solver policy using dense LU with partial pivoting.
+ */
+struct PivotedLUSolver
+{
+  /**
+   * @brief Solve A x = b.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  void solve( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    HPCREACT_UNUSED_VAR( stats );
+    solveNxN_pivoted< REAL_TYPE, N >( A, b, x );
+  }
+};
+
+/**
+ * @brief Linear solver policy using a Cholesky factorization. Only for
+ *        symmetric positive definite matrices.
+ */
+struct CholeskySolver
+{
+  /**
+   * @brief Solve A x = b.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  void solve( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    HPCREACT_UNUSED_VAR( stats );
+    solveNxN_Cholesky< REAL_TYPE, N >( A, b, x );
+  }
+};
+
+/**
+ * @brief Linear solver policy using a Cholesky factorization of the symmetrically
+ *        scaled matrix, with a pivoted LU fallback.
+ * @details Solves (D A D) y = D b with D = diag( A )^{-1/2}, which brings the
+ *          diagonal to 1 and keeps the matrix symmetric positive definite, and
+ *          returns x = D y. Only the lower triangle of A is read, and the
+ *          scaled matrix is factored in place in the storage of the factor.
+ *          If A has a nonpositive (or NaN) diagonal entry or the Cholesky
+ *          factorization finds a nonpositive pivot, A is not positive definite
+ *          and the system is solved with a pivoted LU of A instead, counted in
+ *          LinearSolverStats::numFallbacks.
+ *
+ *          newtonRaphson assembles the Jacobian of this policy in packed
+ *          symmetric storage (JacobianType), so the residual callback receives
+ *          a symmetricMatrix.
+ */
+struct ScaledCholeskySolver
+{
+  /// The storage newtonRaphson assembles the Jacobian in.
+  template< typename REAL_TYPE, int N >
+  using JacobianType = symmetricMatrix< REAL_TYPE, int, N >;
+
+  /**
+   * @brief Solve A x = b.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  void solve( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    if( !scaledCholeskySolve( A, b, x ) )
+    {
+      ++stats.numFallbacks;
+      solveNxN_pivoted< REAL_TYPE, N >( A, b, x );
+    }
+  }
+
+  /**
+   * @brief Solve A x = b.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param A The matrix in packed symmetric storage.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  void solve( symmetricMatrix< REAL_TYPE, int, N > const & A, REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    if( !scaledCholeskySolve( A, b, x ) )
+    {
+      ++stats.numFallbacks;
+      REAL_TYPE denseA[N][N];
+      for( int i = 0; i < N; ++i )
+      {
+        for( int j = 0; j <= i; ++j )
+        {
+          denseA[i][j] = A( i, j );
+          denseA[j][i] = A( i, j );
+        }
+      }
+      solveNxN_pivoted< REAL_TYPE, N >( denseA, b, x );
+    }
+  }
+
+private:
+  /**
+   * @brief Solve A x = b with the Cholesky factorization of D A D.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @tparam MATRIX_TYPE A dense REAL_TYPE[N][N] or a symmetricMatrix.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution, only written on success.
+   * @return false if A is not positive definite.
+   */
+  template< typename REAL_TYPE, int N, typename MATRIX_TYPE >
+  HPCREACT_HOST_DEVICE
+  static bool scaledCholeskySolve( MATRIX_TYPE const & A, REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N] )
+  {
+    REAL_TYPE diagonalScaling[N];
+    REAL_TYPE scaledB[N];
+    REAL_TYPE y[N];
+    CholeskyFactorization< REAL_TYPE, N > factor;
+
+    bool isDiagonalPositive = true;
+    for( int i = 0; i < N; ++i )
+    {
+      REAL_TYPE const a_ii = internal::entry( A, i, i );
+      isDiagonalPositive = isDiagonalPositive && a_ii > 0;
+      diagonalScaling[i] = a_ii > 0 ? 1.0 / sqrt( a_ii ) : 1.0;
+    }
+    if( !isDiagonalPositive )
+    {
+      return false;
+    }
+
+    for( int i = 0; i < N; ++i )
+    {
+      for( int j = 0; j <= i; ++j )
+      {
+        factor.L( i, j ) = diagonalScaling[i] * internal::entry( A, i, j ) * diagonalScaling[j];
+      }
+      scaledB[i] = diagonalScaling[i] * b[i];
+    }
+
+    if( !factorNxN_Cholesky< REAL_TYPE, N >( factor.L, factor ) )
+    {
+      return false;
+    }
+    solveNxN_Cholesky( factor, scaledB, y );
+    for( int i = 0; i < N; ++i )
+    {
+      x[i] = diagonalScaling[i] * y[i];
+    }
+    return true;
+  }
+};
+
+/**
+ * @brief Linear solver policy using dense LU with a pivot order carried over
+ *        from the previous solve.
+ * @tparam N The size of the system.
+ * @details
+ *   Successive Newton iterations of the same system nearly always select the
+ *   same pivots. The policy does not own the hint: it refers to a permutation
+ *   array owned by the caller, one per cell, which is read as the hint of each
+ *   solve (see factorNxN_LU) and overwritten with the permutation that was
+ *   used. Seeding the array with the pivots of a neighbouring cell, or with the
+ *   identity, is left to the caller. Policies built on distinct arrays can be
+ *   used concurrently.
+ */
+template< int N >
+struct HintedPivotedLUSolver
+{
+  /// The caller owned permutation, the hint on entry of a solve and the pivots used on exit.
+  int (& pivotHint)[N];
+  /// The threshold of the hinted pivot test.
+  double pivotThreshold;
+
+  /**
+   * @brief Constructor.
+   * @param hint The caller owned pivot hint of the cell being solved.
+   * @param threshold The threshold of the hinted pivot test.
+   */
+  HPCREACT_HOST_DEVICE
+  explicit HintedPivotedLUSolver( int (& hint)[N], double const threshold = 0.1 ):
+    pivotHint( hint ),
+    pivotThreshold( threshold )
+  {}
+
+  /**
+   * @brief Solve A x = b and update the caller's pivot hint.
+   * @tparam REAL_TYPE The floating point type.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE >
+  HPCREACT_HOST_DEVICE
+  void solve( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    LUFactorization< REAL_TYPE, N > factor;
+    factorNxN_LU( A, factor, pivotHint, static_cast< REAL_TYPE >( pivotThreshold ) );
+    solveNxN_LU( factor, b, x );
+
+    bool isHintFollowed = true;
+    for( int i = 0; i < N; ++i )
     {
-      x[i] -= A[pivot[i]][j] * x[j];
+      isHintFollowed = isHintFollowed && factor.pivot[i] == pivotHint[i];
+      pivotHint[i] = factor.pivot[i];
     }
-    x[i] /= A[pivot[i]][i]; // Normalize
+    stats.numPivotHintRejections += isHintFollowed ? 0 : 1;
   }
+};
+
+/**
+ * @brief Linear solver policy that factors in low precision and refines in
+ *        the working precision.
+ * @tparam LOW_PRECISION_TYPE The type used for the factorization.
+ * @details
+ *   The LU factorization and the correction solves are done in
+ *   LOW_PRECISION_TYPE, while the residual b - A x is evaluated in the working
+ *   precision. If the matrix does not fit in LOW_PRECISION_TYPE, or the
+ *   correction does not decrease by at least a factor of 2 per step, the
+ *   system is solved again with a full precision pivoted LU.
+ */
+template< typename LOW_PRECISION_TYPE = float >
+struct MixedPrecisionLUSolver
+{
+  /// The maximum number of refinement steps.
+  int maxRefinements = 10;
+  /// Refinement stops when |correction| <= tolerance * |x|.
+  double tolerance = 1.0e-14;
+
+  /**
+   * @brief Solve A x = b.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  void solve( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    LOW_PRECISION_TYPE lowA[N][N];
+    LOW_PRECISION_TYPE lowR[N];
+    LOW_PRECISION_TYPE lowX[N];
+    LUFactorization< LOW_PRECISION_TYPE, N > factor;
+
+    // entries outside the low precision range can not be refined
+    bool isRepresentable = true;
+    for( int i = 0; i < N; ++i )
+    {
+      for( int j = 0; j < N; ++j )
+      {
+        lowA[i][j] = static_cast< LOW_PRECISION_TYPE >( A[i][j] );
+        isRepresentable = isRepresentable && isfinite( lowA[i][j] );
+      }
+      lowR[i] = static_cast< LOW_PRECISION_TYPE >( b[i] );
+      isRepresentable = isRepresentable && isfinite( lowR[i] );
+    }
+
+    if( isRepresentable && factorNxN_LU( lowA, factor ) )
+    {
+      solveNxN_LU( factor, lowR, lowX );
+      for( int i = 0; i < N; ++i )
+      {
+        x[i] = lowX[i];
+      }
+
+      REAL_TYPE previousCorrection = 0.0;
+      for( int k = 0; k < maxRefinements; ++k )
+      {
+        // residual in the working precision
+        for( int i = 0; i < N; ++i )
+        {
+          REAL_TYPE r = b[i];
+          for( int j = 0; j < N; ++j )
+          {
+            r -= A[i][j] * x[j];
+          }
+          lowR[i] = static_cast< LOW_PRECISION_TYPE >( r );
+        }
+        solveNxN_LU( factor, lowR, lowX );
+        ++stats.numRefinements;
+
+        REAL_TYPE correction = 0.0;
+        REAL_TYPE solution = 0.0;
+        for( int i = 0; i < N; ++i )
+        {
+          x[i] += lowX[i];
+          correction += static_cast< REAL_TYPE >( lowX[i] ) * lowX[i];
+          solution += x[i] * x[i];
+        }
+        correction = sqrt( correction );
+        solution = sqrt( solution );
+
+        if( correction <= tolerance * solution )
+        {
+          return;
+        }
+        // written so that a NaN correction also counts as a stall
+        if( k > 0 && !( correction < 0.5 * previousCorrection ) )
+        {
+          break;
+        }
+        previousCorrection = correction;
+      }
+    }
 
+    ++stats.numFallbacks;
+    solveNxN_pivoted< REAL_TYPE, N >( A, b, x );
+  }
+};
+
+/**
+ * @brief Compute row and column scaling factors that equilibrate a matrix.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param A The matrix.
+ * @param rowScale The row scaling factors R.
+ * @param colScale The column scaling factors C.
+ * @details The scaling factors are powers of 2, so applying them is exact.
+ *          After scaling, the largest entry of every row and column of R A C
+ *          lies in [0.5,1). Zero rows/columns get a unit scaling.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+void equilibrateNxN( REAL_TYPE const (&A)[N][N], REAL_TYPE (& rowScale)[N], REAL_TYPE (& colScale)[N] )
+{
+  for( int i = 0; i < N; ++i )
+  {
+    REAL_TYPE maxVal = 0.0;
+    for( int j = 0; j < N; ++j )
+    {
+      maxVal = fabs( A[i][j] ) > maxVal ? fabs( A[i][j] ) : maxVal;
+    }
+    int exponent = 0;
+    frexp( maxVal, &exponent );
+    rowScale[i] = maxVal > 0 ? ldexp( REAL_TYPE( 1.0 ), -exponent ) : REAL_TYPE( 1.0 );
+  }
+
+  for( int j = 0; j < N; ++j )
+  {
+    REAL_TYPE maxVal = 0.0;
+    for( int i = 0; i < N; ++i )
+    {
+      REAL_TYPE const value = fabs( rowScale[i] * A[i][j] );
+      maxVal = value > maxVal ? value : maxVal;
+    }
+    int exponent = 0;
+    frexp( maxVal, &exponent );
+    colScale[j] = maxVal > 0 ? ldexp( REAL_TYPE( 1.0 ), -exponent ) : REAL_TYPE( 1.0 );
+  }
 }
 
+/**
+ * @brief Linear solver policy that equilibrates the system before handing it
+ *        to another policy.
+ * @tparam LINEAR_SOLVER The policy used to solve the equilibrated system.
+ * @details Solves (R A C) y = R b and returns x = C y, with R and C from
+ *          equilibrateNxN. Partial pivoting compares entries of different
+ *          rows, so rows whose scales differ by many orders of magnitude (e.g.
+ *          totals expressed in different units) mislead the pivot choice and
+ *          the Newton updates lose accuracy. On well scaled systems the
+ *          equilibration only adds cost.
+ */
+template< typename LINEAR_SOLVER = PivotedLUSolver >
+struct EquilibratedSolver
+{
+  /// The solver for the equilibrated system.
+  LINEAR_SOLVER linearSolver{};
+
+  /**
+   * @brief Solve A x = b.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  void solve( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    REAL_TYPE rowScale[N];
+    REAL_TYPE colScale[N];
+    REAL_TYPE scaledA[N][N];
+    REAL_TYPE scaledB[N];
+    REAL_TYPE y[N];
+
+    equilibrateNxN( A, rowScale, colScale );
+    for( int i = 0; i < N; ++i )
+    {
+      for( int j = 0; j < N; ++j )
+      {
+        scaledA[i][j] = rowScale[i] * A[i][j] * colScale[j];
+      }
+      scaledB[i] = rowScale[i] * b[i];
+    }
+
+    linearSolver.solve( scaledA, scaledB, y, stats );
+
+    for( int j = 0; j < N; ++j )
+    {
+      x[j] = colScale[j] * y[j];
+    }
+  }
+};
+
 } // namespace hpcReact
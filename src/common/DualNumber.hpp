@@ -0,0 +1,390 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "macros.hpp"
+
+#include <math.h>
+
+/** @file DualNumber.hpp
+ *  @brief Forward-mode automatic differentiation with dual numbers.
+ *  @author HPC-REACT Team
+ *  @date 2025
+ */
+
+namespace hpcReact
+{
+
+/**
+ * @brief Dual numbers and their math functions.
+ * @details
+ *   The functions are declared in their own namespace and found through
+ *   argument dependent lookup, so that they do not hide the ::exp, ::log and
+ *   ::pow used on plain floating point values in the rest of hpcReact.
+ */
+namespace dualNumbers
+{
+
+/**
+ * @brief A value and its derivatives with respect to N independent variables.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The number of independent variables.
+ * @details
+ *   DualNumber can be used as the REAL_TYPE of the kernels, e.g. of
+ *   KineticReactions and massActions. Seeding the inputs with
+ *   makeIndependentVariables() and evaluating the residual-only path gives the
+ *   values and the full Jacobian in one pass, without hand-derived derivatives.
+ *   The derivative lanes are a fixed size array, so every operation is a short
+ *   loop over N.
+ *
+ *   DualNumber is a test and verification aid: it checks the hand-coded
+ *   derivatives and prototypes the Jacobian of new kernels. It is several
+ *   times slower than the hand-coded derivatives (see benchmarkDualNumber), as
+ *   every operation carries all N lanes, also where the hand-coded version
+ *   only touches the structural nonzeros. No production path uses it.
+ *
+ *   Comparisons only use the value, so the branches of a kernel are the ones of
+ *   the plain floating point evaluation.
+ */
+template< typename REAL_TYPE, int N >
+struct DualNumber
+{
+  /// The floating point type of the value and derivatives.
+  using RealType = REAL_TYPE;
+
+  /// The number of independent variables.
+  static constexpr int numDerivatives = N;
+
+  /// The value.
+  REAL_TYPE value;
+  /// The derivatives of the value with respect to the independent variables.
+  REAL_TYPE derivatives[N];
+
+  /// Construct a zero constant.
+  HPCREACT_HOST_DEVICE constexpr DualNumber():
+    value( 0.0 ),
+    derivatives{}
+  {}
+
+  /**
+   * @brief Construct a constant, i.e. a value with zero derivatives.
+   * @param constant The value.
+   * @details Implicit, so that floating point constants and parameters can be
+   *          used wherever a REAL_TYPE is expected.
+   */
+  HPCREACT_HOST_DEVICE constexpr DualNumber( REAL_TYPE const constant ):
+    value( constant ),
+    derivatives{}
+  {}
+
+  /**
+   * @brief Add another dual number.
+   * @param rhs The dual number to add.
+   * @return This dual number.
+   */
+  HPCREACT_HOST_DEVICE DualNumber & operator+=( DualNumber const & rhs )
+  {
+    value += rhs.value;
+    for( int k = 0; k < N; ++k )
+    {
+      derivatives[k] += rhs.derivatives[k];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Subtract another dual number.
+   * @param rhs The dual number to subtract.
+   * @return This dual number.
+   */
+  HPCREACT_HOST_DEVICE DualNumber & operator-=( DualNumber const & rhs )
+  {
+    value -= rhs.value;
+    for( int k = 0; k < N; ++k )
+    {
+      derivatives[k] -= rhs.derivatives[k];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Multiply by another dual number.
+   * @param rhs The dual number to multiply by.
+   * @return This dual number.
+   */
+  HPCREACT_HOST_DEVICE DualNumber & operator*=( DualNumber const & rhs )
+  {
+    for( int k = 0; k < N; ++k )
+    {
+      derivatives[k] = derivatives[k] * rhs.value + value * rhs.derivatives[k];
+    }
+    value *= rhs.value;
+    return *this;
+  }
+
+  /**
+   * @brief Divide by another dual number.
+   * @param rhs The dual number to divide by.
+   * @return This dual number.
+   */
+  HPCREACT_HOST_DEVICE DualNumber & operator/=( DualNumber const & rhs )
+  {
+    REAL_TYPE const inverse = 1.0 / rhs.value;
+    value *= inverse;
+    for( int k = 0; k < N; ++k )
+    {
+      derivatives[k] = ( derivatives[k] - value * rhs.derivatives[k] ) * inverse;
+    }
+    return *this;
+  }
+};
+
+/**
+ * @brief Seed the independent variables of a dual number evaluation.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The number of independent variables.
+ * @param x The values of the independent variables.
+ * @param xDual The dual numbers with value x[i] and unit derivative in lane i.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline void
+makeIndependentVariables( REAL_TYPE const (&x)[N], DualNumber< REAL_TYPE, N > (& xDual)[N] )
+{
+  for( int i = 0; i < N; ++i )
+  {
+    xDual[i] = DualNumber< REAL_TYPE, N >( x[i] );
+    xDual[i].derivatives[i] = 1.0;
+  }
+}
+
+/**
+ * @brief Apply the chain rule of a scalar function.
+ * @param a The argument.
+ * @param value f(a.value).
+ * @param derivative f'(a.value).
+ * @return The dual number f(a).
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+chainRule( DualNumber< REAL_TYPE, N > const & a,
+           typename DualNumber< REAL_TYPE, N >::RealType const value,
+           typename DualNumber< REAL_TYPE, N >::RealType const derivative )
+{
+  DualNumber< REAL_TYPE, N > result( value );
+  for( int k = 0; k < N; ++k )
+  {
+    result.derivatives[k] = derivative * a.derivatives[k];
+  }
+  return result;
+}
+
+/// @cond DO_NOT_DOCUMENT
+// the plain floating point operands are not deduced, so that integer and literal operands convert
+template< typename REAL_TYPE, int N >
+using ScalarType = typename DualNumber< REAL_TYPE, N >::RealType;
+
+// arithmetic. The overloads with a REAL_TYPE operand avoid the zero derivative lanes of a constant.
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator-( DualNumber< REAL_TYPE, N > const & a )
+{
+  return chainRule( a, -a.value, REAL_TYPE( -1.0 ) );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator+( DualNumber< REAL_TYPE, N > a, DualNumber< REAL_TYPE, N > const & b )
+{
+  return a += b;
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator+( DualNumber< REAL_TYPE, N > a, ScalarType< REAL_TYPE, N > const b )
+{
+  a.value += b;
+  return a;
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator+( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > b )
+{
+  b.value += a;
+  return b;
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator-( DualNumber< REAL_TYPE, N > a, DualNumber< REAL_TYPE, N > const & b )
+{
+  return a -= b;
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator-( DualNumber< REAL_TYPE, N > a, ScalarType< REAL_TYPE, N > const b )
+{
+  a.value -= b;
+  return a;
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator-( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > const & b )
+{
+  return chainRule( b, a - b.value, REAL_TYPE( -1.0 ) );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator*( DualNumber< REAL_TYPE, N > a, DualNumber< REAL_TYPE, N > const & b )
+{
+  return a *= b;
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator*( DualNumber< REAL_TYPE, N > const & a, ScalarType< REAL_TYPE, N > const b )
+{
+  return chainRule( a, a.value * b, b );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator*( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > const & b )
+{
+  return chainRule( b, a * b.value, a );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator/( DualNumber< REAL_TYPE, N > a, DualNumber< REAL_TYPE, N > const & b )
+{
+  return a /= b;
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator/( DualNumber< REAL_TYPE, N > const & a, ScalarType< REAL_TYPE, N > const b )
+{
+  REAL_TYPE const inverse = 1.0 / b;
+  return chainRule( a, a.value * inverse, inverse );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+operator/( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > const & b )
+{
+  REAL_TYPE const value = a / b.value;
+  return chainRule( b, value, -value / b.value );
+}
+
+// comparisons of the values
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator<( DualNumber< REAL_TYPE, N > const & a, DualNumber< REAL_TYPE, N > const & b ) { return a.value < b.value; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator<( DualNumber< REAL_TYPE, N > const & a, ScalarType< REAL_TYPE, N > const b ) { return a.value < b; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator<( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > const & b ) { return a < b.value; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator>( DualNumber< REAL_TYPE, N > const & a, DualNumber< REAL_TYPE, N > const & b ) { return a.value > b.value; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator>( DualNumber< REAL_TYPE, N > const & a, ScalarType< REAL_TYPE, N > const b ) { return a.value > b; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator>( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > const & b ) { return a > b.value; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator<=( DualNumber< REAL_TYPE, N > const & a, DualNumber< REAL_TYPE, N > const & b ) { return a.value <= b.value; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator<=( DualNumber< REAL_TYPE, N > const & a, ScalarType< REAL_TYPE, N > const b ) { return a.value <= b; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator<=( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > const & b ) { return a <= b.value; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator>=( DualNumber< REAL_TYPE, N > const & a, DualNumber< REAL_TYPE, N > const & b ) { return a.value >= b.value; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator>=( DualNumber< REAL_TYPE, N > const & a, ScalarType< REAL_TYPE, N > const b ) { return a.value >= b; }
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline bool operator>=( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > const & b ) { return a >= b.value; }
+
+// math functions
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+exp( DualNumber< REAL_TYPE, N > const & a )
+{
+  REAL_TYPE const value = ::exp( a.value );
+  return chainRule( a, value, value );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+log( DualNumber< REAL_TYPE, N > const & a )
+{
+  return chainRule( a, ::log( a.value ), 1.0 / a.value );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+sqrt( DualNumber< REAL_TYPE, N > const & a )
+{
+  REAL_TYPE const value = ::sqrt( a.value );
+  return chainRule( a, value, 0.5 / value );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+fabs( DualNumber< REAL_TYPE, N > const & a )
+{
+  return a.value < 0.0 ? -a : a;
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+pow( DualNumber< REAL_TYPE, N > const & a, ScalarType< REAL_TYPE, N > const b )
+{
+  REAL_TYPE const value = ::pow( a.value, b );
+  return chainRule( a, value, b * ::pow( a.value, b - 1.0 ) );
+}
+
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+pow( ScalarType< REAL_TYPE, N > const a, DualNumber< REAL_TYPE, N > const & b )
+{
+  REAL_TYPE const value = ::pow( a, b.value );
+  return chainRule( b, value, a > 0.0 ? value * ::log( a ) : 0.0 );
+}
+
+// an exponent with zero derivatives, e.g. a stoichiometric coefficient stored as a dual
+// number, gives the derivative of the power rule even when the base is zero
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE inline DualNumber< REAL_TYPE, N >
+pow( DualNumber< REAL_TYPE, N > const & a, DualNumber< REAL_TYPE, N > const & b )
+{
+  REAL_TYPE const value = ::pow( a.value, b.value );
+  REAL_TYPE const dValue_da = b.value * ::pow( a.value, b.value - 1.0 );
+  REAL_TYPE const dValue_db = a.value > 0.0 ? value * ::log( a.value ) : 0.0;
+  DualNumber< REAL_TYPE, N > result( value );
+  for( int k = 0; k < N; ++k )
+  {
+    result.derivatives[k] = dValue_da * a.derivatives[k] + dValue_db * b.derivatives[k];
+  }
+  return result;
+}
+/// @endcond
+
+} // namespace dualNumbers
+
+using dualNumbers::DualNumber;
+
+} // namespace hpcReact
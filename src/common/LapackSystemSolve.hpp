@@ -0,0 +1,172 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "macros.hpp"
+#include "DirectSystemSolve.hpp"
+
+#include <type_traits>
+#include <vector>
+
+/** @file LapackSystemSolve.hpp
+ *  @brief Host only LU solves routed to LAPACK dgetrf/dgetrs.
+ *  @author HPC-REACT Team
+ *  @date 2025
+ */
+
+extern "C"
+{
+/// LAPACK LU factorization with partial pivoting (column-major storage).
+void dgetrf_( int const * m, int const * n, double * A, int const * lda, int * ipiv, int * info );
+
+/// LAPACK solve using the factors computed by dgetrf_.
+void dgetrs_( char const * trans, int const * n, int const * nrhs, double const * A, int const * lda,
+              int const * ipiv, double * B, int const * ldb, int * info );
+}
+
+namespace hpcReact
+{
+
+/**
+ * @brief LU factorization of a runtime sized matrix computed by LAPACK.
+ * @details
+ *   The matrices used in hpcReact are stored row-major, which LAPACK sees as
+ *   the transpose. The factorization is therefore the one of A^T, and the
+ *   solves use the transposed LAPACK solve so that they solve A x = b.
+ */
+struct LapackLUFactorization
+{
+  /// The size of the system.
+  int n = 0;
+  /// The LU factors of A^T in column-major storage.
+  std::vector< double > LU;
+  /// The LAPACK (1-based) pivot indices.
+  std::vector< int > pivot;
+};
+
+/**
+ * @brief Compute the LU factorization of a runtime sized matrix with LAPACK.
+ * @param n The size of the system.
+ * @param A The row-major n x n matrix.
+ * @param factor The resulting factorization.
+ * @return false if LAPACK reports a zero pivot, i.e. A is singular.
+ */
+inline bool factorNxN_lapackLU( int const n, double const * const A, LapackLUFactorization & factor )
+{
+  factor.n = n;
+  factor.LU.assign( A, A + n * n );
+  factor.pivot.resize( n );
+
+  int info = 0;
+  dgetrf_( &n, &n, factor.LU.data(), &n, factor.pivot.data(), &info );
+  return info == 0;
+}
+
+/**
+ * @brief Solve A x = b using a LAPACK LU factorization of A.
+ * @param factor The factorization computed by factorNxN_lapackLU.
+ * @param b The right hand side.
+ * @param x The solution. May alias @p b.
+ */
+inline void solveNxN_lapackLU( LapackLUFactorization const & factor, double const * const b, double * const x )
+{
+  int const n = factor.n;
+  int const nrhs = 1;
+  char const trans = 'T';
+  int info = 0;
+
+  if( x != b )
+  {
+    for( int i = 0; i < n; ++i )
+    {
+      x[i] = b[i];
+    }
+  }
+  dgetrs_( &trans, &n, &nrhs, factor.LU.data(), &n, factor.pivot.data(), x, &n, &info );
+}
+
+/**
+ * @brief Solve a set of independent runtime sized systems, one per cell, with LAPACK.
+ * @param n The size of each system.
+ * @param numSystems The number of systems.
+ * @param A The row-major matrices, stored contiguously (n*n values per system).
+ *          Overwritten by the factors.
+ * @param b The right hand sides, stored contiguously (n values per system).
+ *          Overwritten by the solutions.
+ * @return false if any of the systems is singular.
+ */
+inline bool solveNxN_lapackLU_batched( int const n, int const numSystems, double * const A, double * const b )
+{
+  int const nrhs = 1;
+  char const trans = 'T';
+  std::vector< int > pivot( n );
+  bool isNonsingular = true;
+
+  for( int s = 0; s < numSystems; ++s )
+  {
+    double * const As = A + static_cast< long >( s ) * n * n;
+    double * const bs = b + static_cast< long >( s ) * n;
+    int info = 0;
+    dgetrf_( &n, &n, As, &n, pivot.data(), &info );
+    isNonsingular = isNonsingular && info == 0;
+    dgetrs_( &trans, &n, &nrhs, As, &n, pivot.data(), bs, &n, &info );
+  }
+  return isNonsingular;
+}
+
+/**
+ * @brief Host only linear solver policy using LAPACK dgetrf/dgetrs.
+ * @details
+ *   Intended for large systems (tens of species or more) solved on the host,
+ *   where the blocked LAPACK factorization outperforms the unrolled template
+ *   solvers. It satisfies the same policy interface as PivotedLUSolver, so it
+ *   can be passed as the LINEAR_SOLVER of the nonlinear solvers. Only double
+ *   precision is supported.
+ */
+struct LapackLUSolver
+{
+  /**
+   * @brief Solve A x = b.
+   * @tparam REAL_TYPE The floating point type. Must be double.
+   * @tparam N The size of the system.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE, int N >
+  void solve( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    static_assert( std::is_same< REAL_TYPE, double >::value, "LapackLUSolver only supports double precision" );
+    HPCREACT_UNUSED_VAR( stats );
+
+    double LU[N][N];
+    int pivot[N];
+    for( int i = 0; i < N; ++i )
+    {
+      x[i] = b[i];
+      for( int j = 0; j < N; ++j )
+      {
+        LU[i][j] = A[i][j];
+      }
+    }
+
+    int const n = N;
+    int const nrhs = 1;
+    char const trans = 'T';
+    int info = 0;
+    dgetrf_( &n, &n, &LU[0][0], &n, pivot, &info );
+    dgetrs_( &trans, &n, &nrhs, &LU[0][0], &n, pivot, x, &n, &info );
+  }
+};
+
+} // namespace hpcReact
@@ -0,0 +1,344 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "macros.hpp"
+#include "CArrayWrapper.hpp"
+#include "DirectSystemSolve.hpp"
+
+#include <math.h>
+
+/** @file SparseDirectSystemSolve.hpp
+ *  @brief LU solve of small systems with a sparsity pattern known at compile time.
+ *  @author HPC-REACT Team
+ *  @date 2025
+ */
+
+namespace hpcReact
+{
+
+/**
+ * @brief Symbolic analysis of an NxN matrix with a fixed sparsity pattern.
+ * @tparam N The size of the system.
+ * @details
+ *   The constructor computes a minimum degree ordering on the structure of
+ *   A + A^T and the fill pattern of the LU factors in that ordering. The
+ *   result is stored as lists of the structural nonzeros of each column of L
+ *   and each row of U, so that the numeric factorization and solves only
+ *   touch entries that can be nonzero. The constructor is constexpr, so a
+ *   constexpr symbolic object is computed entirely at compile time.
+ */
+template< int N >
+struct SparseLUSymbolic
+{
+  /// Default constructor
+  constexpr SparseLUSymbolic() = default;
+
+  /**
+   * @brief Construct the symbolic factorization from a sparsity pattern.
+   * @param pattern pattern(i,j) is true if A(i,j) may be nonzero.
+   */
+  HPCREACT_HOST_DEVICE
+  constexpr SparseLUSymbolic( CArrayWrapper< bool, N, N > const & pattern )
+  {
+    // structure of A + A^T, in the original ordering
+    CArrayWrapper< bool, N, N > graph;
+    for( int i = 0; i < N; ++i )
+    {
+      for( int j = 0; j < N; ++j )
+      {
+        graph( i, j ) = i == j || pattern( i, j ) || pattern( j, i );
+      }
+    }
+
+    // **Minimum degree ordering**. Eliminating a node connects all of its
+    // remaining neighbors, which is exactly the fill of the LU factors.
+    CArrayWrapper< bool, N > isEliminated;
+    for( int step = 0; step < N; ++step )
+    {
+      int minNode = -1;
+      int minDegree = N + 1;
+      for( int i = 0; i < N; ++i )
+      {
+        if( isEliminated( i ) )
+        {
+          continue;
+        }
+        int degree = 0;
+        for( int j = 0; j < N; ++j )
+        {
+          degree += ( j != i && !isEliminated( j ) && graph( i, j ) ) ? 1 : 0;
+        }
+        if( degree < minDegree )
+        {
+          minDegree = degree;
+          minNode = i;
+        }
+      }
+
+      m_order( step ) = minNode;
+      isEliminated( minNode ) = true;
+      for( int i = 0; i < N; ++i )
+      {
+        for( int j = 0; j < N; ++j )
+        {
+          if( !isEliminated( i ) && !isEliminated( j ) && graph( minNode, i ) && graph( minNode, j ) )
+          {
+            graph( i, j ) = true;
+          }
+        }
+      }
+    }
+
+    // **Filled pattern in the new ordering**
+    int numLower = 0;
+    int numUpper = 0;
+    for( int k = 0; k < N; ++k )
+    {
+      m_lowerOffsets( k ) = numLower;
+      m_upperOffsets( k ) = numUpper;
+      for( int i = k + 1; i < N; ++i )
+      {
+        if( graph( m_order( i ), m_order( k ) ) )
+        {
+          m_lowerRows( numLower++ ) = i;
+        }
+        if( graph( m_order( k ), m_order( i ) ) )
+        {
+          m_upperColumns( numUpper++ ) = i;
+        }
+      }
+    }
+    m_lowerOffsets( N ) = numLower;
+    m_upperOffsets( N ) = numUpper;
+  }
+
+  /**
+   * @brief The number of structural nonzeros of L + U, including the diagonal.
+   * @return the number of nonzeros in the factors.
+   */
+  HPCREACT_HOST_DEVICE constexpr int numFactorNonzeros() const { return N + m_lowerOffsets( N ) + m_upperOffsets( N ); }
+
+  /// The elimination order. Row/column i of the permuted matrix is row/column m_order(i) of A.
+  CArrayWrapper< int, N > m_order;
+
+  /// Offsets into m_lowerRows. Column k of L occupies [m_lowerOffsets(k), m_lowerOffsets(k+1)).
+  CArrayWrapper< int, N + 1 > m_lowerOffsets;
+
+  /// Rows (in the permuted ordering) of the strictly lower structural nonzeros of each column.
+  CArrayWrapper< int, N * N > m_lowerRows;
+
+  /// Offsets into m_upperColumns. Row k of U occupies [m_upperOffsets(k), m_upperOffsets(k+1)).
+  CArrayWrapper< int, N + 1 > m_upperOffsets;
+
+  /// Columns (in the permuted ordering) of the strictly upper structural nonzeros of each row.
+  CArrayWrapper< int, N * N > m_upperColumns;
+};
+
+/**
+ * @brief LU factors computed with a SparseLUSymbolic analysis.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @details The factors are stored densely in the permuted ordering, but only
+ *          structural nonzeros are ever read or written.
+ */
+template< typename REAL_TYPE, int N >
+struct SparseLUFactorization
+{
+  /// Packed L (unit diagonal implied) and U factors of the permuted matrix.
+  REAL_TYPE LU[N][N];
+};
+
+/**
+ * @brief Numeric LU factorization following a symbolic analysis.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param symbolic The symbolic analysis of the sparsity pattern of A.
+ * @param A The matrix to factor. Only the entries in the filled pattern of the
+ *        factors are read, so A must be zero outside the pattern given to the
+ *        symbolic analysis.
+ * @param factor The resulting factorization.
+ * @param pivotThreshold A pivot smaller than this fraction of the largest
+ *        entry of the current (partially eliminated) column below it is
+ *        rejected, which bounds the multipliers by 1 / pivotThreshold.
+ * @return false if a pivot was rejected, in which case the factors must not be
+ *         used and a pivoted factorization should be used instead.
+ * @details The pivot sequence is fixed by the symbolic ordering (no pivoting),
+ *          so the elimination only visits structural nonzeros. The threshold
+ *          test is the one of threshold partial pivoting: instead of swapping
+ *          rows when it fails, the factorization reports it so the caller can
+ *          fall back to solveNxN_pivoted.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+bool factorNxN_sparseLU( SparseLUSymbolic< N > const & symbolic,
+                         REAL_TYPE const (&A)[N][N],
+                         SparseLUFactorization< REAL_TYPE, N > & factor,
+                         REAL_TYPE const pivotThreshold = 0.01 )
+{
+  REAL_TYPE (& LU)[N][N] = factor.LU;
+
+  for( int k = 0; k < N; ++k )
+  {
+    int const row = symbolic.m_order( k );
+    LU[k][k] = A[row][row];
+    for( int ii = symbolic.m_lowerOffsets( k ); ii < symbolic.m_lowerOffsets( k + 1 ); ++ii )
+    {
+      int const i = symbolic.m_lowerRows( ii );
+      LU[i][k] = A[symbolic.m_order( i )][row];
+    }
+    for( int jj = symbolic.m_upperOffsets( k ); jj < symbolic.m_upperOffsets( k + 1 ); ++jj )
+    {
+      int const j = symbolic.m_upperColumns( jj );
+      LU[k][j] = A[row][symbolic.m_order( j )];
+    }
+  }
+
+  for( int k = 0; k < N; ++k )
+  {
+    REAL_TYPE const pivot = LU[k][k];
+
+    REAL_TYPE columnMax = 0.0;
+    for( int ii = symbolic.m_lowerOffsets( k ); ii < symbolic.m_lowerOffsets( k + 1 ); ++ii )
+    {
+      REAL_TYPE const entry = fabs( LU[symbolic.m_lowerRows( ii )][k] );
+      columnMax = entry > columnMax ? entry : columnMax;
+    }
+    if( !( fabs( pivot ) > 0.0 && fabs( pivot ) >= pivotThreshold * columnMax ) )
+    {
+      return false;
+    }
+
+    for( int ii = symbolic.m_lowerOffsets( k ); ii < symbolic.m_lowerOffsets( k + 1 ); ++ii )
+    {
+      int const i = symbolic.m_lowerRows( ii );
+      REAL_TYPE const factor_ik = LU[i][k] / pivot;
+      LU[i][k] = factor_ik;
+      for( int jj = symbolic.m_upperOffsets( k ); jj < symbolic.m_upperOffsets( k + 1 ); ++jj )
+      {
+        int const j = symbolic.m_upperColumns( jj );
+        LU[i][j] -= factor_ik * LU[k][j];
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Solve A x = b with factors computed by factorNxN_sparseLU.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param symbolic The symbolic analysis used for the factorization.
+ * @param factor The factorization.
+ * @param b The right hand side.
+ * @param x The solution.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+void solveNxN_sparseLU( SparseLUSymbolic< N > const & symbolic,
+                        SparseLUFactorization< REAL_TYPE, N > const & factor,
+                        REAL_TYPE const (&b)[N],
+                        REAL_TYPE (& x)[N] )
+{
+  REAL_TYPE const (&LU)[N][N] = factor.LU;
+  REAL_TYPE y[N];
+
+  for( int i = 0; i < N; ++i )
+  {
+    y[i] = b[symbolic.m_order( i )];
+  }
+
+  // **Forward Substitution: Solve L z = P b**
+  for( int k = 0; k < N; ++k )
+  {
+    for( int ii = symbolic.m_lowerOffsets( k ); ii < symbolic.m_lowerOffsets( k + 1 ); ++ii )
+    {
+      int const i = symbolic.m_lowerRows( ii );
+      y[i] -= LU[i][k] * y[k];
+    }
+  }
+
+  // **Back-Substitution: Solve U P x = z**
+  for( int i = N - 1; i >= 0; --i )
+  {
+    for( int jj = symbolic.m_upperOffsets( i ); jj < symbolic.m_upperOffsets( i + 1 ); ++jj )
+    {
+      int const j = symbolic.m_upperColumns( jj );
+      y[i] -= LU[i][j] * y[j];
+    }
+    y[i] /= LU[i][i];
+  }
+
+  for( int i = 0; i < N; ++i )
+  {
+    x[symbolic.m_order( i )] = y[i];
+  }
+}
+
+/**
+ * @brief Solve a linear system with a known sparsity pattern.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @param symbolic The symbolic analysis of the sparsity pattern of A.
+ * @param A The matrix.
+ * @param b The right hand side.
+ * @param x The solution.
+ * @return false if the fixed pivot sequence was not numerically acceptable,
+ *         in which case the system was solved with solveNxN_pivoted instead.
+ */
+template< typename REAL_TYPE, int N >
+HPCREACT_HOST_DEVICE
+bool solveNxN_sparse( SparseLUSymbolic< N > const & symbolic,
+                      REAL_TYPE const (&A)[N][N],
+                      REAL_TYPE const (&b)[N],
+                      REAL_TYPE (& x)[N] )
+{
+  SparseLUFactorization< REAL_TYPE, N > factor;
+  if( factorNxN_sparseLU( symbolic, A, factor ) )
+  {
+    solveNxN_sparseLU( symbolic, factor, b, x );
+    return true;
+  }
+  solveNxN_pivoted< REAL_TYPE, N >( A, b, x );
+  return false;
+}
+
+/**
+ * @brief Linear solver policy using the sparse LU with a compile time pattern.
+ * @tparam N The size of the system.
+ */
+template< int N >
+struct SparseLUSolver
+{
+  /**
+   * @brief Solve A x = b.
+   * @tparam REAL_TYPE The floating point type.
+   * @param A The matrix.
+   * @param b The right hand side.
+   * @param x The solution.
+   * @param stats The statistics to update.
+   */
+  template< typename REAL_TYPE >
+  HPCREACT_HOST_DEVICE
+  void solve( REAL_TYPE const (&A)[N][N], REAL_TYPE const (&b)[N], REAL_TYPE (& x)[N], LinearSolverStats & stats ) const
+  {
+    if( !solveNxN_sparse( symbolic, A, b, x ) )
+    {
+      ++stats.numFallbacks;
+    }
+  }
+
+  /// The symbolic analysis of the matrix.
+  SparseLUSymbolic< N > symbolic;
+};
+
+} // namespace hpcReact
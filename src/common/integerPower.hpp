@@ -0,0 +1,103 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "macros.hpp"
+
+#include <math.h>
+#include <type_traits>
+
+/** @file integerPower.hpp
+ *  @brief Powers of concentrations with integer stoichiometric exponents.
+ *  @author HPC-REACT Team
+ *  @date 2025
+ */
+
+namespace hpcReact
+{
+
+/**
+ * @brief Raise a value to an integer power using multiplications only.
+ * @tparam REAL_TYPE The floating point type. Any type with multiplication and
+ *   division by a scalar (e.g. DualNumber) may be used.
+ * @param x The base.
+ * @param n The exponent. Negative exponents return the reciprocal of x^|n|.
+ * @return x^n. x^0 is 1 for every x.
+ * @details The exponents that appear in mass-action terms are the small
+ *   coefficients of the stoichiometric matrix, so |n| <= 4 is fully unrolled
+ *   and only larger exponents fall back to exponentiation by squaring.
+ */
+template< typename REAL_TYPE >
+HPCREACT_HOST_DEVICE inline
+REAL_TYPE integerPower( REAL_TYPE const & x, int const n )
+{
+  if( n < 0 )
+  {
+    return 1.0 / integerPower( x, -n );
+  }
+
+  switch( n )
+  {
+    case 0:
+      return REAL_TYPE( 1.0 );
+    case 1:
+      return x;
+    case 2:
+      return x * x;
+    case 3:
+      return x * x * x;
+    case 4:
+    {
+      REAL_TYPE const x2 = x * x;
+      return x2 * x2;
+    }
+    default:
+    {
+      REAL_TYPE result = 1.0;
+      REAL_TYPE base = x;
+      for( int m = n; m > 0; m /= 2 )
+      {
+        if( m % 2 == 1 )
+        {
+          result *= base;
+        }
+        base *= base;
+      }
+      return result;
+    }
+  }
+}
+
+/**
+ * @brief Raise a concentration to a stoichiometric coefficient.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam COEFFICIENT_TYPE The type the stoichiometric coefficients are stored in.
+ * @param x The base.
+ * @param s The exponent.
+ * @return x^s, using integerPower() for integral coefficients and pow() only
+ *   when the coefficients are stored as (possibly fractional) floating point values.
+ */
+template< typename REAL_TYPE, typename COEFFICIENT_TYPE >
+HPCREACT_HOST_DEVICE inline
+REAL_TYPE stoichiometricPower( REAL_TYPE const & x, COEFFICIENT_TYPE const s )
+{
+  if constexpr( std::is_integral< COEFFICIENT_TYPE >::value )
+  {
+    return integerPower( x, static_cast< int >( s ) );
+  }
+  else
+  {
+    return pow( x, s );
+  }
+}
+
+} // namespace hpcReact
@@ -14,6 +14,8 @@
 #include "macros.hpp"
 #include "DirectSystemSolve.hpp"
 #include <math.h>
+#include <stdio.h>
+#include <type_traits>
 
 namespace hpcReact
 {
@@ -71,6 +73,28 @@ void scale( double (& x)[N], double const value )
     x[i] *= value;
 }
 
+/**
+ * The storage newtonRaphson assembles the Jacobian in for a linear solver
+ * policy: dense REAL_TYPE[N][N], unless the policy declares a JacobianType.
+ * @tparam LINEAR_SOLVER The linear solver policy.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ */
+template< typename LINEAR_SOLVER, typename REAL_TYPE, int N, typename = void >
+struct JacobianStorage
+{
+  /// The Jacobian type.
+  using type = REAL_TYPE[N][N];
+};
+
+/// @copydoc JacobianStorage
+template< typename LINEAR_SOLVER, typename REAL_TYPE, int N >
+struct JacobianStorage< LINEAR_SOLVER, REAL_TYPE, N, std::void_t< typename LINEAR_SOLVER::template JacobianType< REAL_TYPE, N > > >
+{
+  /// The Jacobian type.
+  using type = typename LINEAR_SOLVER::template JacobianType< REAL_TYPE, N >;
+};
+
 }
 
 namespace utils
@@ -149,53 +173,1544 @@ void newtonRaphson( REAL_TYPE (& x)[N],
   }
 }
 
+/**
+ * @brief Result of a nonlinear solve.
+ */
+struct SolverStats
+{
+  /// The number of Newton updates applied to the solution.
+  int numIterations = 0;
+  /// The norm of the residual at the initial guess.
+  double initialResidualNorm = 0.0;
+  /// The norm of the last evaluated residual.
+  double finalResidualNorm = 0.0;
+  /// Whether the convergence criterion was met.
+  bool isConverged = false;
+  /// The number of linear solves.
+  int numLinearSolves = 0;
+  /// The number of residual (and Jacobian) evaluations.
+  int numResidualEvaluations = 0;
+  /// The number of step length reductions of the globalization.
+  int numBacktracks = 0;
+  /// The number of iterations saved by a TimeStepPredictor, when measured.
+  int numIterationsSaved = 0;
+  /// The statistics reported by the linear solver policy.
+  LinearSolverStats linearSolverStats;
+};
+
+/**
+ * @brief Convergence criteria and iteration limit of a nonlinear solve.
+ * @tparam N The size of the system.
+ * @details
+ *   The residual norm is the 2-norm of the residual weighted component-wise by
+ *   residualWeights, e.g. the inverse of a typical magnitude of each species.
+ *   The solve has converged when
+ *   - the residual norm is below max( absoluteTolerance, relativeTolerance * initial residual norm ), or
+ *   - updateTolerance > 0 and the largest component of the last update is
+ *     below updateTolerance.
+ */
+template< int N >
+struct SolverControls
+{
+  /// The maximum number of Newton updates.
+  int maxIterations;
+  /// The absolute tolerance on the residual norm.
+  double absoluteTolerance;
+  /// The tolerance on the residual norm relative to the initial residual norm.
+  double relativeTolerance;
+  /// The tolerance on the largest component of the update. Disabled if <= 0.
+  double updateTolerance;
+  /// The weights of the residual components in the residual norm.
+  double residualWeights[N];
+
+  /**
+   * @brief Constructor. All residual weights are set to 1.
+   * @param maxIterations_ The maximum number of Newton updates.
+   * @param absoluteTolerance_ The absolute tolerance on the residual norm.
+   * @param relativeTolerance_ The relative tolerance on the residual norm.
+   * @param updateTolerance_ The tolerance on the update.
+   */
+  HPCREACT_HOST_DEVICE
+  explicit SolverControls( int const maxIterations_ = 12,
+                           double const absoluteTolerance_ = 1.0e-10,
+                           double const relativeTolerance_ = 0.0,
+                           double const updateTolerance_ = 0.0 ):
+    maxIterations( maxIterations_ ),
+    absoluteTolerance( absoluteTolerance_ ),
+    relativeTolerance( relativeTolerance_ ),
+    updateTolerance( updateTolerance_ ),
+    residualWeights{}
+  {
+    for( int i = 0; i < N; ++i )
+    {
+      residualWeights[i] = 1.0;
+    }
+  }
+
+  /**
+   * @brief The weighted norm of a residual.
+   * @tparam REAL_TYPE The floating point type.
+   * @param r The residual.
+   * @return sqrt( sum_i ( w_i r_i )^2 )
+   */
+  template< typename REAL_TYPE >
+  HPCREACT_HOST_DEVICE
+  double residualNorm( REAL_TYPE const (&r)[N] ) const
+  {
+    double sum = 0.0;
+    for( int i = 0; i < N; ++i )
+    {
+      double const weightedResidual = residualWeights[i] * r[i];
+      sum += weightedResidual * weightedResidual;
+    }
+    return ::sqrt( sum );
+  }
+
+  /**
+   * @brief The tolerance on the residual norm.
+   * @param initialResidualNorm The residual norm at the initial guess.
+   * @return The residual norm below which the solve has converged.
+   */
+  HPCREACT_HOST_DEVICE
+  double residualTolerance( double const initialResidualNorm ) const
+  {
+    double const relative = relativeTolerance * initialResidualNorm;
+    return relative > absoluteTolerance ? relative : absoluteTolerance;
+  }
+
+  /**
+   * @brief The update criterion.
+   * @tparam REAL_TYPE The floating point type.
+   * @param dx The Newton update.
+   * @param stepLength The step length the update was applied with.
+   * @return true if the update criterion is enabled and satisfied.
+   */
+  template< typename REAL_TYPE >
+  HPCREACT_HOST_DEVICE
+  bool isUpdateConverged( REAL_TYPE const (&dx)[N], double const stepLength ) const
+  {
+    if( updateTolerance <= 0.0 )
+    {
+      return false;
+    }
+    double maxUpdate = 0.0;
+    for( int i = 0; i < N; ++i )
+    {
+      double const update = fabs( stepLength * dx[i] );
+      maxUpdate = update > maxUpdate ? update : maxUpdate;
+    }
+    return maxUpdate <= updateTolerance;
+  }
+};
+
+/**
+ * @brief Logging policy of the nonlinear solvers that does not log anything.
+ * @details This is the default policy. All of its functions are empty, so no
+ *          I/O is compiled into the solvers.
+ */
+struct NoLogging
+{
+  /**
+   * @brief Called after each residual evaluation.
+   * @param iter The iteration index.
+   * @param residualNorm The residual norm.
+   */
+  HPCREACT_HOST_DEVICE
+  static void iteration( int const iter, double const residualNorm )
+  {
+    HPCREACT_UNUSED_VAR( iter );
+    HPCREACT_UNUSED_VAR( residualNorm );
+  }
+
+  /**
+   * @brief Called before each linear solve.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param J The Jacobian matrix.
+   * @param r The right hand side.
+   * @param dx The update vector.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  static void linearSystem( REAL_TYPE const (&J)[N][N], REAL_TYPE const (&r)[N], REAL_TYPE const (&dx)[N] )
+  {
+    HPCREACT_UNUSED_VAR( J );
+    HPCREACT_UNUSED_VAR( r );
+    HPCREACT_UNUSED_VAR( dx );
+  }
+
+  /**
+   * @brief Called before each linear solve, for a Jacobian in packed symmetric storage.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param J The Jacobian matrix.
+   * @param r The right hand side.
+   * @param dx The update vector.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  static void linearSystem( symmetricMatrix< REAL_TYPE, int, N > const & J, REAL_TYPE const (&r)[N], REAL_TYPE const (&dx)[N] )
+  {
+    HPCREACT_UNUSED_VAR( J );
+    HPCREACT_UNUSED_VAR( r );
+    HPCREACT_UNUSED_VAR( dx );
+  }
+
+  /**
+   * @brief Called at the end of the solve.
+   * @param stats The statistics of the solve.
+   */
+  HPCREACT_HOST_DEVICE
+  static void result( SolverStats const & stats )
+  {
+    HPCREACT_UNUSED_VAR( stats );
+  }
+};
+
+// LCOV_EXCL_START
+/**
+ * @brief Logging policy of the nonlinear solvers that prints the residual
+ *        norm of every iteration and the outcome of the solve.
+ */
+struct PrintLogging : NoLogging
+{
+  /// @copydoc NoLogging::iteration
+  HPCREACT_HOST_DEVICE
+  static void iteration( int const iter, double const residualNorm )
+  {
+    printf( "--Iter %d: Residual norm = %.12e\n", iter, residualNorm );
+  }
+
+  /// @copydoc NoLogging::result
+  HPCREACT_HOST_DEVICE
+  static void result( SolverStats const & stats )
+  {
+    if( stats.isConverged )
+    {
+      printf( "--Converged.\n" );
+    }
+    else
+    {
+      printf( "--Newton solver error: Max iterations reached without convergence.\n" );
+    }
+  }
+};
+
+/**
+ * @brief Logging policy of the nonlinear solvers that additionally prints the
+ *        linear system of every iteration.
+ */
+struct VerboseLogging : PrintLogging
+{
+  /// @copydoc NoLogging::linearSystem
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  static void linearSystem( REAL_TYPE const (&J)[N][N], REAL_TYPE const (&r)[N], REAL_TYPE const (&dx)[N] )
+  {
+    utils::print( J, r, dx );
+  }
+
+  /// @copydoc NoLogging::linearSystem(symmetricMatrix<REAL_TYPE,int,N> const&,REAL_TYPE const(&)[N],REAL_TYPE const(&)[N])
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  static void linearSystem( symmetricMatrix< REAL_TYPE, int, N > const & J, REAL_TYPE const (&r)[N], REAL_TYPE const (&dx)[N] )
+  {
+    REAL_TYPE denseJ[N][N];
+    for( int i = 0; i < N; ++i )
+    {
+      for( int j = 0; j <= i; ++j )
+      {
+        denseJ[i][j] = J( i, j );
+        denseJ[j][i] = J( i, j );
+      }
+    }
+    utils::print( denseJ, r, dx );
+  }
+};
+// LCOV_EXCL_STOP
+
+/**
+ * @brief Globalization policy of newtonRaphson that always takes the full
+ *        Newton step.
+ * @details
+ *   A globalization policy provides
+ *   - maxStepLength( x, dx ): the initial step length along the Newton update dx,
+ *   - isSufficientDecrease( norm, trialNorm, stepLength ): the acceptance test
+ *     of a trial step,
+ *   - maxBacktracks and backtrackFactor: the number of allowed step length
+ *     reductions and the reduction factor.
+ */
+struct FullNewtonStep
+{
+  /// The maximum number of step length reductions.
+  static constexpr int maxBacktracks = 0;
+  /// The step length reduction factor.
+  static constexpr double backtrackFactor = 0.5;
+
+  /**
+   * @brief The initial step length along the Newton update.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The size of the system.
+   * @param x The current solution.
+   * @param dx The Newton update.
+   * @return The step length.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  REAL_TYPE maxStepLength( REAL_TYPE const (&x)[N], REAL_TYPE const (&dx)[N] ) const
+  {
+    HPCREACT_UNUSED_VAR( x );
+    HPCREACT_UNUSED_VAR( dx );
+    return 1.0;
+  }
+
+  /**
+   * @brief Acceptance test of a trial step.
+   * @param norm The residual norm at the current solution.
+   * @param trialNorm The residual norm at the trial solution.
+   * @param stepLength The step length of the trial solution.
+   * @return true if the trial step is accepted.
+   */
+  HPCREACT_HOST_DEVICE
+  bool isSufficientDecrease( double const norm, double const trialNorm, double const stepLength ) const
+  {
+    HPCREACT_UNUSED_VAR( norm );
+    HPCREACT_UNUSED_VAR( trialNorm );
+    HPCREACT_UNUSED_VAR( stepLength );
+    return true;
+  }
+};
+
+/**
+ * @brief Globalization policy of newtonRaphson with step length control and
+ *        Armijo backtracking on the residual norm.
+ * @details
+ *   The initial step length is limited so that
+ *   - no component of the update exceeds maxUpdate (e.g. a maximum change of
+ *     a log concentration), if maxUpdate > 0,
+ *   - positive components of the solution remain positive, moving at most a
+ *     fraction fractionToBoundary of the distance to zero, if
+ *     fractionToBoundary > 0.
+ *   The step is then halved until ||r(x + a dx)|| <= (1 - armijo a) ||r(x)||,
+ *   at most maxBacktracks times.
+ */
+struct BacktrackingLineSearch
+{
+  /// The maximum number of step length reductions.
+  int maxBacktracks = 10;
+  /// The step length reduction factor.
+  double backtrackFactor = 0.5;
+  /// The sufficient decrease parameter of the Armijo condition.
+  double armijo = 1.0e-4;
+  /// The maximum magnitude of a component of the update. Disabled if <= 0.
+  double maxUpdate = 0.0;
+  /// The fraction of the distance to zero a positive component may move. Disabled if <= 0.
+  double fractionToBoundary = 0.0;
+
+  /// @copydoc FullNewtonStep::maxStepLength
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  REAL_TYPE maxStepLength( REAL_TYPE const (&x)[N], REAL_TYPE const (&dx)[N] ) const
+  {
+    REAL_TYPE stepLength = 1.0;
+    for( int i = 0; i < N; ++i )
+    {
+      if( maxUpdate > 0.0 && fabs( dx[i] ) * stepLength > maxUpdate )
+      {
+        stepLength = maxUpdate / fabs( dx[i] );
+      }
+      if( fractionToBoundary > 0.0 && x[i] > 0.0 && x[i] + stepLength * dx[i] < ( 1.0 - fractionToBoundary ) * x[i] )
+      {
+        stepLength = -fractionToBoundary * x[i] / dx[i];
+      }
+    }
+    return stepLength;
+  }
+
+  /// @copydoc FullNewtonStep::isSufficientDecrease
+  HPCREACT_HOST_DEVICE
+  bool isSufficientDecrease( double const norm, double const trialNorm, double const stepLength ) const
+  {
+    return trialNorm <= ( 1.0 - armijo * stepLength ) * norm;
+  }
+};
+
+/**
+ * @brief Newton-Raphson solver.
+ * @tparam N The size of the system.
+ * @tparam LOGGING_POLICY The logging policy, see NoLogging.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam FUNCTION_TYPE The residual/jacobian callback type.
+ * @tparam LINEAR_SOLVER The linear solver policy, providing solve( A, b, x, stats ).
+ * @tparam GLOBALIZATION The globalization policy, see FullNewtonStep.
+ * @param x The solution, used as initial guess on entry.
+ * @param computeResidualAndJacobian Callback computing the residual and Jacobian at x.
+ * @param controls The convergence criteria and iteration limit.
+ * @param linearSolver The linear solver used for the Newton updates.
+ * @param globalization The step length control of the Newton updates.
+ * @return The statistics of the solve. The residual norms are weighted norms,
+ *         see SolverControls.
+ * @details
+ *   The residual and Jacobian of an accepted trial step are those of the next
+ *   iteration, so a line search only costs extra evaluations when the step
+ *   length is reduced.
+ *
+ *   The Jacobian passed to the callback is a dense REAL_TYPE[N][N], unless the
+ *   linear solver declares another JacobianType (e.g. the packed symmetric
+ *   storage of ScaledCholeskySolver).
+ */
+template< int N,
+          typename LOGGING_POLICY = NoLogging,
+          typename REAL_TYPE,
+          typename FUNCTION_TYPE,
+          typename LINEAR_SOLVER = PivotedLUSolver,
+          typename GLOBALIZATION = FullNewtonStep >
+HPCREACT_HOST_DEVICE
+SolverStats newtonRaphson( REAL_TYPE (& x)[N],
+                           FUNCTION_TYPE computeResidualAndJacobian,
+                           SolverControls< N > const & controls = SolverControls< N >(),
+                           LINEAR_SOLVER const & linearSolver = LINEAR_SOLVER{},
+                           GLOBALIZATION const & globalization = GLOBALIZATION{} )
+{
+  REAL_TYPE residual[N]{};
+  REAL_TYPE rhs[N]{};
+  REAL_TYPE dx[N]{};
+  REAL_TYPE x0[N]{};
+  typename internal::JacobianStorage< LINEAR_SOLVER, REAL_TYPE, N >::type jacobian{};
+  SolverStats stats;
+
+  computeResidualAndJacobian( x, residual, jacobian );
+  ++stats.numResidualEvaluations;
+  double norm = controls.residualNorm( residual );
+  stats.initialResidualNorm = norm;
+  double const tolerance = controls.residualTolerance( norm );
+  bool isUpdateConverged = false;
+
+  for( int iter = 0; ; ++iter )
+  {
+    stats.finalResidualNorm = norm;
+    LOGGING_POLICY::iteration( iter, norm );
+
+    if( norm < tolerance || isUpdateConverged )
+    {
+      stats.isConverged = true;
+      break;
+    }
+    if( iter == controls.maxIterations )
+    {
+      break;
+    }
+
+    for( int i = 0; i < N; ++i )
+    {
+      rhs[i] = -residual[i];
+      x0[i] = x[i];
+    }
+
+    LOGGING_POLICY::linearSystem( jacobian, rhs, dx );
+
+    linearSolver.solve( jacobian, rhs, dx, stats.linearSolverStats );
+    ++stats.numLinearSolves;
+
+    // move along dx until the globalization accepts the step
+    REAL_TYPE stepLength = globalization.maxStepLength( x0, dx );
+    for( int backtrack = 0; ; ++backtrack )
+    {
+      for( int i = 0; i < N; ++i )
+      {
+        x[i] = x0[i] + stepLength * dx[i];
+      }
+      computeResidualAndJacobian( x, residual, jacobian );
+      ++stats.numResidualEvaluations;
+      double const trialNorm = controls.residualNorm( residual );
+
+      if( backtrack >= globalization.maxBacktracks || globalization.isSufficientDecrease( norm, trialNorm, stepLength ) )
+      {
+        norm = trialNorm;
+        break;
+      }
+      stepLength *= globalization.backtrackFactor;
+      ++stats.numBacktracks;
+    }
+    isUpdateConverged = controls.isUpdateConverged( dx, stepLength );
+    ++stats.numIterations;
+  }
+
+  LOGGING_POLICY::result( stats );
+
+  return stats;
+}
+
+/**
+ * @brief Newton-Raphson solver with an absolute tolerance and iteration limit.
+ * @tparam N The size of the system.
+ * @tparam LOGGING_POLICY The logging policy, see NoLogging.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam FUNCTION_TYPE The residual/jacobian callback type.
+ * @tparam LINEAR_SOLVER The linear solver policy, providing solve( A, b, x, stats ).
+ * @tparam GLOBALIZATION The globalization policy, see FullNewtonStep.
+ * @param x The solution, used as initial guess on entry.
+ * @param computeResidualAndJacobian Callback computing the residual and Jacobian at x.
+ * @param maxIters The maximum number of Newton updates.
+ * @param tol The convergence tolerance on the residual norm.
+ * @param linearSolver The linear solver used for the Newton updates.
+ * @param globalization The step length control of the Newton updates.
+ * @return The statistics of the solve.
+ */
 template< int N,
+          typename LOGGING_POLICY = NoLogging,
           typename REAL_TYPE,
+          typename FUNCTION_TYPE,
+          typename LINEAR_SOLVER = PivotedLUSolver,
+          typename GLOBALIZATION = FullNewtonStep >
+HPCREACT_HOST_DEVICE
+SolverStats newtonRaphson( REAL_TYPE (& x)[N],
+                           FUNCTION_TYPE computeResidualAndJacobian,
+                           int const maxIters,
+                           double const tol,
+                           LINEAR_SOLVER const & linearSolver = LINEAR_SOLVER{},
+                           GLOBALIZATION const & globalization = GLOBALIZATION{} )
+{
+  return newtonRaphson< N, LOGGING_POLICY >( x,
+                                             computeResidualAndJacobian,
+                                             SolverControls< N >( maxIters, tol ),
+                                             linearSolver,
+                                             globalization );
+}
+
+/**
+ * @brief Jacobian factorization kept between chord Newton iterations.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @details The object is owned by the caller, so the factors may be reused
+ *          across calls to newtonRaphsonChord (e.g. across timesteps).
+ */
+template< typename REAL_TYPE, int N >
+struct ChordState
+{
+  /// The LU factorization of the last refreshed Jacobian.
+  LUFactorization< REAL_TYPE, N > factor;
+  /// Whether factor holds a valid factorization.
+  bool isFactored = false;
+  /// The number of factorizations performed.
+  int numFactorizations = 0;
+};
+
+/**
+ * @brief Chord (modified) Newton-Raphson that reuses the Jacobian factorization.
+ * @tparam N The size of the system.
+ * @tparam LOGGING_POLICY The logging policy, see NoLogging.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam RESIDUAL_FUNCTION_TYPE The residual callback type.
+ * @tparam FUNCTION_TYPE The residual/jacobian callback type.
+ * @param x The solution, used as initial guess on entry.
+ * @param computeResidual Callback computing only the residual at x.
+ * @param computeResidualAndJacobian Callback computing the residual and Jacobian at x.
+ * @param state The factorization to reuse. Updated when it is refreshed.
+ * @param controls The convergence criteria and iteration limit.
+ * @param contractionThreshold The Jacobian is refactored when the ratio of
+ *        successive residual norms exceeds this value.
+ * @return The statistics of the solve.
+ * @details
+ *   The Jacobian is only evaluated and factored when @p state holds no valid
+ *   factorization or when convergence slows down. Every other iteration costs
+ *   a single residual evaluation and a forward/back substitution, so for
+ *   nearly linear or slowly changing problems the Jacobian is rarely assembled.
+ */
+template< int N,
+          typename LOGGING_POLICY = NoLogging,
+          typename REAL_TYPE,
+          typename RESIDUAL_FUNCTION_TYPE,
           typename FUNCTION_TYPE >
 HPCREACT_HOST_DEVICE
-bool newtonRaphson( REAL_TYPE (& x)[N],
-                    FUNCTION_TYPE computeResidualAndJacobian,
-                    int maxIters = 12,
-                    double tol = 1e-10,
-                    bool const do_print = false )
+SolverStats newtonRaphsonChord( REAL_TYPE (& x)[N],
+                                RESIDUAL_FUNCTION_TYPE computeResidual,
+                                FUNCTION_TYPE computeResidualAndJacobian,
+                                ChordState< REAL_TYPE, N > & state,
+                                SolverControls< N > const & controls = SolverControls< N >( 25 ),
+                                double contractionThreshold = 0.5 )
 {
   REAL_TYPE residual[N]{};
   REAL_TYPE dx[N]{};
   REAL_TYPE jacobian[N][N]{};
-  bool isConverged = false;
+  SolverStats stats;
 
-  for( int iter = 0; iter < maxIters; ++iter )
+  // the jacobian at x, replacing the current factors
+  auto refreshJacobian = [&]()
   {
     computeResidualAndJacobian( x, residual, jacobian );
+    factorNxN_LU( jacobian, state.factor );
+    state.isFactored = true;
+    ++state.numFactorizations;
+  };
 
-    double const norm = internal::norm< N >( residual );
+  if( state.isFactored )
+  {
+    computeResidual( x, residual );
+  }
+  else
+  {
+    refreshJacobian();
+  }
+  ++stats.numResidualEvaluations;
+  double norm = controls.residualNorm( residual );
+  double previousNorm = norm;
+  stats.initialResidualNorm = norm;
+  double const tolerance = controls.residualTolerance( norm );
+  bool isUpdateConverged = false;
 
-    printf( "--Iter %d: Residual norm = %.12e\n", iter, norm );
+  for( int iter = 0; ; ++iter )
+  {
+    stats.finalResidualNorm = norm;
+    LOGGING_POLICY::iteration( iter, norm );
 
-    if( norm < tol )
+    if( norm < tolerance || isUpdateConverged )
     {
-      printf( "--Converged.\n" );
-      isConverged = true;
+      stats.isConverged = true;
       break;
     }
+    if( iter == controls.maxIterations )
+    {
+      break;
+    }
+
+    // refresh the factors when they no longer contract the residual fast enough
+    if( iter > 0 && norm > contractionThreshold * previousNorm )
+    {
+      refreshJacobian();
+    }
+
     internal::scale< N >( residual, -1.0 );
+    solveNxN_LU( state.factor, residual, dx );
+    ++stats.numLinearSolves;
+    internal::add< N >( x, dx );
+    ++stats.numIterations;
+    isUpdateConverged = controls.isUpdateConverged( dx, 1.0 );
+
+    previousNorm = norm;
+    computeResidual( x, residual );
+    ++stats.numResidualEvaluations;
+    norm = controls.residualNorm( residual );
+  }
+
+  LOGGING_POLICY::result( stats );
+
+  return stats;
+}
+
+/**
+ * @brief Chord Newton-Raphson with an absolute tolerance and iteration limit.
+ * @tparam N The size of the system.
+ * @tparam LOGGING_POLICY The logging policy, see NoLogging.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam RESIDUAL_FUNCTION_TYPE The residual callback type.
+ * @tparam FUNCTION_TYPE The residual/jacobian callback type.
+ * @param x The solution, used as initial guess on entry.
+ * @param computeResidual Callback computing only the residual at x.
+ * @param computeResidualAndJacobian Callback computing the residual and Jacobian at x.
+ * @param state The factorization to reuse. Updated when it is refreshed.
+ * @param maxIters The maximum number of iterations.
+ * @param tol The convergence tolerance on the residual norm.
+ * @param contractionThreshold The Jacobian is refactored when the ratio of
+ *        successive residual norms exceeds this value.
+ * @return The statistics of the solve.
+ */
+template< int N,
+          typename LOGGING_POLICY = NoLogging,
+          typename REAL_TYPE,
+          typename RESIDUAL_FUNCTION_TYPE,
+          typename FUNCTION_TYPE >
+HPCREACT_HOST_DEVICE
+SolverStats newtonRaphsonChord( REAL_TYPE (& x)[N],
+                                RESIDUAL_FUNCTION_TYPE computeResidual,
+                                FUNCTION_TYPE computeResidualAndJacobian,
+                                ChordState< REAL_TYPE, N > & state,
+                                int const maxIters,
+                                double const tol,
+                                double contractionThreshold = 0.5 )
+{
+  return newtonRaphsonChord< N, LOGGING_POLICY >( x,
+                                                  computeResidual,
+                                                  computeResidualAndJacobian,
+                                                  state,
+                                                  SolverControls< N >( maxIters, tol ),
+                                                  contractionThreshold );
+}
+
+/**
+ * @brief Persistent per-cell state used to warm start the nonlinear solves.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @details
+ *   One object is kept per cell between timesteps (or between the
+ *   re-equilibrations following transport). It holds the last converged
+ *   solution, the LU factorization of a recent Jacobian, reused as in
+ *   newtonRaphsonChord, and the size of the last step taken from it.
+ *
+ *   The size is sizeof( REAL_TYPE ) * ( N * N + N + 1 ) + sizeof( int ) * ( N + 1 )
+ *   + 2 bytes before padding. For the 7 primary species of the carbonate
+ *   system in double precision, sizeof( WarmStartState< double, 7 > ) = 504
+ *   bytes, i.e. about 50 GB for 1e8 cells, of which 392 bytes per cell are the
+ *   LU factors. Where that is too much, a state without factorization can be
+ *   emulated by clearing chord.isFactored before each solve, at the cost of
+ *   one factorization per solve.
+ */
+template< typename REAL_TYPE, int N >
+struct WarmStartState
+{
+  /// The last converged solution.
+  REAL_TYPE solution[N];
+  /// The factorization of a recent Jacobian.
+  ChordState< REAL_TYPE, N > chord;
+  /// The size of the last step (e.g. timestep) taken from solution.
+  REAL_TYPE lastStepSize = 0.0;
+  /// Whether solution holds a converged solution.
+  bool hasSolution = false;
+};
+
+/**
+ * @brief Extrapolation of the initial guess of implicit timesteps.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @details
+ *   Holds the last three accepted states and the timesteps between them.
+ *   predict() extrapolates them to the end of the next timestep with the
+ *   Lagrange polynomial of degree order (or lower while the history is
+ *   short). The states should be in log space (log concentrations), where the
+ *   solution of kinetic systems is closer to polynomial in time. The change
+ *   of a component from the last state is limited to maxChange, i.e. a
+ *   factor e for the default in log space.
+ */
+template< typename REAL_TYPE, int N >
+struct TimeStepPredictor
+{
+  /// The extrapolation order: 0 (last state), 1 (linear) or 2 (quadratic).
+  int order = 1;
+  /// The largest change of a component from the last state.
+  REAL_TYPE maxChange = 1.0;
+  /// Also solve from the last state to measure SolverStats::numIterationsSaved.
+  /// This doubles the cost of the timestep and is meant for tuning.
+  bool measureSavings = false;
+  /// The accepted states, most recent first.
+  REAL_TYPE history[3][N]{};
+  /// stepSizes[k] is the timestep from history[k+1] to history[k].
+  REAL_TYPE stepSizes[2]{};
+  /// The number of valid states in history.
+  int numStates = 0;
 
-    if( do_print )
+  /**
+   * @brief Record an accepted state.
+   * @param x The state.
+   * @param stepSize The timestep from the previously accepted state to @p x.
+   */
+  HPCREACT_HOST_DEVICE
+  void accept( REAL_TYPE const (&x)[N], REAL_TYPE const stepSize )
+  {
+    for( int i = 0; i < N; ++i )
     {
-      utils::print( jacobian, residual, dx ); // LCOV_EXCL_LINE
+      history[2][i] = history[1][i];
+      history[1][i] = history[0][i];
+      history[0][i] = x[i];
     }
+    stepSizes[1] = stepSizes[0];
+    stepSizes[0] = stepSize;
+    numStates = numStates < 3 ? numStates + 1 : 3;
+  }
 
-    solveNxN_pivoted< REAL_TYPE, N >( jacobian, residual, dx );
+  /**
+   * @brief Extrapolate the accepted states.
+   * @param stepSize The timestep from the last accepted state.
+   * @param x The predicted state. Unchanged if no state was accepted yet.
+   */
+  HPCREACT_HOST_DEVICE
+  void predict( REAL_TYPE const stepSize, REAL_TYPE (& x)[N] ) const
+  {
+    if( numStates == 0 )
+    {
+      return;
+    }
+
+    int const usedOrder = order < numStates - 1 ? order : numStates - 1;
+
+    // Lagrange weights at t = stepSize of the nodes t_0 = 0, t_1 = -h_0, t_2 = -h_0 - h_1
+    REAL_TYPE weights[3] = { 1.0, 0.0, 0.0 };
+    if( usedOrder == 1 )
+    {
+      REAL_TYPE const ratio = stepSize / stepSizes[0];
+      weights[0] = 1.0 + ratio;
+      weights[1] = -ratio;
+    }
+    else if( usedOrder == 2 )
+    {
+      REAL_TYPE const t1 = -stepSizes[0];
+      REAL_TYPE const t2 = -stepSizes[0] - stepSizes[1];
+      weights[0] = ( stepSize - t1 ) * ( stepSize - t2 ) / ( t1 * t2 );
+      weights[1] = stepSize * ( stepSize - t2 ) / ( t1 * ( t1 - t2 ) );
+      weights[2] = stepSize * ( stepSize - t1 ) / ( t2 * ( t2 - t1 ) );
+    }
+
+    for( int i = 0; i < N; ++i )
+    {
+      REAL_TYPE change = ( weights[0] - 1.0 ) * history[0][i];
+      for( int k = 1; k <= usedOrder; ++k )
+      {
+        change += weights[k] * history[k][i];
+      }
+      change = change > maxChange ? maxChange : ( change < -maxChange ? -maxChange : change );
+      x[i] = history[0][i] + change;
+    }
+  }
+};
+
+/**
+ * @brief Accumulate the counters of a solve into the statistics of another.
+ * @param stats The statistics to update.
+ * @param other The statistics of a subsequent solve of the same problem.
+ * @details The norms and the convergence flag are taken from @p other.
+ */
+HPCREACT_HOST_DEVICE
+inline void accumulate( SolverStats & stats, SolverStats const & other )
+{
+  stats.numIterations += other.numIterations;
+  stats.finalResidualNorm = other.finalResidualNorm;
+  stats.isConverged = other.isConverged;
+  stats.numLinearSolves += other.numLinearSolves;
+  stats.numResidualEvaluations += other.numResidualEvaluations;
+  stats.numBacktracks += other.numBacktracks;
+  stats.numIterationsSaved += other.numIterationsSaved;
+  stats.linearSolverStats.numRefinements += other.linearSolverStats.numRefinements;
+  stats.linearSolverStats.numFallbacks += other.linearSolverStats.numFallbacks;
+  stats.linearSolverStats.numPivotHintRejections += other.linearSolverStats.numPivotHintRejections;
+}
+
+/**
+ * @brief Newton-Raphson solver warm started from a persistent state.
+ * @tparam N The size of the system.
+ * @tparam LOGGING_POLICY The logging policy, see NoLogging.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam RESIDUAL_FUNCTION_TYPE The residual callback type.
+ * @tparam FUNCTION_TYPE The residual/jacobian callback type.
+ * @tparam COLD_START_LINEAR_SOLVER The linear solver policy of the cold start,
+ *         providing solve( A, b, x, stats ).
+ * @tparam COLD_START_GLOBALIZATION The globalization policy of the cold start, see FullNewtonStep.
+ * @param x On entry, the initial guess used when @p state holds no solution or
+ *        the warm start fails. On exit, the solution.
+ * @param computeResidual Callback computing only the residual at x, used by
+ *        the chord iterations that reuse the stored factorization.
+ * @param computeResidualAndJacobian Callback computing the residual and Jacobian at x.
+ * @param state The warm start state. Updated with the solution on convergence.
+ * @param controls The convergence criteria and iteration limit.
+ * @param coldStartLinearSolver The linear solver used by the cold start only.
+ * @param coldStartGlobalization The step length control of the cold start only.
+ * @return The accumulated statistics of the warm and cold start.
+ * @details
+ *   If @p state holds a solution, the solve starts from it with
+ *   newtonRaphsonChord, reusing the stored factorization. If that does not
+ *   converge, newtonRaphson restarts from the guess in @p x, and the stored
+ *   factorization is invalidated so that the next warm start refactors.
+ *
+ *   The warm path always factors with the dense pivoted LU of ChordState and
+ *   takes full steps: the linear solver policies only provide solve(), so they
+ *   cannot keep factors between calls. The policies passed here only apply to
+ *   the cold start, which is also the fallback when full chord steps from the
+ *   stored solution do not converge.
+ */
+template< int N,
+          typename LOGGING_POLICY = NoLogging,
+          typename REAL_TYPE,
+          typename RESIDUAL_FUNCTION_TYPE,
+          typename FUNCTION_TYPE,
+          typename COLD_START_LINEAR_SOLVER = PivotedLUSolver,
+          typename COLD_START_GLOBALIZATION = FullNewtonStep >
+HPCREACT_HOST_DEVICE
+SolverStats newtonRaphsonWarmStart( REAL_TYPE (& x)[N],
+                                    RESIDUAL_FUNCTION_TYPE computeResidual,
+                                    FUNCTION_TYPE computeResidualAndJacobian,
+                                    WarmStartState< REAL_TYPE, N > & state,
+                                    SolverControls< N > const & controls = SolverControls< N >(),
+                                    COLD_START_LINEAR_SOLVER const & coldStartLinearSolver = COLD_START_LINEAR_SOLVER{},
+                                    COLD_START_GLOBALIZATION const & coldStartGlobalization = COLD_START_GLOBALIZATION{} )
+{
+  SolverStats stats;
+
+  if( state.hasSolution )
+  {
+    REAL_TYPE xWarm[N];
+    for( int i = 0; i < N; ++i )
+    {
+      xWarm[i] = state.solution[i];
+    }
+    stats = newtonRaphsonChord< N, LOGGING_POLICY >( xWarm,
+                                                     computeResidual,
+                                                     computeResidualAndJacobian,
+                                                     state.chord,
+                                                     controls );
+    if( stats.isConverged )
+    {
+      for( int i = 0; i < N; ++i )
+      {
+        x[i] = xWarm[i];
+        state.solution[i] = xWarm[i];
+      }
+      return stats;
+    }
+    state.chord.isFactored = false;
+  }
+
+  SolverStats const coldStats = newtonRaphson< N, LOGGING_POLICY >( x,
+                                                                    computeResidualAndJacobian,
+                                                                    controls,
+                                                                    coldStartLinearSolver,
+                                                                    coldStartGlobalization );
+  if( state.hasSolution )
+  {
+    accumulate( stats, coldStats );
+  }
+  else
+  {
+    stats = coldStats;
+  }
+
+  state.hasSolution = stats.isConverged;
+  for( int i = 0; i < N; ++i )
+  {
+    state.solution[i] = x[i];
+  }
+  return stats;
+}
+
+/**
+ * @brief Factorization and rank-one updates kept between Broyden iterations.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @tparam MAX_UPDATES The maximum number of rank-one updates applied to the
+ *         factorization before the analytical Jacobian is recomputed.
+ * @details
+ *   The inverse of the Broyden Jacobian is kept in product form
+ *     H_k = ( I + u_{k-1} s_{k-1}^T ) ... ( I + u_0 s_0^T ) J_0^{-1},
+ *   where J_0^{-1} is applied with the LU factors of the last analytical
+ *   Jacobian. Applying an update costs 2N flops, so the factors are never
+ *   modified in place. The object is owned by the caller, so the factors and
+ *   updates may be reused across calls to broyden (e.g. across timesteps).
+ */
+template< typename REAL_TYPE, int N, int MAX_UPDATES = 8 >
+struct BroydenState
+{
+  /// The LU factorization of the last analytical Jacobian.
+  LUFactorization< REAL_TYPE, N > factor;
+  /// The update directions u_k.
+  REAL_TYPE u[MAX_UPDATES][N];
+  /// The steps s_k.
+  REAL_TYPE s[MAX_UPDATES][N];
+  /// The number of updates applied to the factorization.
+  int numUpdates = 0;
+  /// Whether factor holds a valid factorization.
+  bool isFactored = false;
+  /// The number of analytical Jacobian evaluations and factorizations.
+  int numFactorizations = 0;
+};
+
+namespace internal
+{
+
+/**
+ * @brief Apply the inverse of the Broyden Jacobian, x = H b.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam N The size of the system.
+ * @tparam MAX_UPDATES The capacity of the state.
+ * @param state The factorization and updates.
+ * @param b The vector to apply the inverse to.
+ * @param x The result.
+ */
+template< typename REAL_TYPE, int N, int MAX_UPDATES >
+HPCREACT_HOST_DEVICE
+void applyBroydenInverse( BroydenState< REAL_TYPE, N, MAX_UPDATES > const & state,
+                          REAL_TYPE const (&b)[N],
+                          REAL_TYPE (& x)[N] )
+{
+  solveNxN_LU( state.factor, b, x );
+  for( int k = 0; k < state.numUpdates; ++k )
+  {
+    REAL_TYPE sx = 0.0;
+    for( int i = 0; i < N; ++i )
+    {
+      sx += state.s[k][i] * x[i];
+    }
+    for( int i = 0; i < N; ++i )
+    {
+      x[i] += state.u[k][i] * sx;
+    }
+  }
+}
+
+}
+
+/**
+ * @brief Quasi-Newton solver using Broyden's "good" update.
+ * @tparam N The size of the system.
+ * @tparam LOGGING_POLICY The logging policy, see NoLogging.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam RESIDUAL_FUNCTION_TYPE The residual callback type.
+ * @tparam FUNCTION_TYPE The residual/jacobian callback type.
+ * @tparam MAX_UPDATES The capacity of the state.
+ * @param x The solution, used as initial guess on entry.
+ * @param computeResidual Callback computing only the residual at x.
+ * @param computeResidualAndJacobian Callback computing the residual and Jacobian at x.
+ * @param state The factorization and updates to reuse. Updated by the solve.
+ * @param controls The convergence criteria and iteration limit.
+ * @param contractionThreshold The analytical Jacobian is recomputed when the
+ *        ratio of successive residual norms exceeds this value.
+ * @return The statistics of the solve. numLinearSolves counts the
+ *         applications of the LU factors.
+ * @details
+ *   The analytical Jacobian is only evaluated when @p state holds no valid
+ *   factorization, when convergence stalls, or when MAX_UPDATES updates have
+ *   been applied. Every other iteration costs a single residual evaluation and
+ *   two substitutions with the stored factors, which pays off when assembling
+ *   the Jacobian costs more than computing the residual.
+ */
+template< int N,
+          typename LOGGING_POLICY = NoLogging,
+          typename REAL_TYPE,
+          typename RESIDUAL_FUNCTION_TYPE,
+          typename FUNCTION_TYPE,
+          int MAX_UPDATES >
+HPCREACT_HOST_DEVICE
+SolverStats broyden( REAL_TYPE (& x)[N],
+                     RESIDUAL_FUNCTION_TYPE computeResidual,
+                     FUNCTION_TYPE computeResidualAndJacobian,
+                     BroydenState< REAL_TYPE, N, MAX_UPDATES > & state,
+                     SolverControls< N > const & controls = SolverControls< N >( 25 ),
+                     double const contractionThreshold = 0.5 )
+{
+  REAL_TYPE residual[N]{};
+  REAL_TYPE newResidual[N]{};
+  REAL_TYPE dx[N]{};
+  REAL_TYPE Hy[N]{};
+  REAL_TYPE jacobian[N][N]{};
+  SolverStats stats;
+
+  // the analytical jacobian at x, replacing the current factors and updates
+  auto refreshJacobian = [&]( REAL_TYPE (& r)[N] )
+  {
+    computeResidualAndJacobian( x, r, jacobian );
+    factorNxN_LU( jacobian, state.factor );
+    state.isFactored = true;
+    state.numUpdates = 0;
+    ++state.numFactorizations;
+  };
+
+  if( state.isFactored )
+  {
+    computeResidual( x, residual );
+  }
+  else
+  {
+    refreshJacobian( residual );
+  }
+  ++stats.numResidualEvaluations;
+  double norm = controls.residualNorm( residual );
+  stats.initialResidualNorm = norm;
+  double const tolerance = controls.residualTolerance( norm );
+  bool isUpdateConverged = false;
+
+  for( int iter = 0; ; ++iter )
+  {
+    stats.finalResidualNorm = norm;
+    LOGGING_POLICY::iteration( iter, norm );
+
+    if( norm < tolerance || isUpdateConverged )
+    {
+      stats.isConverged = true;
+      break;
+    }
+    if( iter == controls.maxIterations )
+    {
+      break;
+    }
+
+    internal::applyBroydenInverse( state, residual, dx );
+    ++stats.numLinearSolves;
+    internal::scale< N >( dx, -1.0 );
     internal::add< N >( x, dx );
+    ++stats.numIterations;
+    isUpdateConverged = controls.isUpdateConverged( dx, 1.0 );
+
+    computeResidual( x, newResidual );
+    ++stats.numResidualEvaluations;
+    double const newNorm = controls.residualNorm( newResidual );
+
+    bool isStalled = newNorm > contractionThreshold * norm || state.numUpdates == MAX_UPDATES;
+    if( !isStalled )
+    {
+      // H_{k+1} = ( I + u s^T ) H_k, with u = ( s - H_k y ) / ( s^T H_k y ) and y = r_{k+1} - r_k
+      for( int i = 0; i < N; ++i )
+      {
+        residual[i] = newResidual[i] - residual[i];
+      }
+      internal::applyBroydenInverse( state, residual, Hy );
+      ++stats.numLinearSolves;
 
+      REAL_TYPE sHy = 0.0;
+      REAL_TYPE ss = 0.0;
+      for( int i = 0; i < N; ++i )
+      {
+        sHy += dx[i] * Hy[i];
+        ss += dx[i] * dx[i];
+      }
+
+      // a vanishing denominator would make the updated inverse singular
+      isStalled = fabs( sHy ) <= 1.0e-12 * ss;
+      if( !isStalled )
+      {
+        int const k = state.numUpdates;
+        for( int i = 0; i < N; ++i )
+        {
+          state.u[k][i] = ( dx[i] - Hy[i] ) / sHy;
+          state.s[k][i] = dx[i];
+        }
+        ++state.numUpdates;
+      }
+    }
+
+    if( isStalled )
+    {
+      refreshJacobian( newResidual );
+    }
+
+    for( int i = 0; i < N; ++i )
+    {
+      residual[i] = newResidual[i];
+    }
+    norm = newNorm;
   }
 
-  if( !isConverged )
+  LOGGING_POLICY::result( stats );
+
+  return stats;
+}
+
+/**
+ * @brief Anderson-accelerated fixed-point iteration.
+ * @tparam N The size of the system.
+ * @tparam WINDOW The number of previous iterates used by the acceleration.
+ * @tparam LOGGING_POLICY The logging policy, see NoLogging.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam FUNCTION_TYPE The fixed-point residual callback type.
+ * @param x The solution, used as initial guess on entry.
+ * @param computeFixedPointResidual Callback computing f(x) = g(x) - x for the
+ *        fixed-point map g.
+ * @param controls The convergence criteria and iteration limit, applied to f.
+ * @param mixing The damping of the underlying fixed-point update x + mixing * f(x).
+ * @return The statistics of the solve. numLinearSolves counts the
+ *         least-squares solves of the acceleration.
+ * @details
+ *   Each iteration solves the WINDOW x WINDOW least-squares problem
+ *     gamma = argmin || f_k - dF gamma ||
+ *   over the differences dF (and dX) of the last WINDOW residuals (and
+ *   iterates) by its regularized normal equations, and sets
+ *     x_{k+1} = x_k + mixing f_k - ( dX + mixing dF ) gamma.
+ *   No Jacobian is needed, and the history is held in fixed-size arrays so the
+ *   solver runs on device.
+ */
+template< int N,
+          int WINDOW = 4,
+          typename LOGGING_POLICY = NoLogging,
+          typename REAL_TYPE,
+          typename FUNCTION_TYPE >
+HPCREACT_HOST_DEVICE
+SolverStats andersonAcceleration( REAL_TYPE (& x)[N],
+                                  FUNCTION_TYPE computeFixedPointResidual,
+                                  SolverControls< N > const & controls = SolverControls< N >( 50 ),
+                                  double const mixing = 1.0 )
+{
+  static_assert( WINDOW > 0, "the Anderson window must hold at least one iterate" );
+
+  REAL_TYPE f[N]{};
+  REAL_TYPE dx[N]{};
+  REAL_TYPE dX[WINDOW][N]{};
+  REAL_TYPE dF[WINDOW][N]{};
+  REAL_TYPE normalMatrix[WINDOW][WINDOW]{};
+  REAL_TYPE normalRhs[WINDOW]{};
+  REAL_TYPE gamma[WINDOW]{};
+  SolverStats stats;
+
+  computeFixedPointResidual( x, f );
+  ++stats.numResidualEvaluations;
+  double norm = controls.residualNorm( f );
+  stats.initialResidualNorm = norm;
+  double const tolerance = controls.residualTolerance( norm );
+  bool isUpdateConverged = false;
+
+  // the history is a ring buffer, column k % WINDOW holds the k-th difference
+  // stored since the last restart, so the first historySize columns are in use
+  int historySize = 0;
+  int historyHead = 0;
+
+  for( int iter = 0; ; ++iter )
   {
-    printf( "--Newton solver error: Max iterations reached without convergence.\n" ); // LCOV_EXCL_LINE
+    stats.finalResidualNorm = norm;
+    LOGGING_POLICY::iteration( iter, norm );
+
+    if( norm < tolerance || isUpdateConverged )
+    {
+      stats.isConverged = true;
+      break;
+    }
+    if( iter == controls.maxIterations )
+    {
+      break;
+    }
+
+    for( int i = 0; i < N; ++i )
+    {
+      dx[i] = mixing * f[i];
+    }
+
+    if( historySize > 0 )
+    {
+      // ( dF^T dF + lambda I ) gamma = dF^T f, with the unused columns decoupled
+      REAL_TYPE trace = 0.0;
+      for( int a = 0; a < WINDOW; ++a )
+      {
+        normalRhs[a] = 0.0;
+        for( int b = 0; b < WINDOW; ++b )
+        {
+          normalMatrix[a][b] = 0.0;
+        }
+        if( a >= historySize )
+        {
+          normalMatrix[a][a] = 1.0;
+          continue;
+        }
+        for( int i = 0; i < N; ++i )
+        {
+          normalRhs[a] += dF[a][i] * f[i];
+        }
+        for( int b = 0; b <= a; ++b )
+        {
+          for( int i = 0; i < N; ++i )
+          {
+            normalMatrix[a][b] += dF[a][i] * dF[b][i];
+          }
+          normalMatrix[b][a] = normalMatrix[a][b];
+        }
+        trace += normalMatrix[a][a];
+      }
+
+      // a stagnated residual leaves nothing to extrapolate from
+      if( trace > 0.0 )
+      {
+        for( int a = 0; a < historySize; ++a )
+        {
+          normalMatrix[a][a] += 1.0e-12 * trace;
+        }
+
+        solveNxN_pivoted< REAL_TYPE, WINDOW >( normalMatrix, normalRhs, gamma );
+        ++stats.numLinearSolves;
+
+        for( int a = 0; a < historySize; ++a )
+        {
+          for( int i = 0; i < N; ++i )
+          {
+            dx[i] -= ( dX[a][i] + mixing * dF[a][i] ) * gamma[a];
+          }
+        }
+      }
+    }
+
+    // store the differences of this step, completed once f(x + dx) is known
+    int const column = historyHead % WINDOW;
+    for( int i = 0; i < N; ++i )
+    {
+      x[i] += dx[i];
+      dX[column][i] = dx[i];
+      dF[column][i] = -f[i];
+    }
+    ++stats.numIterations;
+    isUpdateConverged = controls.isUpdateConverged( dx, 1.0 );
+
+    double const previousNorm = norm;
+    computeFixedPointResidual( x, f );
+    ++stats.numResidualEvaluations;
+    norm = controls.residualNorm( f );
+
+    for( int i = 0; i < N; ++i )
+    {
+      dF[column][i] += f[i];
+    }
+    historySize = historySize < WINDOW ? historySize + 1 : WINDOW;
+    ++historyHead;
+
+    // restart the acceleration when the extrapolation increased the residual
+    if( norm > previousNorm )
+    {
+      historySize = 0;
+      historyHead = 0;
+    }
   }
 
-  return isConverged;
+  LOGGING_POLICY::result( stats );
+
+  return stats;
+}
+
+/**
+ * @brief Parameters of the dogleg trust-region solver.
+ */
+struct TrustRegionParameters
+{
+  /// The initial trust-region radius, in the 2-norm of the update.
+  double initialRadius = 1.0;
+  /// The largest trust-region radius.
+  double maxRadius = 1.0e3;
+  /// The smallest ratio of actual to predicted decrease for which a step is accepted.
+  double acceptanceRatio = 1.0e-4;
+  /// The number of rejected steps in one iteration after which the solve stops without convergence.
+  int maxRejections = 30;
+};
+
+/**
+ * @brief Dogleg trust-region solver.
+ * @tparam N The size of the system.
+ * @tparam LOGGING_POLICY The logging policy, see NoLogging.
+ * @tparam REAL_TYPE The floating point type.
+ * @tparam RESIDUAL_FUNCTION_TYPE The residual callback type.
+ * @tparam FUNCTION_TYPE The residual/jacobian callback type.
+ * @tparam LINEAR_SOLVER The linear solver policy, providing solve( A, b, x, stats ).
+ * @param x The solution, used as initial guess on entry. If a step is rejected
+ *        maxRejections times, the last accepted iterate.
+ * @param computeResidual Callback computing only the residual at x, used for
+ *        the trial steps.
+ * @param computeResidualAndJacobian Callback computing the residual and Jacobian at x,
+ *        with the same convention as newtonRaphson.
+ * @param controls The convergence criteria and iteration limit.
+ * @param trustRegion The parameters of the trust region.
+ * @param linearSolver The linear solver used for the Newton steps.
+ * @return The statistics of the solve. numBacktracks counts the rejected steps.
+ * @details
+ *   Each iteration minimizes the model || W ( r + J p ) ||^2 within
+ *   || p || <= radius along Powell's dogleg path, where W holds the residual
+ *   weights of @p controls, so that the steps are measured with the norm of the
+ *   convergence test. The step is the Newton step if it fits in the trust
+ *   region, otherwise the path from the Cauchy (steepest descent) point towards
+ *   the Newton step, cut at the radius. Steps whose actual decrease of the
+ *   squared residual norm is small compared to the model prediction are
+ *   rejected and the radius is reduced; the radius grows after steps the model
+ *   predicted well. Trial steps only evaluate the residual, the Jacobian is
+ *   evaluated once a step is accepted. Contrary to a line search along the
+ *   Newton direction, the step turns towards the gradient when the Newton
+ *   direction is poor, as happens for badly scaled equilibrium problems far
+ *   from the solution.
+ */
+template< int N,
+          typename LOGGING_POLICY = NoLogging,
+          typename REAL_TYPE,
+          typename RESIDUAL_FUNCTION_TYPE,
+          typename FUNCTION_TYPE,
+          typename LINEAR_SOLVER = PivotedLUSolver >
+HPCREACT_HOST_DEVICE
+SolverStats doglegTrustRegion( REAL_TYPE (& x)[N],
+                               RESIDUAL_FUNCTION_TYPE computeResidual,
+                               FUNCTION_TYPE computeResidualAndJacobian,
+                               SolverControls< N > const & controls = SolverControls< N >(),
+                               TrustRegionParameters const & trustRegion = TrustRegionParameters{},
+                               LINEAR_SOLVER const & linearSolver = LINEAR_SOLVER{} )
+{
+  REAL_TYPE residual[N]{};
+  REAL_TYPE jacobian[N][N]{};
+  REAL_TYPE trialResidual[N]{};
+  REAL_TYPE rhs[N]{};
+  REAL_TYPE newtonStep[N]{};
+  REAL_TYPE cauchyStep[N]{};
+  REAL_TYPE gradient[N]{};
+  REAL_TYPE step[N]{};
+  REAL_TYPE x0[N]{};
+  SolverStats stats;
+
+  auto squaredNorm = []( REAL_TYPE const (&v)[N] )
+  {
+    double sum = 0.0;
+    for( int i = 0; i < N; ++i )
+    {
+      sum += v[i] * v[i];
+    }
+    return sum;
+  };
+
+  computeResidual( x, residual );
+  ++stats.numResidualEvaluations;
+  double norm = controls.residualNorm( residual );
+  stats.initialResidualNorm = norm;
+  double const tolerance = controls.residualTolerance( norm );
+  double radius = trustRegion.initialRadius;
+  bool isUpdateConverged = false;
+
+  for( int iter = 0; ; ++iter )
+  {
+    stats.finalResidualNorm = norm;
+    LOGGING_POLICY::iteration( iter, norm );
+
+    if( norm < tolerance || isUpdateConverged )
+    {
+      stats.isConverged = true;
+      break;
+    }
+    if( iter == controls.maxIterations )
+    {
+      break;
+    }
+
+    // the residual at x is already known, only the jacobian is needed
+    computeResidualAndJacobian( x, residual, jacobian );
+
+    for( int i = 0; i < N; ++i )
+    {
+      rhs[i] = -residual[i];
+      x0[i] = x[i];
+    }
+
+    LOGGING_POLICY::linearSystem( jacobian, rhs, newtonStep );
+
+    linearSolver.solve( jacobian, rhs, newtonStep, stats.linearSolverStats );
+    ++stats.numLinearSolves;
+
+    // steepest descent direction of || W r ||^2 / 2 and the minimizer of the model along it
+    for( int j = 0; j < N; ++j )
+    {
+      gradient[j] = 0.0;
+      for( int i = 0; i < N; ++i )
+      {
+        gradient[j] += jacobian[i][j] * controls.residualWeights[i] * controls.residualWeights[i] * residual[i];
+      }
+    }
+    double jacobianGradientNorm2 = 0.0;
+    for( int i = 0; i < N; ++i )
+    {
+      double jacobianGradient = 0.0;
+      for( int j = 0; j < N; ++j )
+      {
+        jacobianGradient += jacobian[i][j] * gradient[j];
+      }
+      jacobianGradient *= controls.residualWeights[i];
+      jacobianGradientNorm2 += jacobianGradient * jacobianGradient;
+    }
+    double const gradientNorm2 = squaredNorm( gradient );
+    double const cauchyLength = jacobianGradientNorm2 > 0.0 ? gradientNorm2 / jacobianGradientNorm2 : 0.0;
+    for( int i = 0; i < N; ++i )
+    {
+      cauchyStep[i] = -cauchyLength * gradient[i];
+    }
+
+    double const newtonNorm = ::sqrt( squaredNorm( newtonStep ) );
+    double const cauchyNorm = ::sqrt( squaredNorm( cauchyStep ) );
+    double const residualNorm2 = norm * norm;
+    bool isAccepted = false;
+
+    for( int rejection = 0; ; ++rejection )
+    {
+      // the dogleg step for the current radius
+      if( newtonNorm <= radius )
+      {
+        for( int i = 0; i < N; ++i )
+        {
+          step[i] = newtonStep[i];
+        }
+      }
+      else if( cauchyNorm >= radius )
+      {
+        for( int i = 0; i < N; ++i )
+        {
+          step[i] = radius / cauchyNorm * cauchyStep[i];
+        }
+      }
+      else
+      {
+        // || c + tau ( n - c ) || = radius
+        double a = 0.0;
+        double b = 0.0;
+        for( int i = 0; i < N; ++i )
+        {
+          double const d = newtonStep[i] - cauchyStep[i];
+          a += d * d;
+          b += cauchyStep[i] * d;
+        }
+        double const c = cauchyNorm * cauchyNorm - radius * radius;
+        double const tau = ( -b + ::sqrt( b * b - a * c ) ) / a;
+        for( int i = 0; i < N; ++i )
+        {
+          step[i] = cauchyStep[i] + tau * ( newtonStep[i] - cauchyStep[i] );
+        }
+      }
+
+      // decrease of || W r ||^2 predicted by the linear model
+      double modelNorm2 = 0.0;
+      for( int i = 0; i < N; ++i )
+      {
+        double modelResidual = residual[i];
+        for( int j = 0; j < N; ++j )
+        {
+          modelResidual += jacobian[i][j] * step[j];
+        }
+        modelResidual *= controls.residualWeights[i];
+        modelNorm2 += modelResidual * modelResidual;
+      }
+      double const predictedDecrease = residualNorm2 - modelNorm2;
+
+      for( int i = 0; i < N; ++i )
+      {
+        x[i] = x0[i] + step[i];
+      }
+      computeResidual( x, trialResidual );
+      ++stats.numResidualEvaluations;
+      double const trialNorm = controls.residualNorm( trialResidual );
+      double const actualDecrease = residualNorm2 - trialNorm * trialNorm;
+      double const ratio = predictedDecrease > 0.0 ? actualDecrease / predictedDecrease : -1.0;
+
+      double const stepNorm = ::sqrt( squaredNorm( step ) );
+      if( ratio < 0.25 )
+      {
+        radius = 0.25 * stepNorm;
+      }
+      else if( ratio > 0.75 && stepNorm >= 0.99 * radius )
+      {
+        radius = 2.0 * radius < trustRegion.maxRadius ? 2.0 * radius : trustRegion.maxRadius;
+      }
+
+      if( ratio > trustRegion.acceptanceRatio )
+      {
+        isAccepted = true;
+        norm = trialNorm;
+        break;
+      }
+      ++stats.numBacktracks;
+      if( rejection + 1 >= trustRegion.maxRejections )
+      {
+        break;
+      }
+    }
+
+    // the trust region collapsed without a decrease: stop at the last accepted iterate
+    if( !isAccepted )
+    {
+      for( int i = 0; i < N; ++i )
+      {
+        x[i] = x0[i];
+      }
+      break;
+    }
+
+    for( int i = 0; i < N; ++i )
+    {
+      residual[i] = trialResidual[i];
+    }
+    isUpdateConverged = controls.isUpdateConverged( step, 1.0 );
+    ++stats.numIterations;
+  }
+
+  LOGGING_POLICY::result( stats );
+
+  return stats;
 }
 
 }
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "macros.hpp"
+
 /**
  * @file
  * @brief This file contains the definition of a symmetric matrix.
@@ -43,7 +45,7 @@ struct symmetricMatrix
    * @brief the storage size of the matrix
    * @return the storage size of the matrix
    */
-  static constexpr INDEX_TYPE size() { return ( N*(N+1) ) / 2; }
+  HPCREACT_HOST_DEVICE static constexpr INDEX_TYPE size() { return ( N*(N+1) ) / 2; }
 
   /**
    * @brief calculates the linear index of the element at (i,j)
@@ -51,7 +53,7 @@ struct symmetricMatrix
    * @param j the column index
    * @return the linear index of the element at (i,j)
    */
-  static inline INDEX_TYPE linearIndex( INDEX_TYPE const i, INDEX_TYPE const j )
+  HPCREACT_HOST_DEVICE static inline INDEX_TYPE linearIndex( INDEX_TYPE const i, INDEX_TYPE const j )
   {
     return (( i*(i+1) ) >> 1) + j;
   }
@@ -62,7 +64,7 @@ struct symmetricMatrix
    * @param j the column index
    * @return reference to the element at (i,j)
    */
-  inline T & operator()( INDEX_TYPE const i, INDEX_TYPE const j )
+  HPCREACT_HOST_DEVICE inline T & operator()( INDEX_TYPE const i, INDEX_TYPE const j )
   {
     return m_data[linearIndex( i, j )];
   }
@@ -73,7 +75,7 @@ struct symmetricMatrix
    * @param j the column index
    * @return reference to the element at (i,j)
    */
-  inline T const & operator()( INDEX_TYPE const i, INDEX_TYPE const j ) const
+  HPCREACT_HOST_DEVICE inline T const & operator()( INDEX_TYPE const i, INDEX_TYPE const j ) const
   {
     return m_data[linearIndex( i, j )];
   }
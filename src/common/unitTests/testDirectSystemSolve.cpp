@@ -11,6 +11,7 @@
 
 
 #include "../DirectSystemSolve.hpp"
+#include "../SparseDirectSystemSolve.hpp"
 #include "common/pmpl.hpp"
 
 #include <gtest/gtest.h>
@@ -56,6 +57,463 @@ TEST( testDirectSystemSolve, test3x3 )
   test3x3_helper();
 }
 
+void testFactorSolve_helper()
+{
+  LinearSystem< double, 3 > linearSystem
+  {
+    { { 1.0, 2.0, 3.0 },
+      { 2.0, -1.0, 1.0 },
+      { 3.0, 4.0, 5.0 }
+    },
+    { 14.0, 3.0, 24.0 }, // Right-hand side
+    { 0.0, 0.0, 0.0 } // Solution
+  };
+
+  pmpl::genericKernelWrapper( 1, &linearSystem, [] HPCREACT_DEVICE ( auto * const copyOfLinearSystem )
+  {
+    LUFactorization< double, 3 > factor;
+    factorNxN_LU( copyOfLinearSystem->A, factor );
+
+    // reuse the factors for a second right hand side, A * (1,1,1)
+    double const b2[3] = { 6.0, 2.0, 12.0 };
+    double x2[3];
+    solveNxN_LU( factor, b2, x2 );
+
+    solveNxN_LU( factor, copyOfLinearSystem->b, copyOfLinearSystem->x );
+    for( int i = 0; i < 3; ++i )
+    {
+      copyOfLinearSystem->x[i] += x2[i];
+    }
+  } );
+
+  EXPECT_NEAR( linearSystem.x[0], 1.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( linearSystem.x[1], 2.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( linearSystem.x[2], 5.0, std::numeric_limits< double >::epsilon()*100 );
+}
+
+TEST( testDirectSystemSolve, testFactorSolve )
+{
+  testFactorSolve_helper();
+}
+
+void testCholesky_helper()
+{
+  // SPD matrix with solution (1,2,3)
+  LinearSystem< double, 3 > linearSystem
+  {
+    { { 4.0, 2.0, 0.0 },
+      { 2.0, 5.0, 1.0 },
+      { 0.0, 1.0, 3.0 }
+    },
+    { 8.0, 15.0, 11.0 },
+    { 0.0, 0.0, 0.0 }
+  };
+
+  pmpl::genericKernelWrapper( 1, &linearSystem, [] HPCREACT_DEVICE ( auto * const copyOfLinearSystem )
+  {
+    symmetricMatrix< double, int, 3 > A;
+    for( int i = 0; i < 3; ++i )
+    {
+      for( int j = 0; j <= i; ++j )
+      {
+        A( i, j ) = copyOfLinearSystem->A[i][j];
+      }
+    }
+
+    CholeskyFactorization< double, 3 > denseFactor;
+    CholeskyFactorization< double, 3 > packedFactor;
+    bool const isDenseSPD = factorNxN_Cholesky< double, 3 >( copyOfLinearSystem->A, denseFactor );
+    bool const isPackedSPD = factorNxN_Cholesky< double, 3 >( A, packedFactor );
+
+    double xDense[3];
+    solveNxN_Cholesky( denseFactor, copyOfLinearSystem->b, xDense );
+    solveNxN_Cholesky< double, 3 >( A, copyOfLinearSystem->b, copyOfLinearSystem->x );
+    for( int i = 0; i < 3; ++i )
+    {
+      // flag a failure by poisoning the solution
+      copyOfLinearSystem->x[i] += ( isDenseSPD && isPackedSPD ) ? xDense[i] : 1.0e10;
+    }
+  } );
+
+  EXPECT_NEAR( linearSystem.x[0], 2.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( linearSystem.x[1], 4.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( linearSystem.x[2], 6.0, std::numeric_limits< double >::epsilon()*100 );
+}
+
+TEST( testDirectSystemSolve, testCholesky )
+{
+  testCholesky_helper();
+}
+
+struct MixedPrecisionData
+{
+  LinearSystem< double, 3 > system;
+  LinearSystem< double, 3 > badlyScaledSystem;
+  LinearSolverStats stats;
+  LinearSolverStats badlyScaledStats;
+};
+
+void testMixedPrecision_helper()
+{
+  MixedPrecisionData data
+  {
+    {
+      { { 1.0, 2.0, 3.0 },
+        { 2.0, -1.0, 1.0 },
+        { 3.0, 4.0, 5.0 }
+      },
+      { 14.0, 3.0, 24.0 },
+      { 0.0, 0.0, 0.0 }
+    },
+    // the first row overflows single precision
+    {
+      { { 1.0e40, 0.0, 0.0 },
+        { 2.0, -1.0, 1.0 },
+        { 3.0, 4.0, 5.0 }
+      },
+      { 0.0, 3.0, 24.0 },
+      { 0.0, 0.0, 0.0 }
+    },
+    {},
+    {}
+  };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    MixedPrecisionLUSolver<> const solver;
+    solver.solve( copyOfData->system.A, copyOfData->system.b, copyOfData->system.x, copyOfData->stats );
+    solver.solve( copyOfData->badlyScaledSystem.A, copyOfData->badlyScaledSystem.b, copyOfData->badlyScaledSystem.x, copyOfData->badlyScaledStats );
+  } );
+
+  // refinement recovers double precision accuracy
+  EXPECT_NEAR( data.system.x[0], 0.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( data.system.x[1], 1.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( data.system.x[2], 4.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_GT( data.stats.numRefinements, 0 );
+  EXPECT_EQ( data.stats.numFallbacks, 0 );
+
+  EXPECT_NEAR( data.badlyScaledSystem.x[0], 0.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( data.badlyScaledSystem.x[1], 1.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( data.badlyScaledSystem.x[2], 4.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_EQ( data.badlyScaledStats.numFallbacks, 1 );
+}
+
+TEST( testDirectSystemSolve, testMixedPrecision )
+{
+  testMixedPrecision_helper();
+}
+
+struct ScaledCholeskyData
+{
+  LinearSystem< double, 3 > system;
+  LinearSystem< double, 3 > indefiniteSystem;
+  LinearSolverStats stats;
+  LinearSolverStats indefiniteStats;
+  double packedX[3];
+  double packedIndefiniteX[3];
+  LinearSolverStats packedStats;
+  LinearSolverStats packedIndefiniteStats;
+};
+
+void testScaledCholesky_helper()
+{
+  ScaledCholeskyData data
+  {
+    // SPD matrix with a diagonal spread over 12 decades, solution (1,2,3)
+    {
+      { { 4.0e6, 2.0, 0.0 },
+        { 2.0, 5.0, 1.0e-3 },
+        { 0.0, 1.0e-3, 3.0e-6 }
+      },
+      { 4.000004e6, 12.003, 2.009e-3 },
+      { 0.0, 0.0, 0.0 }
+    },
+    // symmetric indefinite matrix with solution (1,2,3)
+    {
+      { { 1.0, 2.0, 0.0 },
+        { 2.0, 1.0, 1.0 },
+        { 0.0, 1.0, 3.0 }
+      },
+      { 5.0, 7.0, 11.0 },
+      { 0.0, 0.0, 0.0 }
+    },
+    {},
+    {},
+    { 0.0, 0.0, 0.0 },
+    { 0.0, 0.0, 0.0 },
+    {},
+    {}
+  };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    ScaledCholeskySolver const solver;
+    solver.solve( copyOfData->system.A, copyOfData->system.b, copyOfData->system.x, copyOfData->stats );
+    solver.solve( copyOfData->indefiniteSystem.A, copyOfData->indefiniteSystem.b, copyOfData->indefiniteSystem.x, copyOfData->indefiniteStats );
+
+    // the same systems in packed symmetric storage
+    symmetricMatrix< double, int, 3 > packedA;
+    symmetricMatrix< double, int, 3 > packedIndefiniteA;
+    for( int i = 0; i < 3; ++i )
+    {
+      for( int j = 0; j <= i; ++j )
+      {
+        packedA( i, j ) = copyOfData->system.A[i][j];
+        packedIndefiniteA( i, j ) = copyOfData->indefiniteSystem.A[i][j];
+      }
+    }
+    solver.solve( packedA, copyOfData->system.b, copyOfData->packedX, copyOfData->packedStats );
+    solver.solve( packedIndefiniteA, copyOfData->indefiniteSystem.b, copyOfData->packedIndefiniteX, copyOfData->packedIndefiniteStats );
+  } );
+
+  EXPECT_NEAR( data.system.x[0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.system.x[1], 2.0, 1.0e-12 );
+  EXPECT_NEAR( data.system.x[2], 3.0, 1.0e-12 );
+  EXPECT_EQ( data.stats.numFallbacks, 0 );
+
+  // the Cholesky factorization fails and the pivoted LU solves the system
+  EXPECT_NEAR( data.indefiniteSystem.x[0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.indefiniteSystem.x[1], 2.0, 1.0e-12 );
+  EXPECT_NEAR( data.indefiniteSystem.x[2], 3.0, 1.0e-12 );
+  EXPECT_EQ( data.indefiniteStats.numFallbacks, 1 );
+
+  for( int i = 0; i < 3; ++i )
+  {
+    EXPECT_NEAR( data.packedX[i], data.system.x[i], 1.0e-12 );
+    EXPECT_NEAR( data.packedIndefiniteX[i], data.indefiniteSystem.x[i], 1.0e-12 );
+  }
+  EXPECT_EQ( data.packedStats.numFallbacks, 0 );
+  EXPECT_EQ( data.packedIndefiniteStats.numFallbacks, 1 );
+}
+
+TEST( testDirectSystemSolve, testScaledCholesky )
+{
+  testScaledCholesky_helper();
+}
+
+void testEquilibrated_helper()
+{
+  // the 3x3 system above with its rows and columns scaled over 60 decades
+  LinearSystem< double, 3 > linearSystem
+  {
+    { { 1.0e30, 2.0e10, 3.0e20 },
+      { 2.0e-30, -1.0e-50, 1.0e-40 },
+      { 3.0, 4.0e-20, 5.0e-10 }
+    },
+    { 1.4e31, 3.0e-30, 24.0 },
+    { 0.0, 0.0, 0.0 }
+  };
+
+  pmpl::genericKernelWrapper( 1, &linearSystem, [] HPCREACT_DEVICE ( auto * const copyOfLinearSystem )
+  {
+    LinearSolverStats stats;
+    EquilibratedSolver<>{}.solve( copyOfLinearSystem->A, copyOfLinearSystem->b, copyOfLinearSystem->x, stats );
+  } );
+
+  // x = C^-1 (0,1,4) with C = diag( 1, 1e-20, 1e-10 )
+  EXPECT_NEAR( linearSystem.x[0], 0.0, 1.0e-14 );
+  EXPECT_NEAR( linearSystem.x[1], 1.0e20, 1.0e20 * 1.0e-14 );
+  EXPECT_NEAR( linearSystem.x[2], 4.0e10, 4.0e10 * 1.0e-14 );
+}
+
+TEST( testDirectSystemSolve, testEquilibrated )
+{
+  testEquilibrated_helper();
+}
+
+// Arrow matrix with a dense first row/column. Eliminating in the natural order
+// fills the whole matrix, the minimum degree order produces no fill.
+constexpr CArrayWrapper< bool, 5, 5 > arrowPattern = { { true, true, true, true, true },
+                                                        { true, true, false, false, false },
+                                                        { true, false, true, false, false },
+                                                        { true, false, false, true, false },
+                                                        { true, false, false, false, true } };
+
+void testSparseLU_helper()
+{
+  static constexpr SparseLUSymbolic< 5 > symbolic( arrowPattern );
+  static_assert( symbolic.numFactorNonzeros() == 13, "minimum degree ordering should not produce fill" );
+  static_assert( symbolic.m_order( 0 ) != 0, "the dense node should not be eliminated first" );
+
+  LinearSystem< double, 5 > linearSystem
+  {
+    { { 10.0, 1.0, 2.0, 3.0, 4.0 },
+      { 1.0, 5.0, 0.0, 0.0, 0.0 },
+      { 2.0, 0.0, 6.0, 0.0, 0.0 },
+      { 3.0, 0.0, 0.0, 7.0, 0.0 },
+      { 4.0, 0.0, 0.0, 0.0, 8.0 }
+    },
+    { 50.0, 11.0, 20.0, 31.0, 44.0 }, // A * (1,2,3,4,5)
+    { 0.0, 0.0, 0.0, 0.0, 0.0 }
+  };
+
+  pmpl::genericKernelWrapper( 1, &linearSystem, [] HPCREACT_DEVICE ( auto * const copyOfLinearSystem )
+  {
+    solveNxN_sparse( symbolic, copyOfLinearSystem->A, copyOfLinearSystem->b, copyOfLinearSystem->x );
+  } );
+
+  for( int i = 0; i < 5; ++i )
+  {
+    EXPECT_NEAR( linearSystem.x[i], i + 1.0, std::numeric_limits< double >::epsilon()*100 );
+  }
+}
+
+TEST( testDirectSystemSolve, testSparseLU )
+{
+  testSparseLU_helper();
+}
+
+void testSparseLUFallback_helper()
+{
+  // the fixed pivot sequence hits a zero diagonal, so the solve falls back to pivoted LU
+  static constexpr SparseLUSymbolic< 3 > symbolic( CArrayWrapper< bool, 3, 3 >{ { true, true, true },
+                                                                                { true, true, true },
+                                                                                { true, true, true } } );
+
+  LinearSystem< double, 3 > linearSystem
+  {
+    { { 0.0, 1.0, 0.0 },
+      { 1.0, 0.0, 0.0 },
+      { 0.0, 0.0, 2.0 }
+    },
+    { 2.0, 1.0, 6.0 },
+    { 0.0, 0.0, 0.0 }
+  };
+
+  pmpl::genericKernelWrapper( 1, &linearSystem, [] HPCREACT_DEVICE ( auto * const copyOfLinearSystem )
+  {
+    solveNxN_sparse( symbolic, copyOfLinearSystem->A, copyOfLinearSystem->b, copyOfLinearSystem->x );
+  } );
+
+  EXPECT_NEAR( linearSystem.x[0], 1.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( linearSystem.x[1], 2.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( linearSystem.x[2], 3.0, std::numeric_limits< double >::epsilon()*100 );
+}
+
+TEST( testDirectSystemSolve, testSparseLUFallback )
+{
+  testSparseLUFallback_helper();
+}
+
+void testSparseLUThreshold_helper()
+{
+  struct SparseLUThresholdData
+  {
+    LinearSystem< double, 2 > linearSystem;
+    bool isSparseFactorAccepted;
+  };
+
+  // the first pivot is tiny but nonzero: without row exchanges the multiplier
+  // would be 1e10, so the threshold test rejects it
+  static constexpr SparseLUSymbolic< 2 > symbolic( CArrayWrapper< bool, 2, 2 >{ { true, true },
+                                                                                { true, true } } );
+  static_assert( symbolic.m_order( 0 ) == 0, "the tiny pivot should be eliminated first" );
+
+  SparseLUThresholdData data
+  {
+    {
+      { { 1.0e-10, 1.0 },
+        { 1.0, 1.0 }
+      },
+      { 2.0 + 1.0e-10, 3.0 }, // A * (1,2)
+      { 0.0, 0.0 }
+    },
+    true
+  };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    copyOfData->isSparseFactorAccepted = solveNxN_sparse( symbolic,
+                                                          copyOfData->linearSystem.A,
+                                                          copyOfData->linearSystem.b,
+                                                          copyOfData->linearSystem.x );
+  } );
+
+  EXPECT_FALSE( data.isSparseFactorAccepted );
+  EXPECT_NEAR( data.linearSystem.x[0], 1.0, std::numeric_limits< double >::epsilon()*100 );
+  EXPECT_NEAR( data.linearSystem.x[1], 2.0, std::numeric_limits< double >::epsilon()*100 );
+}
+
+TEST( testDirectSystemSolve, testSparseLUThreshold )
+{
+  testSparseLUThreshold_helper();
+}
+
+void testPivotHint_helper()
+{
+  struct PivotHintData
+  {
+    // A[0][0] = 0, so the identity hint must be rejected at the first step
+    double A[3][3];
+    double b[3];
+    double x[3];
+    double xPolicy[3];
+    int pivotHint[3];
+    int policyPivotHint[3];
+    int numRejections[2];
+  };
+
+  PivotHintData data
+  {
+    { { 0.0, 2.0, 3.0 },
+      { 2.0, -1.0, 1.0 },
+      { 3.0, 4.0, 5.0 }
+    },
+    { 5.0, 2.0, 12.0 },
+    { 0.0, 0.0, 0.0 },
+    { 0.0, 0.0, 0.0 },
+    { 0, 1, 2 },
+    { 0, 1, 2 },
+    { 0, 0 }
+  };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copy )
+  {
+    solveNxN_pivoted< double, 3 >( copy->A, copy->b, copy->x, copy->pivotHint );
+
+    // the first solve rejects the identity hint, the second one follows the updated hint
+    HintedPivotedLUSolver< 3 > const solver( copy->policyPivotHint );
+    LinearSolverStats stats;
+    solver.solve( copy->A, copy->b, copy->xPolicy, stats );
+    copy->numRejections[0] = stats.numPivotHintRejections;
+    solver.solve( copy->A, copy->b, copy->xPolicy, stats );
+    copy->numRejections[1] = stats.numPivotHintRejections;
+  } );
+
+  for( int i = 0; i < 3; ++i )
+  {
+    EXPECT_NEAR( data.x[i], 1.0, 1.0e-14 );
+    EXPECT_NEAR( data.xPolicy[i], 1.0, 1.0e-14 );
+  }
+  EXPECT_NE( data.pivotHint[0], 0 );
+  for( int i = 0; i < 3; ++i )
+  {
+    EXPECT_EQ( data.policyPivotHint[i], data.pivotHint[i] );
+  }
+  EXPECT_EQ( data.numRejections[0], 1 );
+  EXPECT_EQ( data.numRejections[1], 1 );
+
+  // with a unit threshold the hinted factorization is partial pivoting
+  LUFactorization< double, 3 > reference;
+  LUFactorization< double, 3 > hinted;
+  int const identity[3] = { 0, 1, 2 };
+  factorNxN_LU( data.A, reference );
+  factorNxN_LU( data.A, hinted, identity, 1.0 );
+  for( int i = 0; i < 3; ++i )
+  {
+    EXPECT_EQ( hinted.pivot[i], reference.pivot[i] );
+    for( int j = 0; j < 3; ++j )
+    {
+      EXPECT_DOUBLE_EQ( hinted.LU[i][j], reference.LU[i][j] );
+    }
+  }
+}
+
+TEST( testDirectSystemSolve, testPivotHint )
+{
+  testPivotHint_helper();
+}
+
 
 int main( int argc, char * * argv )
 {
@@ -0,0 +1,60 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+
+#include "../DualNumber.hpp"
+#include "common/pmpl.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace hpcReact;
+
+struct DualNumberTestData
+{
+  double x[2] = { 0.7, 1.3 };
+  double value = 0.0;
+  double derivatives[2] = { 0.0, 0.0 };
+};
+
+TEST( testDualNumber, testChainRule )
+{
+  DualNumberTestData data;
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const dataCopy )
+  {
+    DualNumber< double, 2 > x[2];
+    dualNumbers::makeIndependentVariables( dataCopy->x, x );
+
+    // f = exp( x0 * x1 ) / x1 + log( x0 ) * sqrt( x1 ) - pow( x0, 2.5 ) + 3 * fabs( -x0 ) - pow( x0, x1 )
+    DualNumber< double, 2 > const f = exp( x[0] * x[1] ) / x[1] + log( x[0] ) * sqrt( x[1] ) - pow( x[0], 2.5 ) + 3 * fabs( -x[0] ) - pow( x[0], x[1] );
+
+    dataCopy->value = f.value;
+    dataCopy->derivatives[0] = f.derivatives[0];
+    dataCopy->derivatives[1] = f.derivatives[1];
+  } );
+
+  double const x0 = data.x[0];
+  double const x1 = data.x[1];
+  double const expectedValue = exp( x0 * x1 ) / x1 + log( x0 ) * sqrt( x1 ) - pow( x0, 2.5 ) + 3 * x0 - pow( x0, x1 );
+  double const expectedDerivative0 = exp( x0 * x1 ) + sqrt( x1 ) / x0 - 2.5 * pow( x0, 1.5 ) + 3 - x1 * pow( x0, x1 - 1 );
+  double const expectedDerivative1 = exp( x0 * x1 ) * ( x0 / x1 - 1 / ( x1 * x1 ) ) + log( x0 ) * 0.5 / sqrt( x1 ) - pow( x0, x1 ) * log( x0 );
+
+  EXPECT_NEAR( data.value, expectedValue, 1.0e-14 * fabs( expectedValue ) );
+  EXPECT_NEAR( data.derivatives[0], expectedDerivative0, 1.0e-14 * fabs( expectedDerivative0 ) );
+  EXPECT_NEAR( data.derivatives[1], expectedDerivative1, 1.0e-14 * fabs( expectedDerivative1 ) );
+}
+
+int main( int argc, char * * argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  int const result = RUN_ALL_TESTS();
+  return result;
+}
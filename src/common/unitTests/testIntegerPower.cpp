@@ -0,0 +1,66 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+
+#include "../integerPower.hpp"
+#include "../DualNumber.hpp"
+#include "common/pmpl.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace hpcReact;
+
+struct IntegerPowerTestData
+{
+  static constexpr int numExponents = 15;
+  double x = 1.7;
+  double values[numExponents] = { 0.0 };
+  double fractionalValue = 0.0;
+  double dualValue = 0.0;
+  double dualDerivative = 0.0;
+};
+
+TEST( testIntegerPower, testExponents )
+{
+  IntegerPowerTestData data;
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const dataCopy )
+  {
+    // exponents -7..7, the same range as signed char stoichiometric coefficients in practice
+    for( int n = -7; n <= 7; ++n )
+    {
+      dataCopy->values[n+7] = stoichiometricPower( dataCopy->x, static_cast< signed char >( n ) );
+    }
+    dataCopy->fractionalValue = stoichiometricPower( dataCopy->x, 0.5 );
+
+    DualNumber< double, 1 > x = dataCopy->x;
+    x.derivatives[0] = 1.0;
+    DualNumber< double, 1 > const x5 = integerPower( x, 5 );
+    dataCopy->dualValue = x5.value;
+    dataCopy->dualDerivative = x5.derivatives[0];
+  } );
+
+  for( int n = -7; n <= 7; ++n )
+  {
+    double const expected = pow( data.x, n );
+    EXPECT_NEAR( data.values[n+7], expected, 1.0e-15 * expected );
+  }
+  EXPECT_NEAR( data.fractionalValue, sqrt( data.x ), 1.0e-15 );
+  EXPECT_NEAR( data.dualValue, pow( data.x, 5 ), 1.0e-14 );
+  EXPECT_NEAR( data.dualDerivative, 5 * pow( data.x, 4 ), 1.0e-14 );
+}
+
+int main( int argc, char * * argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  int const result = RUN_ALL_TESTS();
+  return result;
+}
@@ -0,0 +1,124 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+
+#include "../LapackSystemSolve.hpp"
+#include "../nonlinearSolvers.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace hpcReact;
+
+// The LAPACK backend is host only, so these tests do not go through pmpl.
+
+// fill a diagonally dominant, nonsymmetric n x n system with solution x_i = i+1
+void fillSystem( int const n, double const shift, double * const A, double * const b )
+{
+  for( int i = 0; i < n; ++i )
+  {
+    for( int j = 0; j < n; ++j )
+    {
+      A[i*n+j] = i == j ? 2.0 * n + shift : 1.0 / ( 1.0 + i + 2.0 * j );
+    }
+  }
+  for( int i = 0; i < n; ++i )
+  {
+    b[i] = 0.0;
+    for( int j = 0; j < n; ++j )
+    {
+      b[i] += A[i*n+j] * ( j + 1 );
+    }
+  }
+}
+
+TEST( testLapackSystemSolve, testRuntimeSized )
+{
+  int const n = 40;
+  std::vector< double > A( n * n );
+  std::vector< double > b( n );
+  std::vector< double > x( n );
+  fillSystem( n, 0.0, A.data(), b.data() );
+
+  LapackLUFactorization factor;
+  EXPECT_TRUE( factorNxN_lapackLU( n, A.data(), factor ) );
+  solveNxN_lapackLU( factor, b.data(), x.data() );
+
+  for( int i = 0; i < n; ++i )
+  {
+    EXPECT_NEAR( x[i], i + 1.0, 1.0e-12 * ( i + 1.0 ) );
+  }
+
+  double const singular[4] = { 1.0, 2.0, 2.0, 4.0 };
+  EXPECT_FALSE( factorNxN_lapackLU( 2, singular, factor ) );
+}
+
+TEST( testLapackSystemSolve, testBatched )
+{
+  int const n = 35;
+  int const numSystems = 4;
+  std::vector< double > A( numSystems * n * n );
+  std::vector< double > b( numSystems * n );
+  for( int s = 0; s < numSystems; ++s )
+  {
+    fillSystem( n, s, A.data() + s * n * n, b.data() + s * n );
+  }
+
+  EXPECT_TRUE( solveNxN_lapackLU_batched( n, numSystems, A.data(), b.data() ) );
+
+  for( int s = 0; s < numSystems; ++s )
+  {
+    for( int i = 0; i < n; ++i )
+    {
+      EXPECT_NEAR( b[s*n+i], i + 1.0, 1.0e-12 * ( i + 1.0 ) );
+    }
+  }
+}
+
+TEST( testLapackSystemSolve, testPolicy )
+{
+  // the nonsymmetric 3x3 system of testDirectSystemSolve
+  double const A[3][3] = { { 1.0, 2.0, 3.0 },
+    { 2.0, -1.0, 1.0 },
+    { 3.0, 4.0, 5.0 } };
+  double const b[3] = { 14.0, 3.0, 24.0 };
+  double x[3] = { 0.0, 0.0, 0.0 };
+
+  LinearSolverStats stats;
+  LapackLUSolver{}.solve( A, b, x, stats );
+
+  EXPECT_NEAR( x[0], 0.0, 1.0e-12 );
+  EXPECT_NEAR( x[1], 1.0, 1.0e-12 );
+  EXPECT_NEAR( x[2], 4.0, 1.0e-12 );
+
+  // the same policy drives the Newton solver:
+  // x0^2 + x1 = 3, x0 + x1^2 = 5, with root (1,2)
+  double solution[2] = { 1.5, 1.5 };
+  auto computeResidualAndJacobian = []( double const (&xn)[2], double (& r)[2], double (& J)[2][2] )
+  {
+    r[0] = xn[0] * xn[0] + xn[1] - 3.0;
+    r[1] = xn[0] + xn[1] * xn[1] - 5.0;
+    J[0][0] = 2.0 * xn[0];
+    J[0][1] = 1.0;
+    J[1][0] = 1.0;
+    J[1][1] = 2.0 * xn[1];
+  };
+
+  EXPECT_TRUE( nonlinearSolvers::newtonRaphson< 2 >( solution, computeResidualAndJacobian, 12, 1.0e-12, LapackLUSolver{} ).isConverged );
+  EXPECT_NEAR( solution[0], 1.0, 1.0e-10 );
+  EXPECT_NEAR( solution[1], 2.0, 1.0e-10 );
+}
+
+int main( int argc, char * * argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  int const result = RUN_ALL_TESTS();
+  return result;
+}
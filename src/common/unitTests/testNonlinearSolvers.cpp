@@ -0,0 +1,466 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+
+#include "../nonlinearSolvers.hpp"
+#include "common/pmpl.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace hpcReact;
+using namespace hpcReact::nonlinearSolvers;
+
+/**
+ * Residual and Jacobian of
+ *   x0^2 + x1   - 3 = 0
+ *   x0   + x1^2 - 5 = 0
+ * which has a root at (1,2).
+ */
+struct TwoByTwoSystem
+{
+  HPCREACT_HOST_DEVICE
+  void operator()( double const (&x)[2], double (& r)[2], double (& J)[2][2] ) const
+  {
+    r[0] = x[0] * x[0] + x[1] - 3.0;
+    r[1] = x[0] + x[1] * x[1] - 5.0;
+    J[0][0] = 2.0 * x[0];
+    J[0][1] = 1.0;
+    J[1][0] = 1.0;
+    J[1][1] = 2.0 * x[1];
+  }
+};
+
+struct ChordData
+{
+  double x[2];
+  double xRestart[2];
+  bool isConverged;
+  bool isConvergedRestart;
+  int numFactorizations;
+  int numFactorizationsRestart;
+  int numJacobianEvaluations;
+  int numResidualEvaluations;
+};
+
+void testChord_helper()
+{
+  ChordData data{ { 1.2, 1.8 }, { 1.01, 1.99 }, false, false, 0, 0, 0, 0 };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    int numJacobianEvaluations = 0;
+    auto computeResidual = [] ( double const (&x)[2], double (& r)[2] )
+    {
+      double J[2][2];
+      TwoByTwoSystem{}( x, r, J );
+    };
+    auto computeResidualAndJacobian = [&] ( double const (&x)[2], double (& r)[2], double (& J)[2][2] )
+    {
+      ++numJacobianEvaluations;
+      TwoByTwoSystem{}( x, r, J );
+    };
+
+    ChordState< double, 2 > state;
+    SolverStats const stats = newtonRaphsonChord< 2 >( copyOfData->x, computeResidual, computeResidualAndJacobian, state, 50, 1.0e-12 );
+    copyOfData->isConverged = stats.isConverged;
+    copyOfData->numFactorizations = state.numFactorizations;
+    copyOfData->numResidualEvaluations = stats.numResidualEvaluations;
+
+    // a nearby problem reuses the factorization of the previous solve
+    copyOfData->isConvergedRestart = newtonRaphsonChord< 2 >( copyOfData->xRestart, computeResidual, computeResidualAndJacobian, state, 50, 1.0e-12 ).isConverged;
+    copyOfData->numFactorizationsRestart = state.numFactorizations - copyOfData->numFactorizations;
+    copyOfData->numJacobianEvaluations = numJacobianEvaluations;
+  } );
+
+  EXPECT_TRUE( data.isConverged );
+  EXPECT_NEAR( data.x[0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.x[1], 2.0, 1.0e-12 );
+  EXPECT_GE( data.numFactorizations, 1 );
+  // the jacobian is only assembled when the factors are refreshed
+  EXPECT_EQ( data.numJacobianEvaluations, data.numFactorizations + data.numFactorizationsRestart );
+  EXPECT_GT( data.numResidualEvaluations, data.numFactorizations );
+
+  EXPECT_TRUE( data.isConvergedRestart );
+  EXPECT_NEAR( data.xRestart[0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.xRestart[1], 2.0, 1.0e-12 );
+  EXPECT_EQ( data.numFactorizationsRestart, 0 );
+}
+
+TEST( testNonlinearSolvers, testChord )
+{
+  testChord_helper();
+}
+
+struct MixedPrecisionNewtonData
+{
+  double x[2];
+  SolverStats stats;
+};
+
+void testMixedPrecisionNewton_helper()
+{
+  MixedPrecisionNewtonData data{ { 1.2, 1.8 }, {} };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    copyOfData->stats = newtonRaphson< 2 >( copyOfData->x, TwoByTwoSystem{}, 12, 1.0e-12, MixedPrecisionLUSolver<>{} );
+  } );
+
+  EXPECT_TRUE( data.stats.isConverged );
+  EXPECT_NEAR( data.x[0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.x[1], 2.0, 1.0e-12 );
+  EXPECT_GT( data.stats.linearSolverStats.numRefinements, 0 );
+  EXPECT_EQ( data.stats.linearSolverStats.numFallbacks, 0 );
+
+  EXPECT_GT( data.stats.numIterations, 0 );
+  EXPECT_EQ( data.stats.numLinearSolves, data.stats.numIterations );
+  EXPECT_EQ( data.stats.numResidualEvaluations, data.stats.numIterations + 1 );
+  EXPECT_LT( data.stats.finalResidualNorm, 1.0e-12 );
+  EXPECT_GT( data.stats.initialResidualNorm, data.stats.finalResidualNorm );
+}
+
+TEST( testNonlinearSolvers, testMixedPrecisionNewton )
+{
+  testMixedPrecisionNewton_helper();
+}
+
+// atan( x ) = 0, for which the full Newton step diverges when |x0| > 1.39
+struct ArctanSystem
+{
+  HPCREACT_HOST_DEVICE
+  void operator()( double const (&x)[1], double (& r)[1], double (& J)[1][1] ) const
+  {
+    r[0] = atan( x[0] );
+    J[0][0] = 1.0 / ( 1.0 + x[0] * x[0] );
+  }
+};
+
+struct LineSearchData
+{
+  double xFull[1];
+  double xLineSearch[1];
+  SolverStats statsFull;
+  SolverStats statsLineSearch;
+  double stepLengths[2];
+};
+
+void testLineSearch_helper()
+{
+  LineSearchData data{ { 2.0 }, { 2.0 }, {}, {}, { 0.0, 0.0 } };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    copyOfData->statsFull = newtonRaphson< 1 >( copyOfData->xFull, ArctanSystem{}, 12, 1.0e-12 );
+    copyOfData->statsLineSearch = newtonRaphson< 1 >( copyOfData->xLineSearch, ArctanSystem{}, 12, 1.0e-12,
+                                                      PivotedLUSolver{}, BacktrackingLineSearch{} );
+
+    // step length control: |dx| <= 0.5, and positive x may move at most 90% of the way to 0
+    BacktrackingLineSearch lineSearch;
+    lineSearch.maxUpdate = 0.5;
+    lineSearch.fractionToBoundary = 0.9;
+    double const x[2] = { 1.0, 10.0 };
+    double const dxLarge[2] = { 0.1, -2.0 };
+    double const xSmall[2] = { 0.2, 10.0 };
+    double const dxNegative[2] = { -0.4, 0.0 };
+    copyOfData->stepLengths[0] = lineSearch.maxStepLength( x, dxLarge );
+    copyOfData->stepLengths[1] = lineSearch.maxStepLength( xSmall, dxNegative );
+  } );
+
+  EXPECT_FALSE( data.statsFull.isConverged );
+
+  EXPECT_TRUE( data.statsLineSearch.isConverged );
+  EXPECT_NEAR( data.xLineSearch[0], 0.0, 1.0e-12 );
+  EXPECT_GT( data.statsLineSearch.numBacktracks, 0 );
+  EXPECT_EQ( data.statsLineSearch.numResidualEvaluations,
+             data.statsLineSearch.numIterations + data.statsLineSearch.numBacktracks + 1 );
+
+  EXPECT_NEAR( data.stepLengths[0], 0.25, 1.0e-15 );
+  EXPECT_NEAR( data.stepLengths[1], 0.45, 1.0e-15 );
+}
+
+TEST( testNonlinearSolvers, testLineSearch )
+{
+  testLineSearch_helper();
+}
+
+struct SolverControlsData
+{
+  double x[4][2];
+  SolverStats stats[4];
+};
+
+void testSolverControls_helper()
+{
+  SolverControlsData data{ { { 1.2, 1.8 }, { 1.2, 1.8 }, { 1.2, 1.8 }, { 1.2, 1.8 } }, {} };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    // absolute tolerance only
+    copyOfData->stats[0] = newtonRaphson< 2 >( copyOfData->x[0], TwoByTwoSystem{}, SolverControls< 2 >( 12, 1.0e-12 ) );
+
+    // relative tolerance
+    copyOfData->stats[1] = newtonRaphson< 2 >( copyOfData->x[1], TwoByTwoSystem{}, SolverControls< 2 >( 12, 0.0, 1.0e-3 ) );
+
+    // update criterion, with a residual tolerance that cannot be met
+    copyOfData->stats[2] = newtonRaphson< 2 >( copyOfData->x[2], TwoByTwoSystem{}, SolverControls< 2 >( 12, 0.0, 0.0, 1.0e-8 ) );
+
+    // weighted residual norm and iteration limit
+    SolverControls< 2 > controls( 1, 1.0e-12 );
+    controls.residualWeights[0] = 2.0;
+    controls.residualWeights[1] = 2.0;
+    copyOfData->stats[3] = newtonRaphson< 2 >( copyOfData->x[3], TwoByTwoSystem{}, controls );
+  } );
+
+  EXPECT_TRUE( data.stats[0].isConverged );
+  EXPECT_LT( data.stats[0].finalResidualNorm, 1.0e-12 );
+
+  EXPECT_TRUE( data.stats[1].isConverged );
+  EXPECT_LT( data.stats[1].finalResidualNorm, 1.0e-3 * data.stats[1].initialResidualNorm );
+  EXPECT_LT( data.stats[1].numIterations, data.stats[0].numIterations );
+
+  EXPECT_TRUE( data.stats[2].isConverged );
+  EXPECT_LT( data.stats[2].numIterations, 12 );
+  EXPECT_NEAR( data.x[2][0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.x[2][1], 2.0, 1.0e-12 );
+
+  EXPECT_FALSE( data.stats[3].isConverged );
+  EXPECT_EQ( data.stats[3].numIterations, 1 );
+  EXPECT_NEAR( data.stats[3].initialResidualNorm, 2.0 * data.stats[0].initialResidualNorm, 1.0e-14 );
+}
+
+TEST( testNonlinearSolvers, testSolverControls )
+{
+  testSolverControls_helper();
+}
+
+struct BroydenData
+{
+  double x[2];
+  double xRestart[2];
+  SolverStats stats;
+  SolverStats statsRestart;
+  int numFactorizations;
+  int numFactorizationsRestart;
+};
+
+void testBroyden_helper()
+{
+  BroydenData data{ { 1.2, 1.8 }, { 1.01, 1.99 }, {}, {}, 0, 0 };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    auto computeResidual = [] ( double const (&x)[2], double (& r)[2] )
+    {
+      double J[2][2];
+      TwoByTwoSystem{}( x, r, J );
+    };
+
+    BroydenState< double, 2 > state;
+    copyOfData->stats = broyden< 2 >( copyOfData->x, computeResidual, TwoByTwoSystem{}, state, SolverControls< 2 >( 25, 1.0e-12 ) );
+    copyOfData->numFactorizations = state.numFactorizations;
+
+    // a nearby problem starts from the factors and updates of the previous solve
+    copyOfData->statsRestart = broyden< 2 >( copyOfData->xRestart, computeResidual, TwoByTwoSystem{}, state, SolverControls< 2 >( 25, 1.0e-12 ) );
+    copyOfData->numFactorizationsRestart = state.numFactorizations - copyOfData->numFactorizations;
+  } );
+
+  EXPECT_TRUE( data.stats.isConverged );
+  EXPECT_NEAR( data.x[0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.x[1], 2.0, 1.0e-12 );
+  EXPECT_GE( data.numFactorizations, 1 );
+  EXPECT_LT( data.numFactorizations, data.stats.numIterations );
+  EXPECT_EQ( data.stats.numResidualEvaluations, data.stats.numIterations + 1 );
+
+  EXPECT_TRUE( data.statsRestart.isConverged );
+  EXPECT_NEAR( data.xRestart[0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.xRestart[1], 2.0, 1.0e-12 );
+  EXPECT_LT( data.numFactorizationsRestart, data.statsRestart.numIterations );
+}
+
+TEST( testNonlinearSolvers, testBroyden )
+{
+  testBroyden_helper();
+}
+
+// fixed-point residual of x = cos( A x ) / 2, a contraction with a slowly converging plain iteration
+struct CosineFixedPoint
+{
+  HPCREACT_HOST_DEVICE
+  void operator()( double const (&x)[3], double (& f)[3] ) const
+  {
+    f[0] = 0.5 * cos( 1.0 * x[0] + 0.9 * x[1] ) - x[0];
+    f[1] = 0.5 * cos( 0.9 * x[0] + 1.0 * x[1] + 0.5 * x[2] ) - x[1];
+    f[2] = 0.5 * cos( 0.5 * x[1] + 1.0 * x[2] ) - x[2];
+  }
+};
+
+struct AndersonData
+{
+  double x[3];
+  double xPlain[3];
+  SolverStats stats;
+  int numPlainIterations;
+};
+
+void testAnderson_helper()
+{
+  AndersonData data{ { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, {}, 0 };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    copyOfData->stats = andersonAcceleration< 3, 3 >( copyOfData->x, CosineFixedPoint{}, SolverControls< 3 >( 50, 1.0e-12 ) );
+
+    // the plain fixed-point iteration for comparison
+    double f[3];
+    CosineFixedPoint{}( copyOfData->xPlain, f );
+    while( nonlinearSolvers::internal::norm< 3 >( f ) >= 1.0e-12 && copyOfData->numPlainIterations < 1000 )
+    {
+      nonlinearSolvers::internal::add< 3 >( copyOfData->xPlain, f );
+      CosineFixedPoint{}( copyOfData->xPlain, f );
+      ++copyOfData->numPlainIterations;
+    }
+  } );
+
+  EXPECT_TRUE( data.stats.isConverged );
+  EXPECT_LT( data.stats.finalResidualNorm, 1.0e-12 );
+  EXPECT_EQ( data.stats.numResidualEvaluations, data.stats.numIterations + 1 );
+  EXPECT_LT( data.stats.numIterations, data.numPlainIterations );
+  for( int i = 0; i < 3; ++i )
+  {
+    EXPECT_NEAR( data.x[i], data.xPlain[i], 1.0e-11 );
+  }
+}
+
+TEST( testNonlinearSolvers, testAnderson )
+{
+  testAnderson_helper();
+}
+
+// piecewise linear fixed-point residual with the root x = 1 in the flat piece x < 3. The
+// extrapolation from the steep piece overshoots, which restarts the acceleration.
+struct PiecewiseLinearFixedPoint
+{
+  int * numResidualIncreases;
+  double * previousNorm;
+
+  HPCREACT_HOST_DEVICE
+  void operator()( double const (&x)[1], double (& f)[1] ) const
+  {
+    f[0] = x[0] < 3.0 ? 1.0 - x[0] : -2.0 - 0.1 * ( x[0] - 3.0 );
+    *numResidualIncreases += fabs( f[0] ) > *previousNorm ? 1 : 0;
+    *previousNorm = fabs( f[0] );
+  }
+};
+
+struct AndersonRestartData
+{
+  double x[1];
+  SolverStats stats;
+  int numResidualIncreases;
+  double previousNorm;
+};
+
+void testAndersonRestart_helper()
+{
+  AndersonRestartData data{ { 6.0 }, {}, 0, 1.0e300 };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    PiecewiseLinearFixedPoint const residual{ &copyOfData->numResidualIncreases, &copyOfData->previousNorm };
+    copyOfData->stats = andersonAcceleration< 1, 3 >( copyOfData->x, residual, SolverControls< 1 >( 50, 1.0e-12 ), 0.5 );
+  } );
+
+  // after the restart, one plain step and one extrapolation from the fresh
+  // difference (both in the linear piece) land on the root. Extrapolating from
+  // a pre-restart difference instead does not.
+  EXPECT_EQ( data.numResidualIncreases, 1 );
+  EXPECT_TRUE( data.stats.isConverged );
+  EXPECT_NEAR( data.x[0], 1.0, 1.0e-12 );
+  EXPECT_LE( data.stats.numIterations, 5 );
+}
+
+TEST( testNonlinearSolvers, testAndersonRestart )
+{
+  testAndersonRestart_helper();
+}
+
+struct DoglegData
+{
+  double x[1];
+  double x2[2];
+  double xRejected[1];
+  SolverStats stats;
+  SolverStats stats2;
+  SolverStats statsRejected;
+};
+
+void testDogleg_helper()
+{
+  DoglegData data{ { 2.0 }, { 1.2, 1.8 }, { 2.0 }, {}, {}, {} };
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const copyOfData )
+  {
+    auto computeArctanResidual = [] ( double const (&x)[1], double (& r)[1] )
+    {
+      double J[1][1];
+      ArctanSystem{}( x, r, J );
+    };
+    auto computeTwoByTwoResidual = [] ( double const (&x)[2], double (& r)[2] )
+    {
+      double J[2][2];
+      TwoByTwoSystem{}( x, r, J );
+    };
+
+    // the full Newton step diverges from x0 = 2, see testLineSearch
+    copyOfData->stats = doglegTrustRegion< 1 >( copyOfData->x, computeArctanResidual, ArctanSystem{}, SolverControls< 1 >( 30, 1.0e-12 ) );
+    copyOfData->stats2 = doglegTrustRegion< 2 >( copyOfData->x2, computeTwoByTwoResidual, TwoByTwoSystem{}, SolverControls< 2 >( 30, 1.0e-12 ) );
+
+    // a trust region containing the diverging Newton step, which may not be rejected
+    TrustRegionParameters trustRegion;
+    trustRegion.initialRadius = 10.0;
+    trustRegion.maxRejections = 1;
+    copyOfData->statsRejected = doglegTrustRegion< 1 >( copyOfData->xRejected,
+                                                        computeArctanResidual,
+                                                        ArctanSystem{},
+                                                        SolverControls< 1 >( 30, 1.0e-12 ),
+                                                        trustRegion );
+  } );
+
+  EXPECT_TRUE( data.stats.isConverged );
+  EXPECT_NEAR( data.x[0], 0.0, 1.0e-12 );
+  EXPECT_EQ( data.stats.numResidualEvaluations, data.stats.numIterations + data.stats.numBacktracks + 1 );
+
+  // near the root the Newton step is inside the trust region and always accepted
+  EXPECT_TRUE( data.stats2.isConverged );
+  EXPECT_NEAR( data.x2[0], 1.0, 1.0e-12 );
+  EXPECT_NEAR( data.x2[1], 2.0, 1.0e-12 );
+  EXPECT_EQ( data.stats2.numBacktracks, 0 );
+
+  // the rejected step is not taken
+  EXPECT_FALSE( data.statsRejected.isConverged );
+  EXPECT_EQ( data.statsRejected.numIterations, 0 );
+  EXPECT_EQ( data.statsRejected.numBacktracks, 1 );
+  EXPECT_EQ( data.xRejected[0], 2.0 );
+  EXPECT_EQ( data.statsRejected.finalResidualNorm, data.statsRejected.initialResidualNorm );
+}
+
+TEST( testNonlinearSolvers, testDogleg )
+{
+  testDogleg_helper();
+}
+
+
+int main( int argc, char * * argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  int const result = RUN_ALL_TESTS();
+  return result;
+}
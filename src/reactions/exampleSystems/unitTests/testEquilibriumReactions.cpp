@@ -32,7 +32,7 @@ TEST( testEquilibriumReactions, computeResidualAndJacobianTest )
     { { 1.0e16, -2.0 },
       { -2.0, 4.0e16 } };
 
-    computeResidualAndJacobianTest< double, 2 >( bulkGeneric::simpleTestRateParams,
+    computeResidualAndJacobianTest< double, 2 >( bulkGeneric::simpleTestRateParams.equilibriumReactionsParameters(),
                                                  initialSpeciesConcentration,
                                                  expectedResiduals,
                                                  expectedJacobian );
@@ -12,6 +12,7 @@
 
 #include "reactions/unitTestUtilities/kineticReactionsTestUtilities.hpp"
 #include "../BulkGeneric.hpp"
+#include "common/DualNumber.hpp"
 
 #include <gtest/gtest.h>
 
@@ -42,6 +43,75 @@ TEST( testKineticReactions, computeReactionRatesTest_simpleKineticTestRateParams
 }
 
 
+template< bool LOGE_CONCENTRATION >
+struct DualNumberSpeciesRatesData
+{
+  double speciesConcentration[5];
+  double speciesRates[5];
+  CArrayWrapper< double, 5, 5 > speciesRatesDerivatives;
+  double dualSpeciesRates[5];
+  double dualSpeciesRatesDerivatives[5][5];
+};
+
+template< bool LOGE_CONCENTRATION >
+void dualNumberSpeciesRatesTest()
+{
+  using KineticReactionsType = KineticReactions< double, int, int, LOGE_CONCENTRATION >;
+  using DualType = DualNumber< double, 5 >;
+  using DualKineticReactionsType = KineticReactions< DualType, int, int, LOGE_CONCENTRATION >;
+
+  double const speciesConcentration[5] = { 1.0, 0.3, 0.5, 0.8, 0.2 };
+
+  DualNumberSpeciesRatesData< LOGE_CONCENTRATION > data;
+  for( int i = 0; i < 5; ++i )
+  {
+    data.speciesConcentration[i] = LOGE_CONCENTRATION ? log( speciesConcentration[i] ) : speciesConcentration[i];
+  }
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const dataCopy )
+  {
+    auto const params = bulkGeneric::simpleKineticTestRateParams.kineticReactionsParameters();
+
+    KineticReactionsType::computeSpeciesRates( 298.15,
+                                               params,
+                                               dataCopy->speciesConcentration,
+                                               dataCopy->speciesRates,
+                                               dataCopy->speciesRatesDerivatives );
+
+    // the residual-only path on dual numbers gives the jacobian without the hand-coded derivatives
+    DualType speciesConcentrationDual[5];
+    DualType speciesRatesDual[5];
+    dualNumbers::makeIndependentVariables( dataCopy->speciesConcentration, speciesConcentrationDual );
+    DualKineticReactionsType::computeSpeciesRates( 298.15,
+                                                   params,
+                                                   speciesConcentrationDual,
+                                                   speciesRatesDual );
+    for( int i = 0; i < 5; ++i )
+    {
+      dataCopy->dualSpeciesRates[i] = speciesRatesDual[i].value;
+      for( int j = 0; j < 5; ++j )
+      {
+        dataCopy->dualSpeciesRatesDerivatives[i][j] = speciesRatesDual[i].derivatives[j];
+      }
+    }
+  } );
+
+  for( int i = 0; i < 5; ++i )
+  {
+    EXPECT_NEAR( data.dualSpeciesRates[i], data.speciesRates[i], 1.0e-14 );
+    for( int j = 0; j < 5; ++j )
+    {
+      EXPECT_NEAR( data.dualSpeciesRatesDerivatives[i][j], data.speciesRatesDerivatives( i, j ), 1.0e-14 );
+    }
+  }
+}
+
+TEST( testKineticReactions, computeSpeciesRatesDualNumber_simpleKineticTestRateParams )
+{
+  dualNumberSpeciesRatesTest< false >();
+  dualNumberSpeciesRatesTest< true >();
+}
+
 TEST( testKineticReactions, computeSpeciesRatesTest_simpleKineticTestRateParams )
 {
   double const initialSpeciesConcentration[5] = { 1.0, 1.0e-16, 0.5, 1.0, 1.0e-16 };
@@ -84,6 +154,51 @@ TEST( testKineticReactions, testTimeStep )
   //                               expectedSpeciesConcentrations );
 }
 
+TEST( testKineticReactions, testTimeStepLineSearch )
+{
+  double const initialSpeciesConcentration[5] = { 1.0, 1.0e-16, 0.5, 1.0, 1.0e-16 };
+  double const expectedSpeciesConcentrations[5] = { 3.92138293924124e-01, 3.03930853037938e-01, 5.05945480771998e-01, 7.02014627734060e-01, 5.95970744531880e-01 };
+
+  nonlinearSolvers::BacktrackingLineSearch lineSearch;
+  lineSearch.maxUpdate = 1.0;
+
+  timeStepTest< double, false >( bulkGeneric::simpleKineticTestRateParams.kineticReactionsParameters(),
+                                 2.0,
+                                 10,
+                                 initialSpeciesConcentration,
+                                 expectedSpeciesConcentrations,
+                                 nonlinearSolvers::SolverControls< 5 >( 20, 1.0e-14 ),
+                                 lineSearch );
+}
+
+TEST( testKineticReactions, testTimeStepPredictor )
+{
+  double const initialSpeciesConcentration[5] = { 1.0, 1.0e-16, 0.5, 1.0, 1.0e-16 };
+  double const expectedSpeciesConcentrations[5] = { 3.92138293924124e-01, 3.03930853037938e-01, 5.05945480771998e-01, 7.02014627734060e-01, 5.95970744531880e-01 };
+
+  // the time step resolves the transient, where the extrapolation pays off
+  for( int order = 0; order <= 2; ++order )
+  {
+    nonlinearSolvers::SolverStats const stats =
+      timeStepPredictorTest< double >( bulkGeneric::simpleKineticTestRateParams.kineticReactionsParameters(),
+                                       0.2,
+                                       100,
+                                       order,
+                                       initialSpeciesConcentration,
+                                       expectedSpeciesConcentrations );
+    EXPECT_TRUE( stats.isConverged );
+    if( order == 0 )
+    {
+      // the previous state is the default initial guess
+      EXPECT_EQ( stats.numIterationsSaved, 0 );
+    }
+    else
+    {
+      EXPECT_GT( stats.numIterationsSaved, 0 );
+    }
+  }
+}
+
 int main( int argc, char * * argv )
 {
   ::testing::InitGoogleTest( &argc, argv );
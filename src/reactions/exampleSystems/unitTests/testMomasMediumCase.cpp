@@ -20,6 +20,7 @@ using namespace hpcReact::unitTest_utilities;
 //******************************************************************************
 
 
+template< bool SYMMETRIC >
 void testMoMasMediumEquilibriumHelper()
 {
   using EquilibriumReactionsType = reactionsSystems::EquilibriumReactions< double,
@@ -61,11 +62,22 @@ void testMoMasMediumEquilibriumHelper()
       log( initialPrimarySpeciesConcentration[4] )
     };
 
-    EquilibriumReactionsType::enforceEquilibrium_Aggregate( 0,
-                                                            hpcReact::MoMasBenchmark::mediumCaseParams.equilibriumReactionsParameters(),
-                                                            targetAggregatePrimarySpeciesConcentration,
-                                                            logInitialPrimarySpeciesConcentration,
-                                                            logPrimarySpeciesConcentrationCopy );
+    if constexpr( SYMMETRIC )
+    {
+      EquilibriumReactionsType::enforceEquilibrium_AggregateSymmetric( 0,
+                                                                       hpcReact::MoMasBenchmark::mediumCaseParams.equilibriumReactionsParameters(),
+                                                                       targetAggregatePrimarySpeciesConcentration,
+                                                                       logInitialPrimarySpeciesConcentration,
+                                                                       logPrimarySpeciesConcentrationCopy );
+    }
+    else
+    {
+      EquilibriumReactionsType::enforceEquilibrium_Aggregate( 0,
+                                                              hpcReact::MoMasBenchmark::mediumCaseParams.equilibriumReactionsParameters(),
+                                                              targetAggregatePrimarySpeciesConcentration,
+                                                              logInitialPrimarySpeciesConcentration,
+                                                              logPrimarySpeciesConcentrationCopy );
+    }
   } );
 
   double const expectedPrimarySpeciesConcentrations[numPrimarySpecies] =
@@ -87,7 +99,170 @@ void testMoMasMediumEquilibriumHelper()
 
 TEST( testEquilibriumReactions, testMoMasMediumEquilibrium )
 {
-  testMoMasMediumEquilibriumHelper();
+  testMoMasMediumEquilibriumHelper< false >();
+}
+
+TEST( testEquilibriumReactions, testMoMasMediumEquilibriumSymmetric )
+{
+  testMoMasMediumEquilibriumHelper< true >();
+}
+
+struct IllScaledData
+{
+  double logPrimarySpeciesConcentration[5];
+  nonlinearSolvers::SolverStats statsPivoted;
+  nonlinearSolvers::SolverStats statsEquilibrated;
+};
+
+/**
+ * Solve the MoMaS medium equilibrium with the rows of the aggregate residual
+ * scaled by factors spanning 60 orders of magnitude, as if every total was
+ * expressed in a different unit. The residual weights undo the scaling, so
+ * only the linear solves see it.
+ */
+template< typename LINEAR_SOLVER >
+HPCREACT_HOST_DEVICE
+nonlinearSolvers::SolverStats illScaledMoMasMediumEquilibrium( double (& logPrimarySpeciesConcentration)[5] )
+{
+  using EquilibriumReactionsType = reactionsSystems::EquilibriumReactions< double,
+                                                                           int,
+                                                                           int >;
+
+  static constexpr int numPrimarySpecies = hpcReact::MoMasBenchmark::mediumCaseParams.numPrimarySpecies();
+
+  double const targetAggregatePrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, -3.0, 1.0e-20, 1.0, 1.0 };
+  double const rowScale[numPrimarySpecies] = { 1.0e-30, 1.0e20, 1.0, 1.0e-25, 1.0e30 };
+
+  nonlinearSolvers::SolverControls< numPrimarySpecies > controls( 150, 1.0e-12 );
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    controls.residualWeights[i] = 1.0 / rowScale[i];
+  }
+
+  auto computeResidualAndJacobian = [&]( double const (&logC)[numPrimarySpecies],
+                                         double (& r)[numPrimarySpecies],
+                                         double (& J)[numPrimarySpecies][numPrimarySpecies] )
+  {
+    CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > jacobian;
+    EquilibriumReactionsType::computeResidualAndJacobianAggregatePrimaryConcentrations( 0.0,
+                                                                                        hpcReact::MoMasBenchmark::mediumCaseParams.equilibriumReactionsParameters(),
+                                                                                        targetAggregatePrimarySpeciesConcentration,
+                                                                                        logC,
+                                                                                        r,
+                                                                                        jacobian );
+    // the aggregate jacobian is assembled as -dr/dlogC
+    for( int i = 0; i < numPrimarySpecies; ++i )
+    {
+      r[i] *= rowScale[i];
+      for( int j = 0; j < numPrimarySpecies; ++j )
+      {
+        J[i][j] = -rowScale[i] * jacobian( i, j );
+      }
+    }
+  };
+
+  double const initialPrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, 0.02, 1.0e-20, 1.0, 1.0 };
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    logPrimarySpeciesConcentration[i] = log( initialPrimarySpeciesConcentration[i] );
+  }
+  return nonlinearSolvers::newtonRaphson< numPrimarySpecies >( logPrimarySpeciesConcentration,
+                                                               computeResidualAndJacobian,
+                                                               controls,
+                                                               LINEAR_SOLVER{} );
+}
+
+TEST( testEquilibriumReactions, testMoMasMediumEquilibriumIllScaled )
+{
+  static constexpr int numPrimarySpecies = hpcReact::MoMasBenchmark::mediumCaseParams.numPrimarySpecies();
+
+  IllScaledData data;
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const dataCopy )
+  {
+    double logPrimarySpeciesConcentrationPivoted[numPrimarySpecies];
+    dataCopy->statsPivoted = illScaledMoMasMediumEquilibrium< PivotedLUSolver >( logPrimarySpeciesConcentrationPivoted );
+    dataCopy->statsEquilibrated = illScaledMoMasMediumEquilibrium< EquilibratedSolver< PivotedLUSolver > >( dataCopy->logPrimarySpeciesConcentration );
+  } );
+
+  // partial pivoting alone is misled by the row scales
+  EXPECT_TRUE( data.statsEquilibrated.isConverged );
+  EXPECT_LT( data.statsEquilibrated.numIterations, data.statsPivoted.numIterations );
+
+  double const expectedPrimarySpeciesConcentrations[numPrimarySpecies] =
+  {
+    9.9999999999999919e-21, // X1
+    0.14796989521717838, // X2
+    5.7165444793692536e-24, // X3
+    0.025616412699749774, // X4
+    0.53958559521499294 // S
+  };
+
+  for( int r=0; r<numPrimarySpecies; ++r )
+  {
+    EXPECT_NEAR( exp( data.logPrimarySpeciesConcentration[r] ), expectedPrimarySpeciesConcentrations[r], 1.0e-8 * expectedPrimarySpeciesConcentrations[r] );
+  }
+}
+
+struct WarmStartData
+{
+  double logPrimarySpeciesConcentrationWarm[5];
+  double logPrimarySpeciesConcentrationCold[5];
+  nonlinearSolvers::SolverStats statsInitial;
+  nonlinearSolvers::SolverStats statsWarm;
+  nonlinearSolvers::SolverStats statsCold;
+};
+
+TEST( testEquilibriumReactions, testMoMasMediumEquilibriumWarmStart )
+{
+  using EquilibriumReactionsType = reactionsSystems::EquilibriumReactions< double,
+                                                                           int,
+                                                                           int >;
+
+  static constexpr int numPrimarySpecies = hpcReact::MoMasBenchmark::mediumCaseParams.numPrimarySpecies();
+
+  WarmStartData data;
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const dataCopy )
+  {
+    auto const & params = hpcReact::MoMasBenchmark::mediumCaseParams.equilibriumReactionsParameters();
+    double const targetAggregatePrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, -3.0, 1.0e-20, 1.0, 1.0 };
+    // the totals after a transport step
+    double const perturbedAggregatePrimarySpeciesConcentration[numPrimarySpecies] = { 1.0e-20, -3.01, 1.0e-20, 1.02, 0.99 };
+    double logInitialPrimarySpeciesConcentration[numPrimarySpecies] = { log( 1.0e-20 ), log( 0.02 ), log( 1.0e-20 ), 0.0, 0.0 };
+
+    nonlinearSolvers::WarmStartState< double, numPrimarySpecies > warmStart;
+    dataCopy->statsInitial = EquilibriumReactionsType::enforceEquilibrium_Aggregate( 0,
+                                                                                     params,
+                                                                                     targetAggregatePrimarySpeciesConcentration,
+                                                                                     logInitialPrimarySpeciesConcentration,
+                                                                                     dataCopy->logPrimarySpeciesConcentrationWarm,
+                                                                                     warmStart );
+
+    dataCopy->statsWarm = EquilibriumReactionsType::enforceEquilibrium_Aggregate( 0,
+                                                                                  params,
+                                                                                  perturbedAggregatePrimarySpeciesConcentration,
+                                                                                  logInitialPrimarySpeciesConcentration,
+                                                                                  dataCopy->logPrimarySpeciesConcentrationWarm,
+                                                                                  warmStart );
+
+    dataCopy->statsCold = EquilibriumReactionsType::enforceEquilibrium_Aggregate( 0,
+                                                                                  params,
+                                                                                  perturbedAggregatePrimarySpeciesConcentration,
+                                                                                  logInitialPrimarySpeciesConcentration,
+                                                                                  dataCopy->logPrimarySpeciesConcentrationCold );
+  } );
+
+  EXPECT_TRUE( data.statsInitial.isConverged );
+  EXPECT_TRUE( data.statsWarm.isConverged );
+  EXPECT_TRUE( data.statsCold.isConverged );
+  EXPECT_LT( data.statsWarm.numIterations, data.statsCold.numIterations );
+
+  for( int r=0; r<numPrimarySpecies; ++r )
+  {
+    double const expected = exp( data.logPrimarySpeciesConcentrationCold[r] );
+    EXPECT_NEAR( exp( data.logPrimarySpeciesConcentrationWarm[r] ), expected, 1.0e-8 * expected );
+  }
 }
 
 int main( int argc, char * * argv )
@@ -109,9 +109,15 @@ constexpr CArrayWrapper<int, 10> mobileSpeciesFlag =
 
 }
 
-using carbonateSystemAllKineticType     = reactionsSystems::MixedReactionsParameters< double, int, signed char, 17, 10, 0 >;
-using carbonateSystemAllEquilibriumType = reactionsSystems::MixedReactionsParameters< double, int, signed char, 17, 10, 10 >;
-using carbonateSystemType               = reactionsSystems::MixedReactionsParameters< double, int, signed char, 16, 10, 9 >;
+using carbonateSystemAllKineticType     = reactionsSystems::MixedReactionsParameters< double, int, signed char, 17, 10, 0,
+                                                                                      reactionsSystems::countNonzeros( carbonate::stoichMatrix, 0, 0 ),
+                                                                                      reactionsSystems::countNonzeros( carbonate::stoichMatrix, 0, 10 ) >;
+using carbonateSystemAllEquilibriumType = reactionsSystems::MixedReactionsParameters< double, int, signed char, 17, 10, 10,
+                                                                                      reactionsSystems::countNonzeros( carbonate::stoichMatrix, 0, 10 ),
+                                                                                      reactionsSystems::countNonzeros( carbonate::stoichMatrix, 10, 10 ) >;
+using carbonateSystemType               = reactionsSystems::MixedReactionsParameters< double, int, signed char, 16, 10, 9,
+                                                                                      reactionsSystems::countNonzeros( carbonate::stoichMatrixNosolid, 0, 9 ),
+                                                                                      reactionsSystems::countNonzeros( carbonate::stoichMatrixNosolid, 9, 10 ) >;
 
 constexpr carbonateSystemAllKineticType carbonateSystemAllKinetic( carbonate::stoichMatrix, carbonate::equilibriumConstants, carbonate::forwardRates, carbonate::reverseRates, carbonate::mobileSpeciesFlag, 0 );
 constexpr carbonateSystemAllEquilibriumType carbonateSystemAllEquilibrium( carbonate::stoichMatrix, carbonate::equilibriumConstants, carbonate::forwardRates, carbonate::reverseRates, carbonate::mobileSpeciesFlag );
@@ -144,7 +144,9 @@ constexpr CArrayWrapper< int, 19 > mobileSpeciesFlag =
 
 }
 
-using forgeSystemType = reactionsSystems::MixedReactionsParameters< double, int, signed char, 26, 19, 16 >;
+using forgeSystemType = reactionsSystems::MixedReactionsParameters< double, int, signed char, 26, 19, 16,
+                                                                    reactionsSystems::countNonzeros( forge::soichMatrix, 0, 16 ),
+                                                                    reactionsSystems::countNonzeros( forge::soichMatrix, 16, 19 ) >;
 
 
 constexpr forgeSystemType forgeSystem( forge::soichMatrix, forge::equilibriumConstants, forge::fwRateConstant, forge::reverseRateConstant, forge::mobileSpeciesFlag );
@@ -153,9 +153,15 @@ constexpr CArrayWrapper<int, 21> mobileSpeciesFlag =
   };
 }
 
-  using ultramaficSystemAllKineticType     = reactionsSystems::MixedReactionsParameters< double, int, signed char, 25, 21, 0 >;
-  using ultramaficSystemAllEquilibriumType = reactionsSystems::MixedReactionsParameters< double, int, signed char, 25, 21, 21 >;
-  using ultramaficSystemType               = reactionsSystems::MixedReactionsParameters< double, int, signed char, 25, 21, 16 >;
+  using ultramaficSystemAllKineticType     = reactionsSystems::MixedReactionsParameters< double, int, signed char, 25, 21, 0,
+                                                                                         reactionsSystems::countNonzeros( ultramafics::stoichMatrix, 0, 0 ),
+                                                                                         reactionsSystems::countNonzeros( ultramafics::stoichMatrix, 0, 21 ) >;
+  using ultramaficSystemAllEquilibriumType = reactionsSystems::MixedReactionsParameters< double, int, signed char, 25, 21, 21,
+                                                                                         reactionsSystems::countNonzeros( ultramafics::stoichMatrix, 0, 21 ),
+                                                                                         reactionsSystems::countNonzeros( ultramafics::stoichMatrix, 21, 21 ) >;
+  using ultramaficSystemType               = reactionsSystems::MixedReactionsParameters< double, int, signed char, 25, 21, 16,
+                                                                                         reactionsSystems::countNonzeros( ultramafics::stoichMatrix, 0, 16 ),
+                                                                                         reactionsSystems::countNonzeros( ultramafics::stoichMatrix, 16, 21 ) >;
 
   constexpr ultramaficSystemAllKineticType     ultramaficSystemAllKinetic( ultramafics::stoichMatrix, ultramafics::equilibriumConstants, ultramafics::forwardRates, ultramafics::reverseRates, ultramafics::mobileSpeciesFlag );
   constexpr ultramaficSystemAllEquilibriumType ultramaficSystemAllEquilibrium( ultramafics::stoichMatrix, ultramafics::equilibriumConstants, ultramafics::forwardRates, ultramafics::reverseRates, ultramafics::mobileSpeciesFlag );
@@ -156,6 +156,67 @@ TEST( testEquilibriumReactions, testcarbonateSystemAllEquilibrium2 )
 
 }
 
+TEST( testEquilibriumReactions, testcarbonateSystemAllEquilibriumAnderson )
+{
+
+  using EquilibriumReactionsType = reactionsSystems::EquilibriumReactions< double,
+                                                                           int,
+                                                                           int >;
+
+  static constexpr int numPrimarySpecies = hpcReact::geochemistry::carbonateSystemAllEquilibrium.numPrimarySpecies();
+
+  struct AndersonData
+  {
+    double logPrimarySpeciesConcentration[numPrimarySpecies];
+    nonlinearSolvers::SolverStats stats;
+  } data;
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const dataCopy )
+  {
+    double const initialPrimarySpeciesConcentration[numPrimarySpecies] =
+    {
+      3.76e-1, // H+
+      3.76e-1, // HCO3-
+      3.87e-2, // Ca+2
+      3.21e-2, // SO4-2
+      1.89000, // Cl-
+      1.65e-2, // Mg+2
+      1.09000 // Na+1
+    };
+
+    double logInitialPrimarySpeciesConcentration[numPrimarySpecies];
+    for( int i = 0; i < numPrimarySpecies; ++i )
+    {
+      logInitialPrimarySpeciesConcentration[i] = log( initialPrimarySpeciesConcentration[i] );
+    }
+
+    dataCopy->stats = EquilibriumReactionsType::enforceEquilibrium_AggregateAnderson( 0,
+                                                                                      hpcReact::geochemistry::carbonateSystemAllEquilibrium.equilibriumReactionsParameters(),
+                                                                                      initialPrimarySpeciesConcentration,
+                                                                                      logInitialPrimarySpeciesConcentration,
+                                                                                      dataCopy->logPrimarySpeciesConcentration );
+  } );
+
+  // same solution as testcarbonateSystemAllEquilibrium2
+  double const expectedPrimarySpeciesConcentrations[numPrimarySpecies] =
+  {
+    0.00046855267453254149, // H+
+    0.00035429509915645743, // HCO3-
+    0.0032447552774548518, // Ca+2
+    0.0036925967592983211, // SO4-2
+    1.8543095763683592, // Cl-
+    0.010161666243360675, // Mg+2
+    1.0704323027126488 // Na+1
+  };
+
+  EXPECT_TRUE( data.stats.isConverged );
+  EXPECT_EQ( data.stats.numLinearSolves, data.stats.numIterations - 1 );
+  for( int r=0; r<numPrimarySpecies; ++r )
+  {
+    EXPECT_NEAR( exp( data.logPrimarySpeciesConcentration[r] ), expectedPrimarySpeciesConcentrations[r], 1.0e-8 * expectedPrimarySpeciesConcentrations[r] );
+  }
+}
+
 int main( int argc, char * * argv )
 {
   ::testing::InitGoogleTest( &argc, argv );
@@ -232,6 +232,44 @@ TEST( testKineticReactions, testTimeStep_carbonateSystemAllKinetic )
   //                               expectedSpeciesConcentrations );
 }
 
+TEST( testKineticReactions, computeReactionRatesBatchedTest_carbonateSystemAllKinetic )
+{
+  double const speciesConcentration[17] =
+  {
+    2.327841695586879e-11, // OH-
+    0.37555955033916549, // CO2
+    3.956656978189456e-11, // CO3-2
+    6.739226982791492e-05, // CaHCO3+
+    5.298329882666738e-03, // CaSO4
+    5.844517547638333e-03, // CaCl+
+    1.277319392670652e-02, // CaCl2
+    6.618125707964991e-03, // MgSO4
+    1.769217213462983e-02, // NaSO4-
+    1.065032288527957e-09, // CaCO3
+    4.396954721488358e-04, // H+
+    3.723009698453808e-04, // HCO3-
+    1.471656530812871e-02, // Ca+2
+    2.491372274738741e-03, // SO4-2
+    1.858609094598949e+00, // Cl-
+    9.881874292035110e-03, // Mg+2
+    1.072307827865370e+00 // Na+1
+  };
+
+  // more than one block of cells, with a partial last block
+  computeReactionRatesBatchedTest< double, 77 >( carbonateSystemAllKinetic.kineticReactionsParameters(),
+                                                 speciesConcentration );
+
+  // the quotient form of the same reactions
+  static constexpr carbonateSystemAllKineticType carbonateSystemAllKineticQuotient( carbonate::stoichMatrix,
+                                                                                    carbonate::equilibriumConstants,
+                                                                                    carbonate::forwardRates,
+                                                                                    carbonate::reverseRates,
+                                                                                    carbonate::mobileSpeciesFlag,
+                                                                                    1 );
+  computeReactionRatesBatchedTest< double, 77 >( carbonateSystemAllKineticQuotient.kineticReactionsParameters(),
+                                                 speciesConcentration );
+}
+
 int main( int argc, char * * argv )
 {
   ::testing::InitGoogleTest( &argc, argv );
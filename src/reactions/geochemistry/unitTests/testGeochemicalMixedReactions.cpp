@@ -11,6 +11,7 @@
 
 #include "reactions/unitTestUtilities/mixedReactionsTestUtilities.hpp"
 #include "../GeochemicalSystems.hpp"
+#include "common/SparseDirectSystemSolve.hpp"
 
 
 using namespace hpcReact;
@@ -59,6 +60,255 @@ TEST( testMixedReactions, testTimeStep_carbonateSystem )
 
 }
 
+TEST( testMixedReactions, testTimeStep_carbonateSystemSparseLU )
+{
+  using namespace hpcReact::geochemistry;
+
+  static constexpr int numPrimarySpecies = carbonateSystemType::numPrimarySpecies();
+
+  // the symbolic factorization of the Jacobian is computed at compile time
+  static constexpr SparseLUSymbolic< numPrimarySpecies > symbolic( carbonateSystem.aggregateJacobianSparsityPattern() );
+  static_assert( symbolic.numFactorNonzeros() <= numPrimarySpecies * numPrimarySpecies );
+
+  double const surfaceArea[carbonateSystemType::numKineticReactions()] =
+  {
+    1.0, // CaCO3
+  };
+
+  double const initialAggregateSpeciesConcentration[numPrimarySpecies] =
+  {
+    3.76e-1, // H+
+    3.76e-1, // HCO3-
+    3.87e-2, // Ca+2
+    3.21e-2, // SO4-2
+    1.89, // Cl-
+    1.65e-2, // Mg+2
+    1.09 // Na+1
+  };
+
+  double const expectedSpeciesConcentrations[numPrimarySpecies] =
+  {
+    0.00040311656239679382, // H+
+    0.00041180885982392148, // HCO3-
+    0.0032499045666604504, // Ca+2
+    0.0036920967945592146, // SO4-2
+    1.8542541730074311, // Cl-
+    0.010162194793470079, // Mg+2
+    1.070434904554991 // Na+1
+  };
+
+  timeStepTest< double, true >( carbonateSystem,
+                                1.0,
+                                10,
+                                initialAggregateSpeciesConcentration,
+                                surfaceArea,
+                                expectedSpeciesConcentrations,
+                                SparseLUSolver< numPrimarySpecies >{ symbolic } );
+
+}
+
+TEST( testMixedReactions, testSparseJacobianSolve_ultramaficSystem )
+{
+  using namespace hpcReact::geochemistry;
+
+  static constexpr int numPrimarySpecies = ultramaficSystemType::numPrimarySpecies();
+
+  // the symbolic factorization of the Jacobian is computed at compile time, and the
+  // factors keep most of the zeros of the dense matrix
+  static constexpr SparseLUSymbolic< numPrimarySpecies > symbolic( ultramaficSystem.aggregateJacobianSparsityPattern() );
+  static_assert( symbolic.numFactorNonzeros() <= 3 * numPrimarySpecies * numPrimarySpecies / 4 );
+
+  double primarySpeciesConcentration[numPrimarySpecies];
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    primarySpeciesConcentration[i] = 1.0e-3 * ( 1.0 + 0.5 * i );
+  }
+
+  double surfaceArea[ultramaficSystemType::numKineticReactions()];
+  for( int r = 0; r < ultramaficSystemType::numKineticReactions(); ++r )
+  {
+    surfaceArea[r] = 1.0;
+  }
+
+  sparseJacobianSolveTest( ultramaficSystem,
+                           symbolic,
+                           1.0,
+                           primarySpeciesConcentration,
+                           surfaceArea );
+}
+
+TEST( testMixedReactions, testSparseJacobianSolve_forgeSystem )
+{
+  using namespace hpcReact::geochemistry;
+
+  static constexpr int numPrimarySpecies = forgeSystemType::numPrimarySpecies();
+
+  static constexpr SparseLUSymbolic< numPrimarySpecies > symbolic( forgeSystem.aggregateJacobianSparsityPattern() );
+  static_assert( symbolic.numFactorNonzeros() <= numPrimarySpecies * numPrimarySpecies );
+
+  // forge::equilibriumConstants holds log10 values, which would make the
+  // Jacobian NaN, so the system is rebuilt with the converted constants
+  CArrayWrapper< double, forgeSystemType::numReactions() > equilibriumConstants;
+  for( int r = 0; r < forgeSystemType::numReactions(); ++r )
+  {
+    equilibriumConstants[r] = pow( 10.0, forge::equilibriumConstants[r] );
+  }
+  forgeSystemType const params( forge::soichMatrix,
+                                equilibriumConstants,
+                                forge::fwRateConstant,
+                                forge::reverseRateConstant,
+                                forge::mobileSpeciesFlag );
+
+  double primarySpeciesConcentration[numPrimarySpecies];
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    primarySpeciesConcentration[i] = 1.0e-3 * ( 1.0 + 0.5 * i );
+  }
+
+  double surfaceArea[forgeSystemType::numKineticReactions()];
+  for( int r = 0; r < forgeSystemType::numKineticReactions(); ++r )
+  {
+    surfaceArea[r] = 1.0;
+  }
+
+  sparseJacobianSolveTest( params,
+                           symbolic,
+                           1.0,
+                           primarySpeciesConcentration,
+                           surfaceArea );
+}
+
+TEST( testMixedReactions, testTimeStepWarmStart_carbonateSystem )
+{
+  using namespace hpcReact::geochemistry;
+
+  static constexpr int numPrimarySpecies = carbonateSystemType::numPrimarySpecies();
+
+  double const surfaceArea[carbonateSystemType::numKineticReactions()] =
+  {
+    1.0, // CaCO3
+  };
+
+  double const initialAggregateSpeciesConcentration[numPrimarySpecies] =
+  {
+    3.76e-1, // H+
+    3.76e-1, // HCO3-
+    3.87e-2, // Ca+2
+    3.21e-2, // SO4-2
+    1.89, // Cl-
+    1.65e-2, // Mg+2
+    1.09 // Na+1
+  };
+
+  double const expectedSpeciesConcentrations[numPrimarySpecies] =
+  {
+    0.00040311656239679382, // H+
+    0.00041180885982392148, // HCO3-
+    0.0032499045666604504, // Ca+2
+    0.0036920967945592146, // SO4-2
+    1.8542541730074311, // Cl-
+    0.010162194793470079, // Mg+2
+    1.070434904554991 // Na+1
+  };
+
+  // the first step is a cold start, the following ones start from the last
+  // solution and reuse the Jacobian factorization
+  int const numSteps = 10;
+  int numFactorizations = 0;
+  nonlinearSolvers::SolverStats const stats = warmStartTimeStepTest( carbonateSystem,
+                                                                     1.0,
+                                                                     numSteps,
+                                                                     false,
+                                                                     initialAggregateSpeciesConcentration,
+                                                                     surfaceArea,
+                                                                     expectedSpeciesConcentrations,
+                                                                     numFactorizations );
+  EXPECT_TRUE( stats.isConverged );
+  EXPECT_GE( numFactorizations, 1 );
+  EXPECT_LT( numFactorizations, numSteps - 1 );
+}
+
+TEST( testMixedReactions, testTimeStepPredictor_carbonateSystem )
+{
+  using namespace hpcReact::geochemistry;
+
+  static constexpr int numPrimarySpecies = carbonateSystemType::numPrimarySpecies();
+
+  double const surfaceArea[carbonateSystemType::numKineticReactions()] =
+  {
+    1.0, // CaCO3
+  };
+
+  double const initialAggregateSpeciesConcentration[numPrimarySpecies] =
+  {
+    3.76e-1, // H+
+    3.76e-1, // HCO3-
+    3.87e-2, // Ca+2
+    3.21e-2, // SO4-2
+    1.89, // Cl-
+    1.65e-2, // Mg+2
+    1.09 // Na+1
+  };
+
+  double const expectedSpeciesConcentrations[numPrimarySpecies] =
+  {
+    0.00040311656239679382, // H+
+    0.00041180885982392148, // HCO3-
+    0.0032499045666604504, // Ca+2
+    0.0036920967945592146, // SO4-2
+    1.8542541730074311, // Cl-
+    0.010162194793470079, // Mg+2
+    1.070434904554991 // Na+1
+  };
+
+  int const numSteps = 10;
+  int numFactorizations = 0;
+  nonlinearSolvers::SolverStats const stats = warmStartTimeStepTest( carbonateSystem,
+                                                                     1.0,
+                                                                     numSteps,
+                                                                     false,
+                                                                     initialAggregateSpeciesConcentration,
+                                                                     surfaceArea,
+                                                                     expectedSpeciesConcentrations,
+                                                                     numFactorizations );
+
+  // the extrapolated initial guesses are closer to the solution than the last one
+  nonlinearSolvers::SolverStats const statsPredictor = warmStartTimeStepTest( carbonateSystem,
+                                                                              1.0,
+                                                                              numSteps,
+                                                                              true,
+                                                                              initialAggregateSpeciesConcentration,
+                                                                              surfaceArea,
+                                                                              expectedSpeciesConcentrations,
+                                                                              numFactorizations );
+  EXPECT_TRUE( statsPredictor.isConverged );
+  EXPECT_LT( statsPredictor.numIterations, stats.numIterations );
+}
+
+TEST( testMixedReactions, testResidualOnly_carbonateSystem )
+{
+  using namespace hpcReact::geochemistry;
+
+  // the carbonate time step solution, where all reactions are active
+  double const primarySpeciesConcentration[carbonateSystemType::numPrimarySpecies()] =
+  {
+    0.00040311656239679382, // H+
+    0.00041180885982392148, // HCO3-
+    0.0032499045666604504, // Ca+2
+    0.0036920967945592146, // SO4-2
+    1.8542541730074311, // Cl-
+    0.010162194793470079, // Mg+2
+    1.070434904554991 // Na+1
+  };
+
+  double const surfaceArea[carbonateSystemType::numKineticReactions()] =
+  {
+    1.0, // CaCO3
+  };
+
+  residualOnlyTest< double >( carbonateSystem, primarySpeciesConcentration, surfaceArea );
+}
+
 int main( int argc, char * * argv )
 {
   ::testing::InitGoogleTest( &argc, argv );
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "common/macros.hpp"
+#include "common/symmetricMatrix.hpp"
 #include <math.h>
 #include <functional>
 #include <iostream>
@@ -39,7 +40,8 @@ void calculateLogSecondarySpeciesConcentration( PARAMS_DATA const & params,
                                                 FUNC && derivativeFunc )
 {
   static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
-  static constexpr int numPrimarySpecies   = PARAMS_DATA::numPrimarySpecies();
+
+  auto const & stoichiometry = params.sparseStoichiometry();
 
   for( INDEX_TYPE i = 0; i < numSecondarySpecies; ++i )
   {
@@ -50,10 +52,15 @@ void calculateLogSecondarySpeciesConcentration( PARAMS_DATA const & params,
   {
     REAL_TYPE const gamma = 1;
     logSecondarySpeciesConcentrations[j] = -log( params.equilibriumConstant( j ) ) - log( gamma );
-    for( int k=0; k<numPrimarySpecies; ++k )
+    // only the primary species that participate in reaction j contribute
+    for( int m = stoichiometry.reactionBegin( j ); m < stoichiometry.reactionEnd( j ); ++m )
     {
-      logSecondarySpeciesConcentrations[j] += params.stoichiometricMatrix( j, k+numSecondarySpecies ) * ( logPrimarySpeciesConcentrations[k] + log( gamma ) );
-      derivativeFunc( j, k, params.stoichiometricMatrix( j, k+numSecondarySpecies ) );
+      int const k = stoichiometry.reactionSpecies( m ) - numSecondarySpecies;
+      if( k >= 0 )
+      {
+        logSecondarySpeciesConcentrations[j] += stoichiometry.reactionCoefficient( m ) * ( logPrimarySpeciesConcentrations[k] + log( gamma ) );
+        derivativeFunc( j, k, stoichiometry.reactionCoefficient( m ) );
+      }
     }
   }
 }
@@ -100,6 +107,15 @@ void calculateLogSecondarySpeciesConcentrationWrtLogC( PARAMS_DATA const & param
                                                        ARRAY_1D & logSecondarySpeciesConcentrations,
                                                        ARRAY_2D & dLogSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentrations )
 {
+  // derivativeFunc is only called for the nonzero entries, so zero the rest first.
+  for( int j = 0; j < PARAMS_DATA::numSecondarySpecies(); ++j )
+  {
+    for( int k = 0; k < PARAMS_DATA::numPrimarySpecies(); ++k )
+    {
+      dLogSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentrations[j][k] = 0.0;
+    }
+  }
+
   massActions_impl::calculateLogSecondarySpeciesConcentration< REAL_TYPE, INT_TYPE, INDEX_TYPE >( params,
                                                                                                   logPrimarySpeciesConcentrations,
                                                                                                   logSecondarySpeciesConcentrations,
@@ -147,15 +163,98 @@ void calculateAggregatePrimaryConcentrationsWrtLogC( PARAMS_DATA const & params,
     REAL_TYPE const speciesConcentration_i = exp( logPrimarySpeciesConcentrations[i] );
     aggregatePrimarySpeciesConcentrations[i] = speciesConcentration_i;
     dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, i ) = speciesConcentration_i;
-    for( int j = 0; j < numSecondarySpecies; ++j )
+  }
+
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+  // each secondary species only contributes to the primary species in its reaction
+  for( int j = 0; j < numSecondarySpecies; ++j )
+  {
+    REAL_TYPE const secondarySpeciesConcentrations_j = exp( logSecondarySpeciesConcentrations[j] );
+    for( int m = stoichiometry.reactionBegin( j ); m < stoichiometry.reactionEnd( j ); ++m )
     {
-      REAL_TYPE const secondarySpeciesConcentrations_j = exp( logSecondarySpeciesConcentrations[j] );
-      aggregatePrimarySpeciesConcentrations[i] += params.stoichiometricMatrix( j, i+numSecondarySpecies ) * secondarySpeciesConcentrations_j;
-      for( int k=0; k<numPrimarySpecies; ++k )
+      int const i = stoichiometry.reactionSpecies( m ) - numSecondarySpecies;
+      if( i < 0 )
       {
-        REAL_TYPE const dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration = params.stoichiometricMatrix( j, k+numSecondarySpecies ) * secondarySpeciesConcentrations_j;
-        dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, k ) += params.stoichiometricMatrix( j, i+numSecondarySpecies ) *
-                                                                                                      dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration;
+        continue;
+      }
+      REAL_TYPE const s_ji = stoichiometry.reactionCoefficient( m );
+      aggregatePrimarySpeciesConcentrations[i] += s_ji * secondarySpeciesConcentrations_j;
+      for( int n = stoichiometry.reactionBegin( j ); n < stoichiometry.reactionEnd( j ); ++n )
+      {
+        int const k = stoichiometry.reactionSpecies( n ) - numSecondarySpecies;
+        if( k >= 0 )
+        {
+          REAL_TYPE const dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration = stoichiometry.reactionCoefficient( n ) * secondarySpeciesConcentrations_j;
+          dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, k ) += s_ji * dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration;
+        }
+      }
+    }
+  }
+}
+
+// Overload that stores the derivatives in packed symmetric storage.
+// dT/dlogCp = diag(Cp) + S^T diag(Cs) S is symmetric, so only the lower triangle is accumulated.
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE,
+          typename PARAMS_DATA,
+          typename ARRAY_1D_TO_CONST,
+          typename ARRAY_1D_PRIMARY,
+          typename ARRAY_1D_SECONDARY,
+          int N >
+HPCREACT_HOST_DEVICE
+inline
+void calculateAggregatePrimaryConcentrationsWrtLogC( PARAMS_DATA const & params,
+                                                     ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentrations,
+                                                     ARRAY_1D_SECONDARY & logSecondarySpeciesConcentrations,
+                                                     ARRAY_1D_PRIMARY & aggregatePrimarySpeciesConcentrations,
+                                                     symmetricMatrix< REAL_TYPE, int, N > & dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations )
+{
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
+  static_assert( N == numPrimarySpecies, "symmetric derivative matrix must be numPrimarySpecies x numPrimarySpecies" );
+
+  calculateLogSecondarySpeciesConcentration< REAL_TYPE,
+                                             INT_TYPE,
+                                             INDEX_TYPE >( params,
+                                                           logPrimarySpeciesConcentrations,
+                                                           logSecondarySpeciesConcentrations );
+  for( int i = 0; i < symmetricMatrix< REAL_TYPE, int, N >::size(); ++i )
+  {
+    dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations.m_data[i] = 0.0;
+  }
+
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    REAL_TYPE const speciesConcentration_i = exp( logPrimarySpeciesConcentrations[i] );
+    aggregatePrimarySpeciesConcentrations[i] = speciesConcentration_i;
+    dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, i ) = speciesConcentration_i;
+  }
+
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+  for( int j = 0; j < numSecondarySpecies; ++j )
+  {
+    REAL_TYPE const secondarySpeciesConcentrations_j = exp( logSecondarySpeciesConcentrations[j] );
+    for( int m = stoichiometry.reactionBegin( j ); m < stoichiometry.reactionEnd( j ); ++m )
+    {
+      int const i = stoichiometry.reactionSpecies( m ) - numSecondarySpecies;
+      if( i < 0 )
+      {
+        continue;
+      }
+      REAL_TYPE const s_ji = stoichiometry.reactionCoefficient( m );
+      aggregatePrimarySpeciesConcentrations[i] += s_ji * secondarySpeciesConcentrations_j;
+      // species are sorted within a reaction, so n <= m gives the lower triangle k <= i
+      for( int n = stoichiometry.reactionBegin( j ); n <= m; ++n )
+      {
+        int const k = stoichiometry.reactionSpecies( n ) - numSecondarySpecies;
+        if( k >= 0 )
+        {
+          REAL_TYPE const dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration = stoichiometry.reactionCoefficient( n ) * secondarySpeciesConcentrations_j;
+          dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, k ) += s_ji * dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration;
+        }
       }
     }
   }
@@ -238,22 +337,134 @@ void calculateTotalAndMobileAggregatePrimaryConcentrationsWrtLogC( PARAMS_DATA c
     mobileAggregatePrimarySpeciesConcentrations[i] = speciesConcentration_i;
     dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, i ) = speciesConcentration_i;
     dMobileAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, i ) = speciesConcentration_i;
+  }
+
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+  // each secondary species only contributes to the primary species in its reaction
+  for( int j = 0; j < numSecondarySpecies; ++j )
+  {
+    REAL_TYPE const secondarySpeciesConcentrations_j = exp( logSecondarySpeciesConcentrations[j] );
+    REAL_TYPE const mobileSecondarySpeciesFlag_j = params.mobileSecondarySpeciesFlag( j );
+    for( int m = stoichiometry.reactionBegin( j ); m < stoichiometry.reactionEnd( j ); ++m )
+    {
+      int const i = stoichiometry.reactionSpecies( m ) - numSecondarySpecies;
+      if( i < 0 )
+      {
+        continue;
+      }
+      REAL_TYPE const s_ji = stoichiometry.reactionCoefficient( m );
+      aggregatePrimarySpeciesConcentrations[i] += s_ji * secondarySpeciesConcentrations_j;
+      mobileAggregatePrimarySpeciesConcentrations[i] += s_ji * secondarySpeciesConcentrations_j * mobileSecondarySpeciesFlag_j;
+      for( int n = stoichiometry.reactionBegin( j ); n < stoichiometry.reactionEnd( j ); ++n )
+      {
+        int const k = stoichiometry.reactionSpecies( n ) - numSecondarySpecies;
+        if( k >= 0 )
+        {
+          REAL_TYPE const dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration = stoichiometry.reactionCoefficient( n ) * secondarySpeciesConcentrations_j;
+          dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, k ) += s_ji * dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration;
+          dMobileAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, k ) += s_ji *
+                                                                                                              dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration *
+                                                                                                              mobileSecondarySpeciesFlag_j;
+        }
+      }
+    }
+  }
+}
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE,
+          typename PARAMS_DATA,
+          typename ARRAY_1D_TO_CONST,
+          typename ARRAY_1D_PRIMARY,
+          typename ARRAY_1D_SECONDARY >
+HPCREACT_HOST_DEVICE
+inline
+void calculateAggregatePrimaryConcentrations( PARAMS_DATA const & params,
+                                              ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentrations,
+                                              ARRAY_1D_SECONDARY & logSecondarySpeciesConcentrations,
+                                              ARRAY_1D_PRIMARY & aggregatePrimarySpeciesConcentrations )
+{
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
+
+  calculateLogSecondarySpeciesConcentration< REAL_TYPE,
+                                             INT_TYPE,
+                                             INDEX_TYPE >( params,
+                                                           logPrimarySpeciesConcentrations,
+                                                           logSecondarySpeciesConcentrations );
 
-    for( int j = 0; j < numSecondarySpecies; ++j )
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    aggregatePrimarySpeciesConcentrations[i] = exp( logPrimarySpeciesConcentrations[i] );
+  }
+
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+  // the same accumulation as the WrtLogC version, without the O(nnz^2) derivative loop
+  for( int j = 0; j < numSecondarySpecies; ++j )
+  {
+    REAL_TYPE const secondarySpeciesConcentrations_j = exp( logSecondarySpeciesConcentrations[j] );
+    for( int m = stoichiometry.reactionBegin( j ); m < stoichiometry.reactionEnd( j ); ++m )
     {
-      REAL_TYPE const secondarySpeciesConcentrations_j = exp( logSecondarySpeciesConcentrations[j] );
-      aggregatePrimarySpeciesConcentrations[i] += params.stoichiometricMatrix( j, i+numSecondarySpecies ) * secondarySpeciesConcentrations_j;
-      mobileAggregatePrimarySpeciesConcentrations[i] += params.stoichiometricMatrix( j, i+numSecondarySpecies ) * secondarySpeciesConcentrations_j * params.mobileSecondarySpeciesFlag( j );
-      for( int k=0; k<numPrimarySpecies; ++k )
+      int const i = stoichiometry.reactionSpecies( m ) - numSecondarySpecies;
+      if( i >= 0 )
       {
-        REAL_TYPE const dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration = params.stoichiometricMatrix( j, k+numSecondarySpecies ) * secondarySpeciesConcentrations_j;
-        dAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, k ) += params.stoichiometricMatrix( j, i+numSecondarySpecies ) *
-                                                                                                      dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration;
+        aggregatePrimarySpeciesConcentrations[i] += stoichiometry.reactionCoefficient( m ) * secondarySpeciesConcentrations_j;
+      }
+    }
+  }
+}
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE,
+          typename PARAMS_DATA,
+          typename ARRAY_1D_TO_CONST,
+          typename ARRAY_1D_PRIMARY,
+          typename ARRAY_1D_SECONDARY >
+HPCREACT_HOST_DEVICE
+inline
+void calculateTotalAndMobileAggregatePrimaryConcentrations( PARAMS_DATA const & params,
+                                                            ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentrations,
+                                                            ARRAY_1D_SECONDARY & logSecondarySpeciesConcentrations,
+                                                            ARRAY_1D_PRIMARY & aggregatePrimarySpeciesConcentrations,
+                                                            ARRAY_1D_PRIMARY & mobileAggregatePrimarySpeciesConcentrations )
+{
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
 
-        dMobileAggregatePrimarySpeciesConcentrationsDerivatives_dLogPrimarySpeciesConcentrations( i, k ) += params.stoichiometricMatrix( j, i+numSecondarySpecies ) *
-                                                                                                            dSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentration *
-                                                                                                            params.mobileSecondarySpeciesFlag( j );
+  calculateLogSecondarySpeciesConcentration< REAL_TYPE,
+                                             INT_TYPE,
+                                             INDEX_TYPE >( params,
+                                                           logPrimarySpeciesConcentrations,
+                                                           logSecondarySpeciesConcentrations );
+
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    REAL_TYPE const speciesConcentration_i = exp( logPrimarySpeciesConcentrations[i] );
+    aggregatePrimarySpeciesConcentrations[i] = speciesConcentration_i;
+    mobileAggregatePrimarySpeciesConcentrations[i] = speciesConcentration_i;
+  }
+
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+  // the same accumulation as the WrtLogC version, without the O(nnz^2) derivative loop
+  for( int j = 0; j < numSecondarySpecies; ++j )
+  {
+    REAL_TYPE const secondarySpeciesConcentrations_j = exp( logSecondarySpeciesConcentrations[j] );
+    REAL_TYPE const mobileSecondarySpeciesFlag_j = params.mobileSecondarySpeciesFlag( j );
+    for( int m = stoichiometry.reactionBegin( j ); m < stoichiometry.reactionEnd( j ); ++m )
+    {
+      int const i = stoichiometry.reactionSpecies( m ) - numSecondarySpecies;
+      if( i < 0 )
+      {
+        continue;
       }
+      REAL_TYPE const s_ji = stoichiometry.reactionCoefficient( m );
+      aggregatePrimarySpeciesConcentrations[i] += s_ji * secondarySpeciesConcentrations_j;
+      mobileAggregatePrimarySpeciesConcentrations[i] += s_ji * secondarySpeciesConcentrations_j * mobileSecondarySpeciesFlag_j;
     }
   }
 }
@@ -13,6 +13,7 @@
 #include "reactions/geochemistry/GeochemicalSystems.hpp"
 #include "common/pmpl.hpp"
 #include "common/printers.hpp"
+#include "common/DualNumber.hpp"
 
 
 #include <gtest/gtest.h>
@@ -200,6 +201,81 @@ TEST( testMassActions, testcalculateAggregatePrimaryConcentrationsWrtLogC )
 }
 
 
+template< int numPrimarySpecies >
+struct DualNumberAggregatesData
+{
+  double const logPrimarySpeciesConcentrations[numPrimarySpecies] =
+  {
+    log( 0.00043969547214915125 ),
+    log( 0.00037230096984514874 ),
+    log( 0.014716565308128551 ),
+    log( 0.0024913722747387217 ),
+    log( 1.8586090945989489 ),
+    log( 0.009881874292035079 ),
+    log( 1.0723078278653704 )
+  };
+
+  double aggregatePrimarySpeciesConcentrations[numPrimarySpecies] = {0};
+  double mobileAggregatePrimarySpeciesConcentrations[numPrimarySpecies] = {0};
+  CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations;
+  CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations;
+
+  DualNumber< double, numPrimarySpecies > aggregatePrimarySpeciesConcentrationsDual[numPrimarySpecies];
+  DualNumber< double, numPrimarySpecies > mobileAggregatePrimarySpeciesConcentrationsDual[numPrimarySpecies];
+};
+
+void testDualNumberAggregatesHelper()
+{
+  static constexpr int numPrimarySpecies = carbonateSystem.numPrimarySpecies();
+  static constexpr int numSecondarySpecies = carbonateSystem.numSecondarySpecies();
+  using DualType = DualNumber< double, numPrimarySpecies >;
+
+  DualNumberAggregatesData< numPrimarySpecies > data;
+
+  pmpl::genericKernelWrapper( 1, &data, [] HPCREACT_DEVICE ( auto * const dataCopy )
+  {
+    double logSecondarySpeciesConcentrations[numSecondarySpecies];
+    calculateTotalAndMobileAggregatePrimaryConcentrationsWrtLogC< double, int, int >( carbonateSystem.equilibriumReactionsParameters(),
+                                                                                      dataCopy->logPrimarySpeciesConcentrations,
+                                                                                      logSecondarySpeciesConcentrations,
+                                                                                      dataCopy->aggregatePrimarySpeciesConcentrations,
+                                                                                      dataCopy->mobileAggregatePrimarySpeciesConcentrations,
+                                                                                      dataCopy->dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations,
+                                                                                      dataCopy->dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations );
+
+    DualType logPrimarySpeciesConcentrationsDual[numPrimarySpecies];
+    DualType logSecondarySpeciesConcentrationsDual[numSecondarySpecies];
+    dualNumbers::makeIndependentVariables( dataCopy->logPrimarySpeciesConcentrations, logPrimarySpeciesConcentrationsDual );
+    calculateTotalAndMobileAggregatePrimaryConcentrations< DualType, int, int >( carbonateSystem.equilibriumReactionsParameters(),
+                                                                                 logPrimarySpeciesConcentrationsDual,
+                                                                                 logSecondarySpeciesConcentrationsDual,
+                                                                                 dataCopy->aggregatePrimarySpeciesConcentrationsDual,
+                                                                                 dataCopy->mobileAggregatePrimarySpeciesConcentrationsDual );
+  } );
+
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    EXPECT_NEAR( data.aggregatePrimarySpeciesConcentrationsDual[i].value,
+                 data.aggregatePrimarySpeciesConcentrations[i],
+                 1.0e-14 * fabs( data.aggregatePrimarySpeciesConcentrations[i] ) );
+    EXPECT_NEAR( data.mobileAggregatePrimarySpeciesConcentrationsDual[i].value,
+                 data.mobileAggregatePrimarySpeciesConcentrations[i],
+                 1.0e-14 * fabs( data.mobileAggregatePrimarySpeciesConcentrations[i] ) );
+    for( int j = 0; j < numPrimarySpecies; ++j )
+    {
+      double const expected = data.dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations( i, j );
+      double const expectedMobile = data.dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations( i, j );
+      EXPECT_NEAR( data.aggregatePrimarySpeciesConcentrationsDual[i].derivatives[j], expected, 1.0e-14 * fabs( expected ) + 1.0e-300 );
+      EXPECT_NEAR( data.mobileAggregatePrimarySpeciesConcentrationsDual[i].derivatives[j], expectedMobile, 1.0e-14 * fabs( expectedMobile ) + 1.0e-300 );
+    }
+  }
+}
+
+TEST( testMassActions, testDualNumberAggregates )
+{
+  testDualNumberAggregatesHelper();
+}
+
 int main( int argc, char * * argv )
 {
   ::testing::InitGoogleTest( &argc, argv );
@@ -14,6 +14,8 @@
 #include "common/macros.hpp"
 #include "common/CArrayWrapper.hpp"
 #include "common/DirectSystemSolve.hpp"
+#include "common/integerPower.hpp"
+#include "common/nonlinearSolvers.hpp"
 #include "common/printers.hpp"
 
 #include <iostream>
@@ -53,33 +55,43 @@ public:
   /**
    * @brief This method enforces equilibrium for a given set of species using
    *        reaction extents.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
    * @param temperature The temperature of the system.
    * @param params The parameters for the equilibrium reactions.
    * @param speciesConcentration0 The initial species concentrations.
    * @param speciesConcentration The species concentrations to be updated.
+   * @param controls The convergence criteria and iteration limit. The
+   *        residual is the vector of reaction quotient residuals.
+   * @return The statistics of the nonlinear solve.
    * @details This method uses the reaction extents to enforce equilibrium
    *          for a given set of species. It uses the computeResidualAndJacobian
    *          method to compute the residual and jacobian for the system and
    *          then uses a direct solver to solve the system. The solution is
    *          then used to update the species concentrations.
    */
-  template< typename PARAMS_DATA,
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
             typename ARRAY_1D,
             typename ARRAY_1D_TO_CONST >
   static HPCREACT_HOST_DEVICE
-  void
+  nonlinearSolvers::SolverStats
   enforceEquilibrium_Extents( RealType const & temperature,
                               PARAMS_DATA const & params,
                               ARRAY_1D_TO_CONST const & speciesConcentration0,
-                              ARRAY_1D & speciesConcentration );
+                              ARRAY_1D & speciesConcentration,
+                              nonlinearSolvers::SolverControls< PARAMS_DATA::numReactions() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numReactions() >( 30, 1.0e-12 ) );
 
   /**
    * @brief This method enforces equilibrium for a given set of species using
    *        aggregate primary concentrations.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
    * @param temperature The temperature of the system.
    * @param params The parameters for the equilibrium reactions.
    * @param speciesConcentration0 The initial species concentrations.
    * @param speciesConcentration The species concentrations to be updated.
+   * @param controls The convergence criteria and iteration limit, see
+   *        enforceEquilibrium_Aggregate.
+   * @return The statistics of the nonlinear solve.
    * @details This method uses the aggregate primary concentrations to enforce
    *          equilibrium for a given set of species. It uses the
    *          computeResidualAndJacobianAggregatePrimaryConcentrations method to
@@ -87,20 +99,23 @@ public:
    *          direct solver to solve the system. The solution is then used to
    *          update the species concentrations.
    */
-  template< typename PARAMS_DATA,
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
             typename ARRAY_1D,
             typename ARRAY_1D_TO_CONST >
   static HPCREACT_HOST_DEVICE
-  void
+  nonlinearSolvers::SolverStats
   enforceEquilibrium_LogAggregate( RealType const & temperature,
                                    PARAMS_DATA const & params,
                                    ARRAY_1D_TO_CONST const & speciesConcentration0,
-                                   ARRAY_1D & speciesConcentration );
+                                   ARRAY_1D & speciesConcentration,
+                                   nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() >( 150, 1.0e-12 ) );
 
 
   /**
    * @brief This method enforces equilibrium for a given set of species using
    *        log of aggregate primary concentrations.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
    * @tparam PARAMS_DATA The type of the parameters data.
    * @tparam ARRAY_1D The type of the array of species concentrations.
    * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
@@ -111,22 +126,170 @@ public:
    * @param logPrimarySpeciesConcentration0 The initial value of the log of
    *        the primary species concentrations.
    * @param speciesConcentration The species concentrations to be updated.
+   * @param controls The convergence criteria and iteration limit. The
+   *        residual is the aggregate concentration residual relative to the
+   *        target aggregate concentrations.
+   * @return The statistics of the nonlinear solve.
    * @details This method uses the log of aggregate primary concentrations to enforce
    *          equilibrium for a given set of species. It uses the
    *          computeResidualAndJacobianLogAggregate method to compute the residual and
    *          jacobian for the system and then uses a direct solver to solve the system.
    *          The solution is then used to update the species concentrations.
    */
-  template< typename PARAMS_DATA,
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
             typename ARRAY_1D,
             typename ARRAY_1D_TO_CONST >
   static HPCREACT_HOST_DEVICE
-  void
+  nonlinearSolvers::SolverStats
   enforceEquilibrium_Aggregate( RealType const & temperature,
                                 PARAMS_DATA const & params,
                                 ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration,
                                 ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
-                                ARRAY_1D & speciesConcentration );
+                                ARRAY_1D & speciesConcentration,
+                                nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() >( 150, 1.0e-12 ) );
+
+  /**
+   * @brief Warm started variant of enforceEquilibrium_LogAggregate.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam ARRAY_1D The type of the array of species concentrations.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
+   * @param temperature The temperature of the system.
+   * @param params The parameters for the equilibrium reactions.
+   * @param logPrimarySpeciesConcentration0 The log of the primary species
+   *        concentrations defining the targets, and the cold start guess.
+   * @param logPrimarySpeciesConcentration The log of the primary species concentrations to be updated.
+   * @param warmStart The persistent state of the cell, see enforceEquilibrium_Aggregate.
+   * @param controls The convergence criteria and iteration limit.
+   * @return The statistics of the nonlinear solve.
+   */
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
+            typename ARRAY_1D,
+            typename ARRAY_1D_TO_CONST >
+  static HPCREACT_HOST_DEVICE
+  nonlinearSolvers::SolverStats
+  enforceEquilibrium_LogAggregate( RealType const & temperature,
+                                   PARAMS_DATA const & params,
+                                   ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
+                                   ARRAY_1D & logPrimarySpeciesConcentration,
+                                   nonlinearSolvers::WarmStartState< double, PARAMS_DATA::numPrimarySpecies() > & warmStart,
+                                   nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() >( 150, 1.0e-12 ) );
+
+  /**
+   * @brief Warm started variant of enforceEquilibrium_Aggregate.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam ARRAY_1D The type of the array of species concentrations.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
+   * @param temperature The temperature of the system.
+   * @param params The parameters for the equilibrium reactions.
+   * @param targetAggregatePrimarySpeciesConcentration The target aggregate
+   *        primary species concentration.
+   * @param logPrimarySpeciesConcentration0 The cold start guess of the log of
+   *        the primary species concentrations.
+   * @param logPrimarySpeciesConcentration The log of the primary species concentrations to be updated.
+   * @param warmStart The persistent state of the cell. The solve starts from
+   *        its last converged solution and factorization when available, and
+   *        falls back to enforceEquilibrium_Aggregate from
+   *        @p logPrimarySpeciesConcentration0 otherwise.
+   * @param controls The convergence criteria and iteration limit, see
+   *        enforceEquilibrium_Aggregate.
+   * @return The accumulated statistics of the warm and cold start.
+   * @details See nonlinearSolvers::WarmStartState for the memory cost of the state.
+   */
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
+            typename ARRAY_1D,
+            typename ARRAY_1D_TO_CONST >
+  static HPCREACT_HOST_DEVICE
+  nonlinearSolvers::SolverStats
+  enforceEquilibrium_Aggregate( RealType const & temperature,
+                                PARAMS_DATA const & params,
+                                ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration,
+                                ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
+                                ARRAY_1D & logPrimarySpeciesConcentration,
+                                nonlinearSolvers::WarmStartState< double, PARAMS_DATA::numPrimarySpecies() > & warmStart,
+                                nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() >( 150, 1.0e-12 ) );
+
+  /**
+   * @brief Symmetric variant of enforceEquilibrium_Aggregate.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam ARRAY_1D The type of the array of species concentrations.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
+   * @param temperature The temperature of the system.
+   * @param params The parameters for the equilibrium reactions.
+   * @param targetAggregatePrimarySpeciesConcentration The target aggregate
+   *        primary species concentration.
+   * @param logPrimarySpeciesConcentration0 The initial value of the log of
+   *        the primary species concentrations.
+   * @param logPrimarySpeciesConcentration The log of the primary species concentrations to be updated.
+   * @param controls The convergence criteria and iteration limit, see
+   *        enforceEquilibrium_Aggregate. The update criterion applies to the
+   *        change of the log concentrations.
+   * @return The statistics of the nonlinear solve.
+   * @details Solves the same nonlinear system as enforceEquilibrium_Aggregate,
+   *          but does not apply the 1/target row scaling to the Jacobian. The
+   *          Jacobian dT/dlogCp = diag(Cp) + S^T diag(Cs) S is then symmetric
+   *          positive definite, so it stays in packed symmetric storage from
+   *          assembly to factorization and the Newton updates are solved with
+   *          ScaledCholeskySolver, which falls back to a pivoted LU if the
+   *          factorization fails. Iteration
+   *          control and globalization are those of enforceEquilibrium_Aggregate.
+   */
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
+            typename ARRAY_1D,
+            typename ARRAY_1D_TO_CONST >
+  static HPCREACT_HOST_DEVICE
+  nonlinearSolvers::SolverStats
+  enforceEquilibrium_AggregateSymmetric( RealType const & temperature,
+                                         PARAMS_DATA const & params,
+                                         ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration,
+                                         ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
+                                         ARRAY_1D & logPrimarySpeciesConcentration,
+                                         nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() >( 150, 1.0e-12 ) );
+
+  /**
+   * @brief Jacobian-free variant of enforceEquilibrium_Aggregate.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam ARRAY_1D The type of the array of species concentrations.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
+   * @param temperature The temperature of the system.
+   * @param params The parameters for the equilibrium reactions.
+   * @param targetAggregatePrimarySpeciesConcentration The target aggregate
+   *        primary species concentration.
+   * @param logPrimarySpeciesConcentration0 The initial value of the log of
+   *        the primary species concentrations.
+   * @param logPrimarySpeciesConcentration The log of the primary species concentrations to be updated.
+   * @param controls The convergence criteria and iteration limit, applied to
+   *        the log-ratio residual log( ( T_i + N_i ) / P_i ).
+   * @return The statistics of the nonlinear solve.
+   * @details The aggregate concentration of primary species i is split into
+   *          the contributions P_i of the primary species and of the secondary
+   *          species with a positive stoichiometric coefficient, and N_i of
+   *          those with a negative one. The fixed-point update
+   *          logCp_i += log( ( T_i + N_i ) / P_i ) is then accelerated with
+   *          nonlinearSolvers::andersonAcceleration. No Jacobian is assembled,
+   *          which makes this cheap for re-equilibrations from a nearby state,
+   *          e.g. after transport. The targets should be positive; otherwise
+   *          enforceEquilibrium_Aggregate is the more robust choice.
+   */
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
+            typename ARRAY_1D,
+            typename ARRAY_1D_TO_CONST >
+  static HPCREACT_HOST_DEVICE
+  nonlinearSolvers::SolverStats
+  enforceEquilibrium_AggregateAnderson( RealType const & temperature,
+                                        PARAMS_DATA const & params,
+                                        ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration,
+                                        ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
+                                        ARRAY_1D & logPrimarySpeciesConcentration,
+                                        nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() >( 100, 1.0e-12 ) );
 
   /**
    * @brief This method computes the residual and jacobian when using reaction extents to solve
@@ -183,6 +346,57 @@ public:
                                                             ARRAY_1D_TO_CONST2 const & logPrimarySpeciesConcentration,
                                                             ARRAY_1D & residual,
                                                             ARRAY_2D & jacobian );
+
+  /**
+   * @brief This method computes only the residual of
+   *        computeResidualAndJacobianAggregatePrimaryConcentrations, without
+   *        the derivatives of the aggregate primary concentrations.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam ARRAY_1D The type of the array of species concentrations.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of target aggregate primary concentrations.
+   * @tparam ARRAY_1D_TO_CONST2 The type of the array of log primary species concentrations.
+   * @param temperature The temperature of the system.
+   * @param params The parameters for the equilibrium reactions.
+   * @param targetAggregatePrimaryConcentrations The target aggregate primary concentrations.
+   * @param logPrimarySpeciesConcentration The log of the primary species concentrations.
+   * @param residual The residual.
+   */
+  template< typename PARAMS_DATA,
+            typename ARRAY_1D,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_1D_TO_CONST2 >
+  static HPCREACT_HOST_DEVICE void
+  computeResidualAggregatePrimaryConcentrations( RealType const & temperature,
+                                                 PARAMS_DATA const & params,
+                                                 ARRAY_1D_TO_CONST const & targetAggregatePrimaryConcentrations,
+                                                 ARRAY_1D_TO_CONST2 const & logPrimarySpeciesConcentration,
+                                                 ARRAY_1D & residual );
+
+  /**
+   * @brief This method computes the unscaled residual and the symmetric jacobian
+   *        of the aggregate primary concentrations.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam ARRAY_1D The type of the array of species concentrations.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of target aggregate primary concentrations.
+   * @tparam ARRAY_1D_TO_CONST2 The type of the array of log primary species concentrations.
+   * @param temperature The temperature of the system.
+   * @param params The parameters for the equilibrium reactions.
+   * @param targetAggregatePrimaryConcentrations The target aggregate primary concentrations.
+   * @param logPrimarySpeciesConcentration The log of the primary species concentrations.
+   * @param residual The residual, T - target.
+   * @param jacobian The jacobian dT/dlogCp in packed symmetric storage.
+   */
+  template< typename PARAMS_DATA,
+            typename ARRAY_1D,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_1D_TO_CONST2 >
+  static HPCREACT_HOST_DEVICE void
+  computeResidualAndJacobianAggregatePrimaryConcentrations( RealType const & temperature,
+                                                            PARAMS_DATA const & params,
+                                                            ARRAY_1D_TO_CONST const & targetAggregatePrimaryConcentrations,
+                                                            ARRAY_1D_TO_CONST2 const & logPrimarySpeciesConcentration,
+                                                            ARRAY_1D & residual,
+                                                            symmetricMatrix< RealType, int, PARAMS_DATA::numPrimarySpecies() > & jacobian );
 };
 
 
@@ -66,16 +66,189 @@ template< typename REAL_TYPE,
           typename INT_TYPE,
           typename INDEX_TYPE >
 template< typename PARAMS_DATA,
+          typename ARRAY_1D,
+          typename ARRAY_1D_TO_CONST,
+          typename ARRAY_1D_TO_CONST2 >
+HPCREACT_HOST_DEVICE
+inline
+void
+EquilibriumReactions< REAL_TYPE,
+                      INT_TYPE,
+                      INDEX_TYPE >::computeResidualAggregatePrimaryConcentrations( RealType const & temperature,
+                                                                                   PARAMS_DATA const & params,
+                                                                                   ARRAY_1D_TO_CONST const & targetAggregatePrimaryConcentrations,
+                                                                                   ARRAY_1D_TO_CONST2 const & logPrimarySpeciesConcentration,
+                                                                                   ARRAY_1D & residual )
+{
+  HPCREACT_UNUSED_VAR( temperature );
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
+
+  RealType logSecondarySpeciesConcentrations[numSecondarySpecies] = {0.0};
+  RealType aggregatePrimaryConcentrations[numPrimarySpecies] = {0.0};
+  massActions::calculateAggregatePrimaryConcentrations< REAL_TYPE, INT_TYPE, INDEX_TYPE >( params,
+                                                                                           logPrimarySpeciesConcentration,
+                                                                                           logSecondarySpeciesConcentrations,
+                                                                                           aggregatePrimaryConcentrations );
+
+  for( IndexType i=0; i<numPrimarySpecies; ++i )
+  {
+    residual[i] = -(1.0 - aggregatePrimaryConcentrations[i] / targetAggregatePrimaryConcentrations[i]);
+  }
+}
+
+namespace internal
+{
+
+/**
+ * @brief Residual and Jacobian of the aggregate primary concentration equilibrium.
+ * @tparam EQUILIBRIUM_REACTIONS The EquilibriumReactions type.
+ * @tparam PARAMS_DATA The type of the parameters data.
+ * @tparam ARRAY_1D_TO_CONST The type of the target aggregate concentrations.
+ * @details The Jacobian is returned as d(residual)/d(logCp), as expected by
+ *          the nonlinear solvers, i.e. the negative of the one assembled by
+ *          computeResidualAndJacobianAggregatePrimaryConcentrations.
+ */
+template< typename EQUILIBRIUM_REACTIONS, typename PARAMS_DATA, typename ARRAY_1D_TO_CONST >
+struct AggregateResidualAndJacobian
+{
+  /// The number of unknowns.
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+
+  /// The temperature of the system.
+  typename EQUILIBRIUM_REACTIONS::RealType const & temperature;
+  /// The parameters for the equilibrium reactions.
+  PARAMS_DATA const & params;
+  /// The target aggregate primary species concentration.
+  ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration;
+
+  /**
+   * @brief Evaluate the residual and Jacobian.
+   * @param logCp The log of the primary species concentrations.
+   * @param residual The residual.
+   * @param J The Jacobian.
+   */
+  HPCREACT_HOST_DEVICE
+  void operator()( double const (&logCp)[numPrimarySpecies],
+                   double (& residual)[numPrimarySpecies],
+                   double (& J)[numPrimarySpecies][numPrimarySpecies] ) const
+  {
+    CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > jacobian;
+    EQUILIBRIUM_REACTIONS::computeResidualAndJacobianAggregatePrimaryConcentrations( temperature,
+                                                                                      params,
+                                                                                      targetAggregatePrimarySpeciesConcentration,
+                                                                                      logCp,
+                                                                                      residual,
+                                                                                      jacobian );
+    for( int i = 0; i < numPrimarySpecies; ++i )
+    {
+      for( int j = 0; j < numPrimarySpecies; ++j )
+      {
+        J[i][j] = -jacobian( i, j );
+      }
+    }
+  }
+};
+
+/**
+ * @brief Residual of the aggregate primary concentration equilibrium, for the
+ *        solvers that reuse a factored Jacobian.
+ * @tparam EQUILIBRIUM_REACTIONS The EquilibriumReactions type.
+ * @tparam PARAMS_DATA The type of the parameters data.
+ * @tparam ARRAY_1D_TO_CONST The type of the target aggregate concentrations.
+ * @details The same residual as AggregateResidualAndJacobian, without
+ *          assembling the derivatives.
+ */
+template< typename EQUILIBRIUM_REACTIONS, typename PARAMS_DATA, typename ARRAY_1D_TO_CONST >
+struct AggregateResidual
+{
+  /// The number of unknowns.
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+
+  /// The temperature of the system.
+  typename EQUILIBRIUM_REACTIONS::RealType const & temperature;
+  /// The parameters for the equilibrium reactions.
+  PARAMS_DATA const & params;
+  /// The target aggregate primary species concentration.
+  ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration;
+
+  /**
+   * @brief Evaluate the residual.
+   * @param logCp The log of the primary species concentrations.
+   * @param residual The residual.
+   */
+  HPCREACT_HOST_DEVICE
+  void operator()( double const (&logCp)[numPrimarySpecies],
+                   double (& residual)[numPrimarySpecies] ) const
+  {
+    EQUILIBRIUM_REACTIONS::computeResidualAggregatePrimaryConcentrations( temperature,
+                                                                          params,
+                                                                          targetAggregatePrimarySpeciesConcentration,
+                                                                          logCp,
+                                                                          residual );
+  }
+};
+
+/**
+ * @brief Residual and Jacobian callback of the symmetric aggregate primary
+ *        concentration system, for the nonlinear solvers.
+ * @details The residual is T - T_target and the Jacobian dT/dlogCp, without
+ *          the row scaling of AggregateResidualAndJacobian, so the Jacobian is
+ *          symmetric positive definite. It is assembled directly in the
+ *          packed symmetric storage newtonRaphson provides for
+ *          ScaledCholeskySolver.
+ */
+template< typename EQUILIBRIUM_REACTIONS, typename PARAMS_DATA, typename ARRAY_1D_TO_CONST >
+struct AggregateSymmetricResidualAndJacobian
+{
+  /// The number of unknowns.
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+
+  /// The temperature of the system.
+  typename EQUILIBRIUM_REACTIONS::RealType const & temperature;
+  /// The parameters for the equilibrium reactions.
+  PARAMS_DATA const & params;
+  /// The target aggregate primary species concentration.
+  ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration;
+
+  /**
+   * @brief Evaluate the residual and Jacobian.
+   * @param logCp The log of the primary species concentrations.
+   * @param residual The residual.
+   * @param jacobian The Jacobian.
+   */
+  HPCREACT_HOST_DEVICE
+  void operator()( double const (&logCp)[numPrimarySpecies],
+                   double (& residual)[numPrimarySpecies],
+                   symmetricMatrix< double, int, numPrimarySpecies > & jacobian ) const
+  {
+    EQUILIBRIUM_REACTIONS::computeResidualAndJacobianAggregatePrimaryConcentrations( temperature,
+                                                                                      params,
+                                                                                      targetAggregatePrimarySpeciesConcentration,
+                                                                                      logCp,
+                                                                                      residual,
+                                                                                      jacobian );
+  }
+};
+
+} // namespace internal
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE >
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
           typename ARRAY_1D,
           typename ARRAY_1D_TO_CONST >
 HPCREACT_HOST_DEVICE inline
-void
+nonlinearSolvers::SolverStats
 EquilibriumReactions< REAL_TYPE,
                       INT_TYPE,
                       INDEX_TYPE >::enforceEquilibrium_LogAggregate( REAL_TYPE const & temperature,
                                                                      PARAMS_DATA const & params,
                                                                      ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
-                                                                     ARRAY_1D & logPrimarySpeciesConcentration )
+                                                                     ARRAY_1D & logPrimarySpeciesConcentration,
+                                                                     nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls )
 {
   HPCREACT_UNUSED_VAR( temperature );
   static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
@@ -88,11 +261,12 @@ EquilibriumReactions< REAL_TYPE,
     targetAggregatePrimarySpeciesConcentration[i] = exp( logPrimarySpeciesConcentration0[i] );
   }
 
-  enforceEquilibrium_Aggregate( temperature,
-                                params,
-                                targetAggregatePrimarySpeciesConcentration,
-                                logPrimarySpeciesConcentration0,
-                                logPrimarySpeciesConcentration );
+  return enforceEquilibrium_Aggregate< LOGGING_POLICY >( temperature,
+                                                         params,
+                                                         targetAggregatePrimarySpeciesConcentration,
+                                                         logPrimarySpeciesConcentration0,
+                                                         logPrimarySpeciesConcentration,
+                                                         controls );
 
 }
 
@@ -100,89 +274,348 @@ EquilibriumReactions< REAL_TYPE,
 template< typename REAL_TYPE,
           typename INT_TYPE,
           typename INDEX_TYPE >
-template< typename PARAMS_DATA,
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
           typename ARRAY_1D,
           typename ARRAY_1D_TO_CONST >
 HPCREACT_HOST_DEVICE inline
-void
+nonlinearSolvers::SolverStats
 EquilibriumReactions< REAL_TYPE,
                       INT_TYPE,
                       INDEX_TYPE >::enforceEquilibrium_Aggregate( REAL_TYPE const & temperature,
                                                                   PARAMS_DATA const & params,
                                                                   ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration,
                                                                   ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
-                                                                  ARRAY_1D & logPrimarySpeciesConcentration )
+                                                                  ARRAY_1D & logPrimarySpeciesConcentration,
+                                                                  nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls )
 {
+  nonlinearSolvers::SolverStats stats;
   if constexpr( PARAMS_DATA::numSecondarySpecies() <= 0 )
   {
-    return;
+    stats.isConverged = true;
+    return stats;
   }
 
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+
+  double logCp[numPrimarySpecies] = { 0.0 };
+  for( int i=0; i<numPrimarySpecies; ++i )
+  {
+    logCp[i] = logPrimarySpeciesConcentration0[i];
+  }
+
+  internal::AggregateResidualAndJacobian< EquilibriumReactions, PARAMS_DATA, ARRAY_1D_TO_CONST >
+  computeResidualAndJacobian{ temperature, params, targetAggregatePrimarySpeciesConcentration };
+
+  // limit the change of a concentration to a factor e^10 per iteration
+  nonlinearSolvers::BacktrackingLineSearch lineSearch;
+  lineSearch.maxUpdate = 10.0;
+  stats = nonlinearSolvers::newtonRaphson< numPrimarySpecies, LOGGING_POLICY >( logCp,
+                                                                                computeResidualAndJacobian,
+                                                                                controls,
+                                                                                PivotedLUSolver{},
+                                                                                lineSearch );
+
+  for( int i=0; i<numPrimarySpecies; ++i )
+  {
+    logPrimarySpeciesConcentration[i] = logCp[i];
+  }
+  return stats;
+}
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE >
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
+          typename ARRAY_1D,
+          typename ARRAY_1D_TO_CONST >
+HPCREACT_HOST_DEVICE inline
+nonlinearSolvers::SolverStats
+EquilibriumReactions< REAL_TYPE,
+                      INT_TYPE,
+                      INDEX_TYPE >::enforceEquilibrium_LogAggregate( REAL_TYPE const & temperature,
+                                                                     PARAMS_DATA const & params,
+                                                                     ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
+                                                                     ARRAY_1D & logPrimarySpeciesConcentration,
+                                                                     nonlinearSolvers::WarmStartState< double, PARAMS_DATA::numPrimarySpecies() > & warmStart,
+                                                                     nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls )
+{
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+  double targetAggregatePrimarySpeciesConcentration[numPrimarySpecies] = { 0.0 };
+  double logInitialPrimarySpeciesConcentration[numPrimarySpecies] = { 0.0 };
+
+  for( int i=0; i<numPrimarySpecies; ++i )
+  {
+    targetAggregatePrimarySpeciesConcentration[i] = exp( logPrimarySpeciesConcentration0[i] );
+    logInitialPrimarySpeciesConcentration[i] = logPrimarySpeciesConcentration0[i];
+  }
+
+  return enforceEquilibrium_Aggregate< LOGGING_POLICY >( temperature,
+                                                         params,
+                                                         targetAggregatePrimarySpeciesConcentration,
+                                                         logInitialPrimarySpeciesConcentration,
+                                                         logPrimarySpeciesConcentration,
+                                                         warmStart,
+                                                         controls );
+}
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE >
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
+          typename ARRAY_1D,
+          typename ARRAY_1D_TO_CONST >
+HPCREACT_HOST_DEVICE inline
+nonlinearSolvers::SolverStats
+EquilibriumReactions< REAL_TYPE,
+                      INT_TYPE,
+                      INDEX_TYPE >::enforceEquilibrium_Aggregate( REAL_TYPE const & temperature,
+                                                                  PARAMS_DATA const & params,
+                                                                  ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration,
+                                                                  ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
+                                                                  ARRAY_1D & logPrimarySpeciesConcentration,
+                                                                  nonlinearSolvers::WarmStartState< double, PARAMS_DATA::numPrimarySpecies() > & warmStart,
+                                                                  nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls )
+{
+  nonlinearSolvers::SolverStats stats;
+  if constexpr( PARAMS_DATA::numSecondarySpecies() <= 0 )
+  {
+    stats.isConverged = true;
+    return stats;
+  }
+
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+
+  double logCp[numPrimarySpecies] = { 0.0 };
+  for( int i=0; i<numPrimarySpecies; ++i )
+  {
+    logCp[i] = logPrimarySpeciesConcentration0[i];
+  }
+
+  internal::AggregateResidual< EquilibriumReactions, PARAMS_DATA, ARRAY_1D_TO_CONST >
+  computeResidual{ temperature, params, targetAggregatePrimarySpeciesConcentration };
+  internal::AggregateResidualAndJacobian< EquilibriumReactions, PARAMS_DATA, ARRAY_1D_TO_CONST >
+  computeResidualAndJacobian{ temperature, params, targetAggregatePrimarySpeciesConcentration };
+
+  // the same globalization as the cold start of enforceEquilibrium_Aggregate
+  nonlinearSolvers::BacktrackingLineSearch lineSearch;
+  lineSearch.maxUpdate = 10.0;
+  stats = nonlinearSolvers::newtonRaphsonWarmStart< numPrimarySpecies, LOGGING_POLICY >( logCp,
+                                                                                         computeResidual,
+                                                                                         computeResidualAndJacobian,
+                                                                                         warmStart,
+                                                                                         controls,
+                                                                                         PivotedLUSolver{},
+                                                                                         lineSearch );
+
+  for( int i=0; i<numPrimarySpecies; ++i )
+  {
+    logPrimarySpeciesConcentration[i] = logCp[i];
+  }
+  return stats;
+}
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE >
+template< typename PARAMS_DATA,
+          typename ARRAY_1D,
+          typename ARRAY_1D_TO_CONST,
+          typename ARRAY_1D_TO_CONST2 >
+HPCREACT_HOST_DEVICE
+inline
+void
+EquilibriumReactions< REAL_TYPE,
+                      INT_TYPE,
+                      INDEX_TYPE >::computeResidualAndJacobianAggregatePrimaryConcentrations( RealType const & temperature,
+                                                                                              PARAMS_DATA const & params,
+                                                                                              ARRAY_1D_TO_CONST const & targetAggregatePrimaryConcentrations,
+                                                                                              ARRAY_1D_TO_CONST2 const & logPrimarySpeciesConcentration,
+                                                                                              ARRAY_1D & residual,
+                                                                                              symmetricMatrix< RealType, int, PARAMS_DATA::numPrimarySpecies() > & jacobian )
+{
   HPCREACT_UNUSED_VAR( temperature );
   static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
+
+  RealType aggregatePrimaryConcentrations[numPrimarySpecies] = {0.0};
+  RealType logSecondarySpeciesConcentrations[numSecondarySpecies] = {0.0};
+  massActions::calculateAggregatePrimaryConcentrationsWrtLogC< REAL_TYPE, INT_TYPE, INDEX_TYPE >( params,
+                                                                                                  logPrimarySpeciesConcentration,
+                                                                                                  logSecondarySpeciesConcentrations,
+                                                                                                  aggregatePrimaryConcentrations,
+                                                                                                  jacobian );
+
+  for( IndexType i=0; i<numPrimarySpecies; ++i )
+  {
+    residual[i] = aggregatePrimaryConcentrations[i] - targetAggregatePrimaryConcentrations[i];
+  }
+}
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE >
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
+          typename ARRAY_1D,
+          typename ARRAY_1D_TO_CONST >
+HPCREACT_HOST_DEVICE inline
+nonlinearSolvers::SolverStats
+EquilibriumReactions< REAL_TYPE,
+                      INT_TYPE,
+                      INDEX_TYPE >::enforceEquilibrium_AggregateSymmetric( REAL_TYPE const & temperature,
+                                                                           PARAMS_DATA const & params,
+                                                                           ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration,
+                                                                           ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
+                                                                           ARRAY_1D & logPrimarySpeciesConcentration,
+                                                                           nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls )
+{
+  nonlinearSolvers::SolverStats stats;
+  if constexpr( PARAMS_DATA::numSecondarySpecies() <= 0 )
+  {
+    stats.isConverged = true;
+    return stats;
+  }
+
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+
+  double logCp[numPrimarySpecies] = { 0.0 };
+  for( int i=0; i<numPrimarySpecies; ++i )
+  {
+    logCp[i] = logPrimarySpeciesConcentration0[i];
+  }
+
+  internal::AggregateSymmetricResidualAndJacobian< EquilibriumReactions, PARAMS_DATA, ARRAY_1D_TO_CONST >
+  computeResidualAndJacobian{ temperature, params, targetAggregatePrimarySpeciesConcentration };
 
-  double residual[numPrimarySpecies] = { 0.0 };
-//  double aggregatePrimarySpeciesConcentration[numPrimarySpecies] = { 0.0 };
-  double dLogCp[numPrimarySpecies] = { 0.0 };
-  CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > jacobian;
+  // converge on the same relative residual as enforceEquilibrium_Aggregate
+  nonlinearSolvers::SolverControls< numPrimarySpecies > relativeControls = controls;
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    relativeControls.residualWeights[i] /= targetAggregatePrimarySpeciesConcentration[i];
+  }
+
+  // the same globalization as enforceEquilibrium_Aggregate
+  nonlinearSolvers::BacktrackingLineSearch lineSearch;
+  lineSearch.maxUpdate = 10.0;
+  stats = nonlinearSolvers::newtonRaphson< numPrimarySpecies, LOGGING_POLICY >( logCp,
+                                                                                computeResidualAndJacobian,
+                                                                                relativeControls,
+                                                                                ScaledCholeskySolver{},
+                                                                                lineSearch );
 
   for( int i=0; i<numPrimarySpecies; ++i )
   {
-    logPrimarySpeciesConcentration[i] = logPrimarySpeciesConcentration0[i];
+    logPrimarySpeciesConcentration[i] = logCp[i];
   }
+  return stats;
+}
 
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE >
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
+          typename ARRAY_1D,
+          typename ARRAY_1D_TO_CONST >
+HPCREACT_HOST_DEVICE inline
+nonlinearSolvers::SolverStats
+EquilibriumReactions< REAL_TYPE,
+                      INT_TYPE,
+                      INDEX_TYPE >::enforceEquilibrium_AggregateAnderson( REAL_TYPE const & temperature,
+                                                                          PARAMS_DATA const & params,
+                                                                          ARRAY_1D_TO_CONST const & targetAggregatePrimarySpeciesConcentration,
+                                                                          ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentration0,
+                                                                          ARRAY_1D & logPrimarySpeciesConcentration,
+                                                                          nonlinearSolvers::SolverControls< PARAMS_DATA::numPrimarySpecies() > const & controls )
+{
+  nonlinearSolvers::SolverStats stats;
+  if constexpr( PARAMS_DATA::numSecondarySpecies() <= 0 )
+  {
+    stats.isConverged = true;
+    return stats;
+  }
+
+  HPCREACT_UNUSED_VAR( temperature );
+  static constexpr int numPrimarySpecies = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
+
+  double logCp[numPrimarySpecies] = { 0.0 };
+  for( int i=0; i<numPrimarySpecies; ++i )
+  {
+    logCp[i] = logPrimarySpeciesConcentration0[i];
+  }
+
+  auto const & stoichiometry = params.sparseStoichiometry();
 
-  REAL_TYPE residualNorm = 0.0;
-  // // Print for MoMaS only
-  // //         0:     1e-20       -0           2 -2.5e+11       1e-20        7           2      1.8           1        5
-  // printf( "iter       X1       R0           X2      R1          X3       R2          X4       R3           S       R4\n" );
-  // printf( "----   ---------------      ---------------      ---------------      ---------------      ---------------\n" );
-  for( int k=0; k<150; ++k )
+  auto computeFixedPointResidual = [&]( double const (&logCpTrial)[numPrimarySpecies],
+                                        double (& residual)[numPrimarySpecies] )
   {
-    computeResidualAndJacobianAggregatePrimaryConcentrations( temperature,
-                                                              params,
-                                                              targetAggregatePrimarySpeciesConcentration,
-                                                              logPrimarySpeciesConcentration,
-                                                              residual,
-                                                              jacobian );
+    double logSecondarySpeciesConcentration[numSecondarySpecies] = { 0.0 };
+    double positiveAggregate[numPrimarySpecies] = { 0.0 };
+    double negativeAggregate[numPrimarySpecies] = { 0.0 };
+    double dPositiveAggregate[numPrimarySpecies] = { 0.0 };
+    double dNegativeAggregate[numPrimarySpecies] = { 0.0 };
 
-    residualNorm = 0.0;
+    massActions::calculateLogSecondarySpeciesConcentration< REAL_TYPE,
+                                                            INT_TYPE,
+                                                            INDEX_TYPE >( params,
+                                                                          logCpTrial,
+                                                                          logSecondarySpeciesConcentration );
     for( int i = 0; i < numPrimarySpecies; ++i )
     {
-      residualNorm += residual[i] * residual[i];
+      positiveAggregate[i] = exp( logCpTrial[i] );
+      dPositiveAggregate[i] = positiveAggregate[i];
     }
-    residualNorm = sqrt( residualNorm );
-
-    //  // Print for MoMaS only
-    // printf( "%2d:  %8.2g %8.2g    %8.2g %8.2g    %8.2g %8.2g    %8.2g %8.2g    %8.2g %8.2g  \n",
-    //         k,
-    //         exp( logPrimarySpeciesConcentration[0] ),
-    //         residual[0],
-    //         exp( logPrimarySpeciesConcentration[1] ),
-    //         residual[1],
-    //         exp( logPrimarySpeciesConcentration[2] ),
-    //         residual[2],
-    //         exp( logPrimarySpeciesConcentration[3] ),
-    //         residual[3],
-    //         exp( logPrimarySpeciesConcentration[4] ),
-    //         residual[4] );
-
-    //printf( "iter, residualNorm = %2d, %16.10g \n", k, residualNorm );
-    if( residualNorm < 1.0e-12 )
+    for( int j = 0; j < numSecondarySpecies; ++j )
     {
-      printf( " converged\n" );
-      break;
+      double const secondarySpeciesConcentration = exp( logSecondarySpeciesConcentration[j] );
+      for( int m = stoichiometry.reactionBegin( j ); m < stoichiometry.reactionEnd( j ); ++m )
+      {
+        int const i = stoichiometry.reactionSpecies( m ) - numSecondarySpecies;
+        if( i < 0 )
+        {
+          continue;
+        }
+        double const s_ji = stoichiometry.reactionCoefficient( m );
+        if( s_ji > 0.0 )
+        {
+          positiveAggregate[i] += s_ji * secondarySpeciesConcentration;
+          dPositiveAggregate[i] += s_ji * s_ji * secondarySpeciesConcentration;
+        }
+        else
+        {
+          negativeAggregate[i] -= s_ji * secondarySpeciesConcentration;
+          dNegativeAggregate[i] += s_ji * s_ji * secondarySpeciesConcentration;
+        }
+      }
     }
 
-    solveNxN_pivoted< double, numPrimarySpecies >( jacobian.data, residual, dLogCp );
-
-
-    for( IndexType i=0; i<numPrimarySpecies; ++i )
+    // The log-ratio is scaled by the inverse of its derivative wrt logCp_i, which
+    // only needs the diagonal terms accumulated above. The change of a
+    // concentration is limited to a factor e^10 per iteration, as in
+    // enforceEquilibrium_Aggregate.
+    for( int i = 0; i < numPrimarySpecies; ++i )
     {
-      logPrimarySpeciesConcentration[i] += dLogCp[i];
+      double numerator = targetAggregatePrimarySpeciesConcentration[i] + negativeAggregate[i];
+      double const minNumerator = exp( -10.0 ) * positiveAggregate[i];
+      numerator = numerator > minNumerator ? numerator : minNumerator;
+      double const diagonal = dPositiveAggregate[i] / positiveAggregate[i] + dNegativeAggregate[i] / numerator;
+      residual[i] = ( log( numerator ) - log( positiveAggregate[i] ) ) / diagonal;
     }
+  };
 
+  stats = nonlinearSolvers::andersonAcceleration< numPrimarySpecies, 4, LOGGING_POLICY >( logCp,
+                                                                                          computeFixedPointResidual,
+                                                                                          controls );
+
+  for( int i=0; i<numPrimarySpecies; ++i )
+  {
+    logPrimarySpeciesConcentration[i] = logCp[i];
   }
+  return stats;
 }
 
 } // namespace reactionsSystems
@@ -46,14 +46,16 @@ EquilibriumReactions< REAL_TYPE,
   static constexpr int numSpecies = PARAMS_DATA::numSpecies();
   static constexpr int numReactions = PARAMS_DATA::numReactions();
 
+  auto const & stoichiometry = params.sparseStoichiometry();
+
   // initialize the species concentration
   RealType speciesConcentration[numSpecies];
   for( IndexType i=0; i<numSpecies; ++i )
   {
     speciesConcentration[i] = speciesConcentration0[i];
-    for( IndexType r=0; r<numReactions; ++r )
+    for( int k=stoichiometry.speciesBegin( i ); k<stoichiometry.speciesEnd( i ); ++k )
     {
-      speciesConcentration[i] += params.stoichiometricMatrix( r, i ) * xi[r];
+      speciesConcentration[i] += stoichiometry.speciesCoefficient( k ) * xi[stoichiometry.speciesReaction( k )];
     }
   }
 
@@ -72,28 +74,29 @@ EquilibriumReactions< REAL_TYPE,
     // it will have to be multiplied by the product itself to get the derivative of the product.
     RealType dForwardProduct_dxi_divProduct[numReactions] = {0.0};
     RealType dReverseProduct_dxi_divProduct[numReactions] = {0.0};
-    // loop over species
-    for( IndexType i=0; i<numSpecies; ++i )
+    // loop over the species participating in this reaction
+    for( int m=stoichiometry.reactionBegin( a ); m<stoichiometry.reactionEnd( a ); ++m )
     {
-      RealType const s_ai = params.stoichiometricMatrix( a, i );
+      IndexType const i = stoichiometry.reactionSpecies( m );
+      RealType const s_ai = stoichiometry.reactionCoefficient( m );
       if( s_ai < 0.0 )
       {
         // forward reaction
-        forwardProduct *= pow( speciesConcentration[i], -s_ai );
-        // derivative of forward product with respect to xi
-        for( IndexType b=0; b<numReactions; ++b )
+        forwardProduct *= stoichiometricPower( speciesConcentration[i], -stoichiometry.reactionCoefficient( m ) );
+        // derivative of forward product with respect to xi. Only reactions involving species i contribute.
+        for( int n=stoichiometry.speciesBegin( i ); n<stoichiometry.speciesEnd( i ); ++n )
         {
-          dForwardProduct_dxi_divProduct[b] += -s_ai / speciesConcentration[i] * params.stoichiometricMatrix( b, i );
+          dForwardProduct_dxi_divProduct[stoichiometry.speciesReaction( n )] += -s_ai / speciesConcentration[i] * stoichiometry.speciesCoefficient( n );
         }
       }
-      else if( s_ai > 0.0 )
+      else
       {
         // reverse reaction
-        reverseProduct *= pow( speciesConcentration[i], s_ai );
-        // derivative of reverse product with respect to xi
-        for( IndexType b=0; b<numReactions; ++b )
+        reverseProduct *= stoichiometricPower( speciesConcentration[i], stoichiometry.reactionCoefficient( m ) );
+        // derivative of reverse product with respect to xi. Only reactions involving species i contribute.
+        for( int n=stoichiometry.speciesBegin( i ); n<stoichiometry.speciesEnd( i ); ++n )
         {
-          dReverseProduct_dxi_divProduct[b] += s_ai / speciesConcentration[i] * params.stoichiometricMatrix( b, i );
+          dReverseProduct_dxi_divProduct[stoichiometry.speciesReaction( n )] += s_ai / speciesConcentration[i] * stoichiometry.speciesCoefficient( n );
         }
       }
     }
@@ -110,99 +113,128 @@ EquilibriumReactions< REAL_TYPE,
 
 
 
+namespace internal
+{
+
+/**
+ * @brief Line search on the reaction extents that keeps the species
+ *        concentrations c = c0 + S^T xi positive.
+ * @tparam NUM_SPECIES The number of species.
+ * @tparam STOICHIOMETRY The sparse stoichiometry type.
+ * @tparam ARRAY_1D_TO_CONST The type of the initial species concentrations.
+ */
+template< int NUM_SPECIES, typename STOICHIOMETRY, typename ARRAY_1D_TO_CONST >
+struct ReactionExtentsLineSearch : nonlinearSolvers::BacktrackingLineSearch
+{
+  /// The stoichiometry of the reactions.
+  STOICHIOMETRY const & stoichiometry;
+  /// The initial species concentrations.
+  ARRAY_1D_TO_CONST const & speciesConcentration0;
+
+  /**
+   * @brief The step, up to 1, that moves the concentrations at most a fraction
+   *        fractionToBoundary of the way to 1e-30.
+   * @tparam REAL_TYPE The floating point type.
+   * @tparam N The number of reactions.
+   * @param xi The current reaction extents.
+   * @param dxi The Newton update of the reaction extents.
+   * @return The step length.
+   */
+  template< typename REAL_TYPE, int N >
+  HPCREACT_HOST_DEVICE
+  REAL_TYPE maxStepLength( REAL_TYPE const (&xi)[N], REAL_TYPE const (&dxi)[N] ) const
+  {
+    REAL_TYPE scale = 1.0;
+    for( int i=0; i<NUM_SPECIES; ++i )
+    {
+      REAL_TYPE cn = speciesConcentration0[i];
+      REAL_TYPE dc = 0.0;
+      for( int m=stoichiometry.speciesBegin( i ); m<stoichiometry.speciesEnd( i ); ++m )
+      {
+        int const r = stoichiometry.speciesReaction( m );
+        dc += stoichiometry.speciesCoefficient( m ) * dxi[r];
+        cn += stoichiometry.speciesCoefficient( m ) * xi[r];
+      }
+      if( cn+dc < 1.0e-30 )
+      {
+        REAL_TYPE const fscale = ( 1.0e-30 - cn ) / (dc);
+        if( fscale < scale )
+        {
+          scale = fractionToBoundary*fscale;
+        }
+      }
+    }
+    return scale;
+  }
+};
+
+} // namespace internal
+
 template< typename REAL_TYPE,
           typename INT_TYPE,
           typename INDEX_TYPE >
-template< typename PARAMS_DATA,
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
           typename ARRAY_1D,
           typename ARRAY_1D_TO_CONST >
 HPCREACT_HOST_DEVICE inline
-void
+nonlinearSolvers::SolverStats
 EquilibriumReactions< REAL_TYPE,
                       INT_TYPE,
                       INDEX_TYPE >::enforceEquilibrium_Extents( REAL_TYPE const & temperature,
                                                                 PARAMS_DATA const & params,
                                                                 ARRAY_1D_TO_CONST const & speciesConcentration0,
-                                                                ARRAY_1D & speciesConcentration )
+                                                                ARRAY_1D & speciesConcentration,
+                                                                nonlinearSolvers::SolverControls< PARAMS_DATA::numReactions() > const & controls )
 {
-  HPCREACT_UNUSED_VAR( temperature );
   static constexpr int numSpecies = PARAMS_DATA::numSpecies();
   static constexpr int numReactions = PARAMS_DATA::numReactions();
-  double residual[numReactions] = { 0.0 };
   double xi[numReactions] = { 0.0 };
-  double dxi[numReactions] = { 0.0 };
-  CArrayWrapper< double, numReactions, numReactions > jacobian;
 
-  REAL_TYPE residualNorm = 0.0;
-  for( int k=0; k<30; ++k )
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+  auto computeResidualAndJacobian = [&]( double const (&xiTrial)[numReactions],
+                                         double (& residual)[numReactions],
+                                         double (& J)[numReactions][numReactions] )
   {
+    CArrayWrapper< double, numReactions, numReactions > jacobian;
     computeResidualAndJacobianReactionExtents( temperature,
                                                params,
                                                speciesConcentration0,
-                                               xi,
+                                               xiTrial,
                                                residual,
                                                jacobian );
-
-    residualNorm = 0.0;
-    for( int j = 0; j < numReactions; ++j )
-    {
-      residualNorm += residual[j] * residual[j];
-    }
-    residualNorm = sqrt( residualNorm );
-    printf( "iter, residualNorm = %2d, %16.10g \n", k, residualNorm );
-    if( residualNorm < 1.0e-12 )
-    {
-      printf( " converged\n" );
-      break;
-    }
-
-    // solve for the change in xi
-    for( int r=0; r<numReactions; ++r )
-    {
-      dxi[r] = 0.0;
-      residual[r] = -residual[r];
-    }
-
-    solveNxN_Cholesky< double, numReactions >( jacobian.data, residual, dxi );
-
-
-    // scaling
-    REAL_TYPE scale = 1.0;
-    for( IndexType i=0; i<numSpecies; ++i )
+    for( int a = 0; a < numReactions; ++a )
     {
-      REAL_TYPE cn = speciesConcentration0[i];
-      REAL_TYPE dc = 0.0;
-      for( IndexType r=0; r<numReactions; ++r )
+      for( int b = 0; b < numReactions; ++b )
       {
-        dc += params.stoichiometricMatrix( r, i ) * dxi[r];
-        cn += params.stoichiometricMatrix( r, i ) * xi[r];
-      }
-      if( cn+dc < 1.0e-30 )
-      {
-        REAL_TYPE const fscale = ( 1.0e-30 - cn ) / (dc);
-        if( fscale < scale )
-        {
-          scale = 0.9*fscale;
-          //printf( "i, cn, dc, scale = %d, %18.12g %18.12g %18.12g\n", i, cn, dc, scale );
-        }
+        J[a][b] = jacobian( a, b );
       }
     }
+  };
 
-    for( IndexType r=0; r<numReactions; ++r )
-    {
-      xi[r] += scale * dxi[r];
-    }
+  internal::ReactionExtentsLineSearch< numSpecies,
+                                       std::remove_reference_t< decltype( stoichiometry ) >,
+                                       ARRAY_1D_TO_CONST > lineSearch{ {}, stoichiometry, speciesConcentration0 };
+  lineSearch.fractionToBoundary = 0.9;
 
-  }
+  nonlinearSolvers::SolverStats const stats =
+    nonlinearSolvers::newtonRaphson< numReactions, LOGGING_POLICY >( xi,
+                                                                     computeResidualAndJacobian,
+                                                                     controls,
+                                                                     CholeskySolver{},
+                                                                     lineSearch );
 
   for( IndexType i=0; i<numSpecies; ++i )
   {
     speciesConcentration[i] = speciesConcentration0[i];
-    for( IndexType r=0; r<numReactions; ++r )
+    for( int m=stoichiometry.speciesBegin( i ); m<stoichiometry.speciesEnd( i ); ++m )
     {
-      speciesConcentration[i] += params.stoichiometricMatrix( r, i ) * xi[r];
+      speciesConcentration[i] += stoichiometry.speciesCoefficient( m ) * xi[stoichiometry.speciesReaction( m )];
     }
   }
+
+  return stats;
 }
 
 
@@ -12,7 +12,9 @@
 #pragma once
 
 #include "common/macros.hpp"
+#include "common/nonlinearSolvers.hpp"
 
+#include <cstddef>
 #include <stdexcept>
 
 /** @file KineticReactions.hpp
@@ -92,7 +94,7 @@ public:
                         ARRAY_1D_TO_CONST const & speciesConcentration,
                         ARRAY_1D & reactionRates )
   {
-    REAL_TYPE reactionRatesDerivatives[PARAMS_DATA::numReactions()][PARAMS_DATA::numSpecies()] = { {0.0} };
+    char reactionRatesDerivatives;
     computeReactionRates_impl< PARAMS_DATA, false >( temperature,
                                                      params,
                                                      speciesConcentration,
@@ -102,6 +104,8 @@ public:
 
   /**
    * @brief Compute the reaction rates for a given set of species concentrations and surface area.
+   * @tparam CALCULATE_DERIVATIVES Whether to calculate the derivatives. If false,
+   *         @p reactionRatesDerivatives is not accessed and may be a placeholder.
    * @tparam PARAMS_DATA The type of the parameters data.
    * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations
    * @tparam ARRAY_1D_SA The type of the array of surface area.
@@ -119,7 +123,8 @@ public:
    *   CALCULATE_DERIVATIVES is true, it also computes the derivatives of the
    *   reaction rates with respect to the species concentrations.
    */
-  template< typename PARAMS_DATA,
+  template< bool CALCULATE_DERIVATIVES = true,
+            typename PARAMS_DATA,
             typename ARRAY_1D_TO_CONST,
             typename ARRAY_1D_SA,
             typename ARRAY_1D,
@@ -134,25 +139,81 @@ public:
   {
     if( params.reactionRatesUpdateOption() == 0 )
     {
-      computeReactionRates_impl< PARAMS_DATA, true >( temperature,
-                                                      params,
-                                                      speciesConcentration,
-                                                      reactionRates,
-                                                      reactionRatesDerivatives );
+      computeReactionRates_impl< PARAMS_DATA, CALCULATE_DERIVATIVES >( temperature,
+                                                                       params,
+                                                                       speciesConcentration,
+                                                                       reactionRates,
+                                                                       reactionRatesDerivatives );
     }
     else if( params.reactionRatesUpdateOption() == 1 )
     {
-      computeReactionRatesQuotient_impl< PARAMS_DATA, true >( temperature,
-                                                              params,
-                                                              speciesConcentration,
-                                                              surfaceArea,
-                                                              reactionRates,
-                                                              reactionRatesDerivatives );
+      computeReactionRatesQuotient_impl< PARAMS_DATA, CALCULATE_DERIVATIVES >( temperature,
+                                                                               params,
+                                                                               speciesConcentration,
+                                                                               surfaceArea,
+                                                                               reactionRates,
+                                                                               reactionRatesDerivatives );
     }
   }
 
 
 
+  /**
+   * @brief Compute the rate of a single reaction and its sparse derivatives.
+   * @tparam CALCULATE_DERIVATIVES Whether to calculate the derivatives. If false,
+   *         @p reactionRateDerivatives is not accessed and may be a placeholder.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
+   * @tparam ARRAY_1D_SA The type of the array of surface area.
+   * @tparam ARRAY_1D_DERIVATIVES The type of the array of reaction rate derivatives.
+   * @param temperature The temperature of the system.
+   * @param params The parameters data.
+   * @param speciesConcentration The array of species concentrations.
+   * @param surfaceArea The array of surface area.
+   * @param r The index of the reaction.
+   * @param reactionRate The rate of reaction r.
+   * @param reactionRateDerivatives The derivatives of the rate wrt the species of the reaction,
+   *        indexed by their position k - reactionBegin( r ) in the sparse stoichiometry. It needs
+   *        room for the number of species in the reaction.
+   * @details
+   *   This is one row of computeReactionRates() with surface area, without the zeros of the dense
+   *   derivative row. It lets callers that contract the derivatives with the stoichiometry
+   *   accumulate them reaction by reaction instead of storing the full derivative matrix.
+   */
+  template< bool CALCULATE_DERIVATIVES = true,
+            typename PARAMS_DATA,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_1D_SA,
+            typename ARRAY_1D_DERIVATIVES >
+  static HPCREACT_HOST_DEVICE inline void
+  computeReactionRate( RealType const & temperature,
+                       PARAMS_DATA const & params,
+                       ARRAY_1D_TO_CONST const & speciesConcentration,
+                       ARRAY_1D_SA const & surfaceArea,
+                       IntType const r,
+                       RealType & reactionRate,
+                       ARRAY_1D_DERIVATIVES & reactionRateDerivatives )
+  {
+    HPCREACT_UNUSED_VAR( temperature );
+    if( params.reactionRatesUpdateOption() == 0 )
+    {
+      computeReactionRate_impl< PARAMS_DATA, CALCULATE_DERIVATIVES >( params,
+                                                                      speciesConcentration,
+                                                                      r,
+                                                                      reactionRate,
+                                                                      reactionRateDerivatives );
+    }
+    else if( params.reactionRatesUpdateOption() == 1 )
+    {
+      computeReactionRateQuotient_impl< PARAMS_DATA, CALCULATE_DERIVATIVES >( params,
+                                                                              speciesConcentration,
+                                                                              surfaceArea,
+                                                                              r,
+                                                                              reactionRate,
+                                                                              reactionRateDerivatives );
+    }
+  }
+
   /**
    * @copydoc KineticReactions::computeSpeciesRates_impl()
    */
@@ -201,12 +262,45 @@ public:
                                                     speciesRatesDerivatives );
   }
 
+  /**
+   * @brief Compute the reaction rates of a batch of cells from their log concentrations.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @param temperature The temperature of the system.
+   * @param params The parameters data.
+   * @param numCells The number of cells in the batch.
+   * @param logSpeciesConcentrations The natural logarithm of the species concentrations, stored
+   *        species-major: the value of species i in cell c is at i * numCells + c.
+   * @param surfaceAreas The surface areas of the reactions, stored reaction-major like
+   *        @p reactionRates. Only read by the quotient form (reactionRatesUpdateOption() == 1).
+   * @param reactionRates The reaction rates, stored reaction-major: the rate of reaction r in
+   *        cell c is at r * numCells + c.
+   * @details
+   *   In log space the forward and reverse log-products (or the log of the reaction quotient) of
+   *   all reactions are the product of the stoichiometric matrix with the log concentrations. For
+   *   a batch this is a small matrix times a tall-skinny matrix, evaluated here on blocks of cells
+   *   with the cell index innermost, so that each stoichiometric coefficient is loaded once per
+   *   block and the loops vectorize along the cells. The rates then follow from an elementwise
+   *   exp. This is the batched equivalent of computeReactionRates() with surface area and without
+   *   derivatives, and is only available for LOGE_CONCENTRATION.
+   */
+  template< typename PARAMS_DATA >
+  static HPCREACT_HOST_DEVICE void
+  computeReactionRatesBatched( RealType const & temperature,
+                               PARAMS_DATA const & params,
+                               std::ptrdiff_t const numCells,
+                               RealType const * const logSpeciesConcentrations,
+                               RealType const * const surfaceAreas,
+                               RealType * const reactionRates );
+
   /**
    * @brief execute the time step for a given set of kinetic reactions.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
    * @tparam PARAMS_DATA The type of the parameters data.
    * @tparam ARRAY_1D The type of the array of species concentrations.
    * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
    * @tparam ARRAY_2D The type of the array of species rates derivatives.
+   * @tparam GLOBALIZATION The step length control of the Newton updates, see
+   *         nonlinearSolvers::FullNewtonStep.
    * @param dt The time step to be used for the simulation.
    * @param temperature The temperature of the reaction.
    * @param params The parameters data.
@@ -214,23 +308,126 @@ public:
    * @param speciesConcentration The array of species concentrations at the end of the time step.
    * @param speciesRates The array of species rates.
    * @param speciesRatesDerivatives The array of species rates derivatives.
+   * @param controls The convergence criteria and iteration limit. The residual
+   *        is c - c_n - dt * R(c) in concentration units, so residualWeights can
+   *        be set to the inverse of the typical concentration of each species.
+   * @param globalization The step length control of the Newton updates.
+   * @return The statistics of the backward Euler Newton solve.
+   * @details The full Newton step is the default, since the concentrations
+   *          of species that start near zero may transiently become negative
+   *          on the way to the solution. A nonlinearSolvers::BacktrackingLineSearch
+   *          can be passed for stiffer systems.
    */
-  template< typename PARAMS_DATA,
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
             typename ARRAY_1D,
             typename ARRAY_1D_TO_CONST,
-            typename ARRAY_2D >
-  static HPCREACT_HOST_DEVICE void
+            typename ARRAY_2D,
+            typename GLOBALIZATION = nonlinearSolvers::FullNewtonStep >
+  static HPCREACT_HOST_DEVICE nonlinearSolvers::SolverStats
   timeStep( RealType const dt,
             RealType const & temperature,
             PARAMS_DATA const & params,
             ARRAY_1D_TO_CONST const & speciesConcentration_n,
             ARRAY_1D & speciesConcentration,
             ARRAY_1D & speciesRates,
-            ARRAY_2D & speciesRatesDerivatives );
+            ARRAY_2D & speciesRatesDerivatives,
+            nonlinearSolvers::SolverControls< PARAMS_DATA::numSpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numSpecies() >( 20, 1.0e-14 ),
+            GLOBALIZATION const & globalization = GLOBALIZATION{} );
+
+  /**
+   * @brief execute the time step starting from an extrapolated initial guess.
+   * @tparam LOGGING_POLICY The logging policy, see nonlinearSolvers::NoLogging.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam ARRAY_1D The type of the array of species concentrations.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
+   * @tparam ARRAY_2D The type of the array of species rates derivatives.
+   * @tparam GLOBALIZATION The step length control of the Newton updates.
+   * @param dt The time step to be used for the simulation.
+   * @param temperature The temperature of the reaction.
+   * @param params The parameters data.
+   * @param speciesConcentration_n The array of species concentrations at the beginning of the time step.
+   * @param speciesConcentration The array of species concentrations at the end of the time step.
+   * @param speciesRates The array of species rates.
+   * @param speciesRatesDerivatives The array of species rates derivatives.
+   * @param predictor The accepted log concentrations of the previous time
+   *        steps of this cell. It is seeded with @p speciesConcentration_n if
+   *        empty, and the converged solution is accepted into it.
+   * @param controls The convergence criteria and iteration limit.
+   * @param globalization The step length control of the Newton updates.
+   * @return The statistics of the backward Euler Newton solve. If
+   *         predictor.measureSavings is set, numIterationsSaved holds the
+   *         iterations saved with respect to starting from @p speciesConcentration_n.
+   * @details
+   *   The initial guess is extrapolated in log space, so it remains positive
+   *   and follows the exponential decay and growth of the concentrations.
+   *   The predictor must be used for consecutive time steps of the same cell.
+   */
+  template< typename LOGGING_POLICY = nonlinearSolvers::NoLogging,
+            typename PARAMS_DATA,
+            typename ARRAY_1D,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_2D,
+            typename GLOBALIZATION = nonlinearSolvers::FullNewtonStep >
+  static HPCREACT_HOST_DEVICE nonlinearSolvers::SolverStats
+  timeStep( RealType const dt,
+            RealType const & temperature,
+            PARAMS_DATA const & params,
+            ARRAY_1D_TO_CONST const & speciesConcentration_n,
+            ARRAY_1D & speciesConcentration,
+            ARRAY_1D & speciesRates,
+            ARRAY_2D & speciesRatesDerivatives,
+            nonlinearSolvers::TimeStepPredictor< double, PARAMS_DATA::numSpecies() > & predictor,
+            nonlinearSolvers::SolverControls< PARAMS_DATA::numSpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numSpecies() >( 20, 1.0e-14 ),
+            GLOBALIZATION const & globalization = GLOBALIZATION{} );
 
 
 private:
 
+  /**
+   * @brief Compute the mass-action rate of a single reaction.
+   * @tparam PARAMS_DATA The type of the parameters data.
+   * @tparam CALCULATE_DERIVATIVES Whether to calculate the derivatives of the reaction rate.
+   * @tparam ARRAY_1D_TO_CONST The type of the array of species concentrations.
+   * @tparam ARRAY_1D_DERIVATIVES The type of the array of reaction rate derivatives.
+   * @param params The parameters data.
+   * @param speciesConcentration The array of species concentrations.
+   * @param r The index of the reaction.
+   * @param reactionRate The rate of reaction r.
+   * @param reactionRateDerivatives The derivatives of the rate wrt the species of the reaction,
+   *        indexed by their position k - reactionBegin( r ) in the sparse stoichiometry.
+   * @details See computeReactionRates_impl() for the expressions.
+   */
+  template< typename PARAMS_DATA,
+            bool CALCULATE_DERIVATIVES,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_1D_DERIVATIVES >
+  static HPCREACT_HOST_DEVICE void
+  computeReactionRate_impl( PARAMS_DATA const & params,
+                            ARRAY_1D_TO_CONST const & speciesConcentration,
+                            IntType const r,
+                            RealType & reactionRate,
+                            ARRAY_1D_DERIVATIVES & reactionRateDerivatives );
+
+  /**
+   * @brief Compute the quotient form rate of a single reaction.
+   * @copydetails KineticReactions::computeReactionRate_impl()
+   * @tparam ARRAY_1D_SA The type of the array of surface area.
+   * @param surfaceArea The array of surface area.
+   */
+  template< typename PARAMS_DATA,
+            bool CALCULATE_DERIVATIVES,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_1D_SA,
+            typename ARRAY_1D_DERIVATIVES >
+  static HPCREACT_HOST_DEVICE void
+  computeReactionRateQuotient_impl( PARAMS_DATA const & params,
+                                    ARRAY_1D_TO_CONST const & speciesConcentration,
+                                    ARRAY_1D_SA const & surfaceArea,
+                                    IntType const r,
+                                    RealType & reactionRate,
+                                    ARRAY_1D_DERIVATIVES & reactionRateDerivatives );
+
   /**
    * @brief Compute the reaction rates for a given set of species concentrations.
    * @tparam PARAMS_DATA The type of the parameters data.
@@ -14,9 +14,11 @@
 #include "common/constants.hpp"
 #include "common/CArrayWrapper.hpp"
 #include "common/DirectSystemSolve.hpp"
+#include "common/integerPower.hpp"
 
 #include <math.h>
 #include <string>
+#include <type_traits>
 #include <iostream>
 
 /** @file KineticReactions_impl.hpp
@@ -38,160 +40,272 @@ template< typename REAL_TYPE,
 template< typename PARAMS_DATA,
           bool CALCULATE_DERIVATIVES,
           typename ARRAY_1D_TO_CONST,
-          typename ARRAY_1D,
-          typename ARRAY_2D >
+          typename ARRAY_1D_DERIVATIVES >
 HPCREACT_HOST_DEVICE inline void
 KineticReactions< REAL_TYPE,
                   INT_TYPE,
                   INDEX_TYPE,
                   LOGE_CONCENTRATION
-                  >::computeReactionRates_impl( RealType const &, //temperature,
-                                                PARAMS_DATA const & params,
-                                                ARRAY_1D_TO_CONST const & speciesConcentration,
-                                                ARRAY_1D & reactionRates,
-                                                ARRAY_2D & reactionRatesDerivatives )
+                  >::computeReactionRate_impl( PARAMS_DATA const & params,
+                                               ARRAY_1D_TO_CONST const & speciesConcentration,
+                                               IntType const r,
+                                               RealType & reactionRate,
+                                               ARRAY_1D_DERIVATIVES & reactionRateDerivatives )
 {
-
   if constexpr( !CALCULATE_DERIVATIVES )
   {
-    HPCREACT_UNUSED_VAR( reactionRatesDerivatives );
+    HPCREACT_UNUSED_VAR( reactionRateDerivatives );
   }
 
-  // loop over each reaction
-  for( IntType r=0; r<PARAMS_DATA::numReactions(); ++r )
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+
+  // get/calculate the forward and reverse rate constants for this reaction
+  RealType const forwardRateConstant = params.rateConstantForward( r ); //* exp( -params.m_activationEnergy[r] / ( constants::R *
+                                                                        // temperature ) );
+  RealType const reverseRateConstant = params.rateConstantReverse( r );
+
+  // only the species participating in the reaction contribute to the products
+  int const rBegin = stoichiometry.reactionBegin( r );
+  int const rEnd = stoichiometry.reactionEnd( r );
+
+  if constexpr( LOGE_CONCENTRATION )
   {
-    // set reaction rate to zero
-    reactionRates[r] = 0.0;
-    // get/calculate the forward and reverse rate constants for this reaction
-    RealType const forwardRateConstant = params.rateConstantForward( r ); //* exp( -params.m_activationEnergy[r] / ( constants::R *
-                                                                          // temperature ) );
-    RealType const reverseRateConstant = params.rateConstantReverse( r );
+    RealType productConcForward = 0.0;
+    RealType productConcReverse = 0.0;
 
-    if constexpr( LOGE_CONCENTRATION )
+    // build the products for the forward and reverse reaction rates
+    for( int k = rBegin; k < rEnd; ++k )
     {
-      RealType productConcForward = 0.0;
-      RealType productConcReverse = 0.0;
+      IntType const i = stoichiometry.reactionSpecies( k );
+      RealType const s_ri = stoichiometry.reactionCoefficient( k );
 
-      // build the products for the forward and reverse reaction rates
-      for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
+      if( s_ri < 0.0 )
+      {
+        productConcForward += (-s_ri) * speciesConcentration[i];
+      }
+      else
       {
+        productConcReverse += s_ri * speciesConcentration[i];
+      }
+    }
 
-        RealType const s_ri = params.stoichiometricMatrix( r, i );
+    // the rate and its derivatives share the exponential of each log-product
+    RealType const forwardRate = forwardRateConstant * exp( productConcForward );
+    RealType const reverseRate = reverseRateConstant * exp( productConcReverse );
+    reactionRate = forwardRate - reverseRate;
 
+    if constexpr( CALCULATE_DERIVATIVES )
+    {
+      for( int k = rBegin; k < rEnd; ++k )
+      {
+        RealType const s_ri = stoichiometry.reactionCoefficient( k );
         if( s_ri < 0.0 )
         {
-          productConcForward += (-s_ri) * speciesConcentration[i];
+          reactionRateDerivatives[k-rBegin] = forwardRate * (-s_ri);
         }
-        else if( s_ri > 0.0 )
+        else
         {
-          productConcReverse += s_ri * speciesConcentration[i];
+          reactionRateDerivatives[k-rBegin] = -reverseRate * s_ri;
         }
       }
-
-      reactionRates[r] = forwardRateConstant * exp( productConcForward )
-                         - reverseRateConstant * exp( productConcReverse );
+    }
+  }
+  else
+  {
+    // variables used to build the product terms for the forward and reverse reaction rates
+    RealType productConcForward = 1.0;
+    RealType productConcReverse = 1.0;
+
+    // the term of each species in its product, and the product of the terms of the
+    // species before it on the same side of the reaction. Both are indexed by the
+    // position of the species in the reaction (k-rBegin).
+    RealType productTerm[PARAMS_DATA::numSpecies()];
+    RealType prefixProduct[PARAMS_DATA::numSpecies()];
+
+    // build the products for the forward and reverse reaction rates
+    for( int k = rBegin; k < rEnd; ++k )
+    {
+      IntType const i = stoichiometry.reactionSpecies( k );
+      auto const coefficient = stoichiometry.reactionCoefficient( k );
+      RealType const productTerm_i = speciesConcentration[i] > 1e-100 ? stoichiometricPower( speciesConcentration[i], coefficient < 0 ? -coefficient : coefficient ) : 0.0;
 
       if constexpr( CALCULATE_DERIVATIVES )
       {
-        for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
+        productTerm[k-rBegin] = productTerm_i;
+        prefixProduct[k-rBegin] = coefficient < 0 ? productConcForward : productConcReverse;
+      }
+
+      if( coefficient < 0 )
+      {
+        productConcForward *= productTerm_i;
+      }
+      else
+      {
+        productConcReverse *= productTerm_i;
+      }
+    }
+    reactionRate = forwardRateConstant * productConcForward - reverseRateConstant * productConcReverse;
+
+    if constexpr( CALCULATE_DERIVATIVES )
+    {
+      // The derivative of a product wrt one of its species is the derivative of that species' term
+      // times the terms of all other species on the same side. Multiplying the prefix product by a
+      // running suffix product gives the latter without dividing by terms that may be zero.
+      RealType suffixProductForward = 1.0;
+      RealType suffixProductReverse = 1.0;
+      for( int k = rEnd-1; k >= rBegin; --k )
+      {
+        IntType const i = stoichiometry.reactionSpecies( k );
+        auto const coefficient = stoichiometry.reactionCoefficient( k );
+        RealType const s_ri = coefficient;
+        if( coefficient < 0 )
         {
-          RealType const s_ri = params.stoichiometricMatrix( r, i );
-          if( s_ri < 0.0 )
-          {
-            reactionRatesDerivatives( r, i ) = forwardRateConstant * exp( productConcForward ) * (-s_ri);
-          }
-          else if( s_ri > 0.0 )
-          {
-            reactionRatesDerivatives( r, i ) = -reverseRateConstant * exp( productConcReverse ) * s_ri;
-          }
-          else
-          {
-            reactionRatesDerivatives( r, i ) = 0.0;
-          }
+          RealType const dProductTerm_dC = -s_ri * stoichiometricPower( speciesConcentration[i], -coefficient-1 );
+          reactionRateDerivatives[k-rBegin] = forwardRateConstant * dProductTerm_dC * prefixProduct[k-rBegin] * suffixProductForward;
+          suffixProductForward *= productTerm[k-rBegin];
+        }
+        else
+        {
+          RealType const dProductTerm_dC = s_ri * stoichiometricPower( speciesConcentration[i], coefficient-1 );
+          reactionRateDerivatives[k-rBegin] = -reverseRateConstant * dProductTerm_dC * prefixProduct[k-rBegin] * suffixProductReverse;
+          suffixProductReverse *= productTerm[k-rBegin];
         }
       }
     }
-    else
+  } // end of if constexpr ( LOGE_CONCENTRATION )
+}
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE,
+          bool LOGE_CONCENTRATION >
+template< typename PARAMS_DATA,
+          bool CALCULATE_DERIVATIVES,
+          typename ARRAY_1D_TO_CONST,
+          typename ARRAY_1D,
+          typename ARRAY_2D >
+HPCREACT_HOST_DEVICE inline void
+KineticReactions< REAL_TYPE,
+                  INT_TYPE,
+                  INDEX_TYPE,
+                  LOGE_CONCENTRATION
+                  >::computeReactionRates_impl( RealType const &, //temperature,
+                                                PARAMS_DATA const & params,
+                                                ARRAY_1D_TO_CONST const & speciesConcentration,
+                                                ARRAY_1D & reactionRates,
+                                                ARRAY_2D & reactionRatesDerivatives )
+{
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+  // loop over each reaction
+  for( IntType r=0; r<PARAMS_DATA::numReactions(); ++r )
+  {
+    if constexpr( CALCULATE_DERIVATIVES )
     {
-      // variables used to build the product terms for the forward and reverse reaction rates
-      RealType productConcForward = 1.0;
-      RealType productConcReverse = 1.0;
+      RealType reactionRateDerivatives[PARAMS_DATA::numSpecies()];
+      computeReactionRate_impl< PARAMS_DATA, true >( params, speciesConcentration, r, reactionRates[r], reactionRateDerivatives );
 
-      RealType dProductConcForward_dC[PARAMS_DATA::numSpecies()];
-      RealType dProductConcReverse_dC[PARAMS_DATA::numSpecies()];
+      // scatter the derivatives wrt the species of the reaction into the dense row
       for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
       {
-        dProductConcForward_dC[i] = 1.0;
-        dProductConcReverse_dC[i] = 1.0;
+        reactionRatesDerivatives( r, i ) = 0.0;
       }
-
-      // build the products for the forward and reverse reaction rates
-      for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
+      for( int k = stoichiometry.reactionBegin( r ); k < stoichiometry.reactionEnd( r ); ++k )
       {
+        reactionRatesDerivatives( r, stoichiometry.reactionSpecies( k ) ) = reactionRateDerivatives[k-stoichiometry.reactionBegin( r )];
+      }
+    }
+    else
+    {
+      HPCREACT_UNUSED_VAR( reactionRatesDerivatives );
+      HPCREACT_UNUSED_VAR( stoichiometry );
+      char reactionRateDerivatives;
+      computeReactionRate_impl< PARAMS_DATA, false >( params, speciesConcentration, r, reactionRates[r], reactionRateDerivatives );
+    }
+  }
+}
 
-        RealType const s_ri = params.stoichiometricMatrix( r, i );
-        RealType const productTerm_i = speciesConcentration[i] > 1e-100 ? pow( speciesConcentration[i], fabs( s_ri ) ) : 0.0;
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE,
+          bool LOGE_CONCENTRATION >
+template< typename PARAMS_DATA,
+          bool CALCULATE_DERIVATIVES,
+          typename ARRAY_1D_TO_CONST,
+          typename ARRAY_1D_SA,
+          typename ARRAY_1D_DERIVATIVES >
+HPCREACT_HOST_DEVICE inline void
+KineticReactions< REAL_TYPE,
+                  INT_TYPE,
+                  INDEX_TYPE,
+                  LOGE_CONCENTRATION
+                  >::computeReactionRateQuotient_impl( PARAMS_DATA const & params,
+                                                       ARRAY_1D_TO_CONST const & speciesConcentration,
+                                                       ARRAY_1D_SA const & surfaceArea,
+                                                       IntType const r,
+                                                       RealType & reactionRate,
+                                                       ARRAY_1D_DERIVATIVES & reactionRateDerivatives )
+{
+  if constexpr( !CALCULATE_DERIVATIVES )
+  {
+    HPCREACT_UNUSED_VAR( reactionRateDerivatives );
+  }
 
-        if( s_ri < 0.0 )
-        {
-          productConcForward *= productTerm_i;
-        }
-        else if( s_ri > 0.0 )
-        {
-          productConcReverse *= productTerm_i;
-        }
+  auto const & stoichiometry = params.sparseStoichiometry();
 
-        if constexpr( CALCULATE_DERIVATIVES )
-        {
 
-          if( s_ri < 0.0 )
-          {
-            for( IntType j = 0; j < PARAMS_DATA::numSpecies(); ++j )
-            {
-              if( i==j )
-              {
-                dProductConcForward_dC[j] *= -s_ri * pow( speciesConcentration[i], -s_ri-1 );
-                dProductConcReverse_dC[j] = 0.0;
-              }
-              else
-              {
-                dProductConcForward_dC[j] *= productTerm_i;
-              }
-            }
-          }
-          else if( s_ri > 0.0 )
-          {
-            for( IntType j = 0; j < PARAMS_DATA::numSpecies(); ++j )
-            {
-              if( i==j )
-              {
-                dProductConcReverse_dC[j] *= s_ri * pow( speciesConcentration[i], s_ri-1 );
-                dProductConcForward_dC[j] = 0.0;
-              }
-              else
-              {
-                dProductConcReverse_dC[j] *= productTerm_i;
-              }
-            }
-          }
-          else
-          {
-            dProductConcForward_dC[i] = 0.0;
-            dProductConcReverse_dC[i] = 0.0;
-          }
-        }
+  // get/calculate the forward and reverse rate constants for this reaction
+  RealType const rateConstant = params.rateConstantForward( r ); //* exp( -params.m_activationEnergy[r] / ( constants::R *
+  // temperature ) );
+  RealType const equilibriumConstant = params.equilibriumConstant( r );
+
+  // only the species participating in the reaction contribute to the quotient
+  int const rBegin = stoichiometry.reactionBegin( r );
+  int const rEnd = stoichiometry.reactionEnd( r );
+
+  RealType quotient = 1.0;
+
+  if constexpr( LOGE_CONCENTRATION )
+  {
+    RealType logQuotient = 0.0;
+    // build the products for the forward and reverse reaction rates
+    for( int k = rBegin; k < rEnd; ++k )
+    {
+      RealType const s_ri = stoichiometry.reactionCoefficient( k );
+      logQuotient += s_ri * speciesConcentration[stoichiometry.reactionSpecies( k )];
+    }
+    quotient = exp( logQuotient );
+
+    if constexpr( CALCULATE_DERIVATIVES )
+    {
+      for( int k = rBegin; k < rEnd; ++k )
+      {
+        RealType const s_ri = stoichiometry.reactionCoefficient( k );
+        reactionRateDerivatives[k-rBegin] = -rateConstant * surfaceArea[r] * s_ri * quotient / equilibriumConstant;
       }
-      reactionRates[r] = forwardRateConstant * productConcForward - reverseRateConstant * productConcReverse;
+    } // end of if constexpr ( CALCULATE_DERIVATIVES )
+  } // end of if constexpr ( LOGE_CONCENTRATION )
+  else
+  {
+    for( int k = rBegin; k < rEnd; ++k )
+    {
+      IntType const i = stoichiometry.reactionSpecies( k );
+      RealType const productTerm_i = speciesConcentration[i] > 1e-100 ? stoichiometricPower( speciesConcentration[i], stoichiometry.reactionCoefficient( k ) ) : 0.0;
+      quotient *= productTerm_i;
+    }
 
-      if constexpr( CALCULATE_DERIVATIVES )
+    if constexpr( CALCULATE_DERIVATIVES )
+    {
+      for( int k = rBegin; k < rEnd; ++k )
       {
-        for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
-        {
-          reactionRatesDerivatives( r, i ) = forwardRateConstant * dProductConcForward_dC[i] - reverseRateConstant * dProductConcReverse_dC[i];
-        }
+        IntType const i = stoichiometry.reactionSpecies( k );
+        RealType const s_ri = stoichiometry.reactionCoefficient( k );
+        reactionRateDerivatives[k-rBegin] = -rateConstant * surfaceArea[r] * s_ri * quotient / ( equilibriumConstant * speciesConcentration[i] );
       }
-    } // end of if constexpr ( LOGE_CONCENTRATION )
-  } // end of loop over reactions
+    } // end of if constexpr ( CALCULATE_DERIVATIVES )
+  } // end of else
+  reactionRate = rateConstant * surfaceArea[r] * ( 1.0 - quotient / equilibriumConstant );
 }
 
 template< typename REAL_TYPE,
@@ -216,79 +330,33 @@ KineticReactions< REAL_TYPE,
                                                         ARRAY_1D & reactionRates,
                                                         ARRAY_2D & reactionRatesDerivatives )
 {
-  if constexpr( !CALCULATE_DERIVATIVES )
-  {
-    HPCREACT_UNUSED_VAR( reactionRatesDerivatives );
-  }
+  auto const & stoichiometry = params.sparseStoichiometry();
 
   // loop over each reaction
   for( IntType r=0; r<PARAMS_DATA::numReactions(); ++r )
   {
-    // set reaction rate to zero
-    reactionRates[r] = 0.0;
-
     if constexpr( CALCULATE_DERIVATIVES )
     {
+      RealType reactionRateDerivatives[PARAMS_DATA::numSpecies()];
+      computeReactionRateQuotient_impl< PARAMS_DATA, true >( params, speciesConcentration, surfaceArea, r, reactionRates[r], reactionRateDerivatives );
+
+      // scatter the derivatives wrt the species of the reaction into the dense row
       for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
       {
         reactionRatesDerivatives( r, i ) = 0.0;
       }
-    }
-
-    // get/calculate the forward and reverse rate constants for this reaction
-    RealType const rateConstant = params.rateConstantForward( r ); //* exp( -params.m_activationEnergy[r] / ( constants::R *
-    // temperature ) );
-    RealType const equilibriumConstant = params.equilibriumConstant( r );
-
-    RealType quotient = 1.0;
-
-    if constexpr( LOGE_CONCENTRATION )
-    {
-      RealType logQuotient = 0.0;
-      // build the products for the forward and reverse reaction rates
-      for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
+      for( int k = stoichiometry.reactionBegin( r ); k < stoichiometry.reactionEnd( r ); ++k )
       {
-        RealType const s_ri = params.stoichiometricMatrix( r, i );
-        logQuotient += s_ri * speciesConcentration[i];
+        reactionRatesDerivatives( r, stoichiometry.reactionSpecies( k ) ) = reactionRateDerivatives[k-stoichiometry.reactionBegin( r )];
       }
-      quotient = exp( logQuotient );
-
-      if constexpr( CALCULATE_DERIVATIVES )
-      {
-        for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
-        {
-          RealType const s_ri = params.stoichiometricMatrix( r, i );
-          reactionRatesDerivatives( r, i ) = -rateConstant * surfaceArea[r] * s_ri * quotient / equilibriumConstant;
-        }
-      } // end of if constexpr ( CALCULATE_DERIVATIVES )
-    } // end of if constexpr ( LOGE_CONCENTRATION )
+    }
     else
     {
-      for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
-      {
-
-        RealType const s_ri = params.stoichiometricMatrix( r, i );
-        RealType const productTerm_i = speciesConcentration[i] > 1e-100 ? pow( speciesConcentration[i], s_ri ) : 0.0;
-        quotient *= productTerm_i;
-      }
-
-      if constexpr( CALCULATE_DERIVATIVES )
-      {
-        for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
-        {
-          RealType const s_ri = params.stoichiometricMatrix( r, i );
-          if( s_ri > 0.0 || s_ri < 0.0 )
-          {
-            reactionRatesDerivatives( r, i ) = -rateConstant * surfaceArea[r] * s_ri * quotient / ( equilibriumConstant * speciesConcentration[i] );
-          }
-          else
-          {
-            reactionRatesDerivatives( r, i ) = 0.0;
-          }
-        }
-      } // end of if constexpr ( CALCULATE_DERIVATIVES )
-    } // end of else
-    reactionRates[r] = rateConstant * surfaceArea[r] * ( 1.0 - quotient / equilibriumConstant );
+      HPCREACT_UNUSED_VAR( reactionRatesDerivatives );
+      HPCREACT_UNUSED_VAR( stoichiometry );
+      char reactionRateDerivatives;
+      computeReactionRateQuotient_impl< PARAMS_DATA, false >( params, speciesConcentration, surfaceArea, r, reactionRates[r], reactionRateDerivatives );
+    }
   }
 }
 
@@ -307,21 +375,18 @@ KineticReactions< REAL_TYPE,
                   INT_TYPE,
                   INDEX_TYPE,
                   LOGE_CONCENTRATION
-                  >::computeSpeciesRates_impl( RealType const & temperature,
+                  >::computeSpeciesRates_impl( RealType const &, //temperature,
                                                PARAMS_DATA const & params,
                                                ARRAY_1D_TO_CONST const & speciesConcentration,
                                                ARRAY_1D & speciesRates,
                                                ARRAY_2D & speciesRatesDerivatives )
 {
-  RealType reactionRates[PARAMS_DATA::numReactions()] = { 0.0 };
-  CArrayWrapper< double, PARAMS_DATA::numReactions(), PARAMS_DATA::numSpecies() > reactionRatesDerivatives;
-
   if constexpr( !CALCULATE_DERIVATIVES )
   {
     HPCREACT_UNUSED_VAR( speciesRatesDerivatives );
   }
 
-  computeReactionRates< PARAMS_DATA >( temperature, params, speciesConcentration, reactionRates, reactionRatesDerivatives );
+  auto const & stoichiometry = params.sparseStoichiometry();
 
   for( IntType i = 0; i < PARAMS_DATA::numSpecies(); ++i )
   {
@@ -333,15 +398,29 @@ KineticReactions< REAL_TYPE,
         speciesRatesDerivatives( i, j ) = 0.0;
       }
     }
-    for( IntType r=0; r<PARAMS_DATA::numReactions(); ++r )
+  }
+
+  // Sweep the reactions and add each one's contribution to the rates of its species. The derivatives
+  // of a reaction rate are only nonzero for the species of that reaction, so the contraction with the
+  // stoichiometry is accumulated from a per-reaction buffer instead of a reactions x species matrix.
+  for( IntType r = 0; r < PARAMS_DATA::numReactions(); ++r )
+  {
+    RealType reactionRate;
+    std::conditional_t< CALCULATE_DERIVATIVES, RealType[PARAMS_DATA::numSpecies()], char > reactionRateDerivatives;
+    computeReactionRate_impl< PARAMS_DATA, CALCULATE_DERIVATIVES >( params, speciesConcentration, r, reactionRate, reactionRateDerivatives );
+
+    int const rBegin = stoichiometry.reactionBegin( r );
+    int const rEnd = stoichiometry.reactionEnd( r );
+    for( int k = rBegin; k < rEnd; ++k )
     {
-      RealType const s_ir = params.stoichiometricMatrix( r, i );
-      speciesRates[i] += s_ir * reactionRates[r];
+      IntType const i = stoichiometry.reactionSpecies( k );
+      RealType const s_ir = stoichiometry.reactionCoefficient( k );
+      speciesRates[i] += s_ir * reactionRate;
       if constexpr( CALCULATE_DERIVATIVES )
       {
-        for( IntType j = 0; j < PARAMS_DATA::numSpecies(); ++j )
+        for( int m = rBegin; m < rEnd; ++m )
         {
-          speciesRatesDerivatives( i, j ) += s_ir * reactionRatesDerivatives( r, j );
+          speciesRatesDerivatives( i, stoichiometry.reactionSpecies( m ) ) += s_ir * reactionRateDerivatives[m-rBegin];
         }
       }
     }
@@ -352,11 +431,121 @@ template< typename REAL_TYPE,
           typename INT_TYPE,
           typename INDEX_TYPE,
           bool LOGE_CONCENTRATION >
-template< typename PARAMS_DATA,
+template< typename PARAMS_DATA >
+HPCREACT_HOST_DEVICE inline void
+KineticReactions< REAL_TYPE,
+                  INT_TYPE,
+                  INDEX_TYPE,
+                  LOGE_CONCENTRATION
+                  >::computeReactionRatesBatched( RealType const &, //temperature,
+                                                  PARAMS_DATA const & params,
+                                                  std::ptrdiff_t const numCells,
+                                                  RealType const * const logSpeciesConcentrations,
+                                                  RealType const * const surfaceAreas,
+                                                  RealType * const reactionRates )
+{
+  static_assert( LOGE_CONCENTRATION, "computeReactionRatesBatched requires log concentrations" );
+
+  // number of cells evaluated together. The log-products of a block stay in registers/L1.
+  constexpr int cellBlockSize = 32;
+
+  auto const & stoichiometry = params.sparseStoichiometry();
+  IntType const reactionRatesUpdateOption = params.reactionRatesUpdateOption();
+
+  for( std::ptrdiff_t cellBegin = 0; cellBegin < numCells; cellBegin += cellBlockSize )
+  {
+    int const numBlockCells = numCells - cellBegin < cellBlockSize ? static_cast< int >( numCells - cellBegin ) : cellBlockSize;
+
+    for( IntType r = 0; r < PARAMS_DATA::numReactions(); ++r )
+    {
+      std::ptrdiff_t const reactionOffset = static_cast< std::ptrdiff_t >( r ) * numCells + cellBegin;
+      RealType * const reactionRates_r = reactionRates + reactionOffset;
+
+      // row r of the stoichiometric matrix times the block of log concentrations. The structural
+      // zeros of the matrix are skipped by walking the sparse stoichiometry.
+      if( reactionRatesUpdateOption == 0 )
+      {
+        RealType logProductForward[cellBlockSize];
+        RealType logProductReverse[cellBlockSize];
+        for( int c = 0; c < numBlockCells; ++c )
+        {
+          logProductForward[c] = 0.0;
+          logProductReverse[c] = 0.0;
+        }
+
+        for( int k = stoichiometry.reactionBegin( r ); k < stoichiometry.reactionEnd( r ); ++k )
+        {
+          RealType const s_ri = stoichiometry.reactionCoefficient( k );
+          RealType const * const logConcentration_i = logSpeciesConcentrations
+                                                      + static_cast< std::ptrdiff_t >( stoichiometry.reactionSpecies( k ) ) * numCells
+                                                      + cellBegin;
+          if( s_ri < 0.0 )
+          {
+            for( int c = 0; c < numBlockCells; ++c )
+            {
+              logProductForward[c] -= s_ri * logConcentration_i[c];
+            }
+          }
+          else
+          {
+            for( int c = 0; c < numBlockCells; ++c )
+            {
+              logProductReverse[c] += s_ri * logConcentration_i[c];
+            }
+          }
+        }
+
+        RealType const forwardRateConstant = params.rateConstantForward( r );
+        RealType const reverseRateConstant = params.rateConstantReverse( r );
+        for( int c = 0; c < numBlockCells; ++c )
+        {
+          reactionRates_r[c] = forwardRateConstant * exp( logProductForward[c] )
+                               - reverseRateConstant * exp( logProductReverse[c] );
+        }
+      }
+      else if( reactionRatesUpdateOption == 1 )
+      {
+        RealType logQuotient[cellBlockSize];
+        for( int c = 0; c < numBlockCells; ++c )
+        {
+          logQuotient[c] = 0.0;
+        }
+
+        for( int k = stoichiometry.reactionBegin( r ); k < stoichiometry.reactionEnd( r ); ++k )
+        {
+          RealType const s_ri = stoichiometry.reactionCoefficient( k );
+          RealType const * const logConcentration_i = logSpeciesConcentrations
+                                                      + static_cast< std::ptrdiff_t >( stoichiometry.reactionSpecies( k ) ) * numCells
+                                                      + cellBegin;
+          for( int c = 0; c < numBlockCells; ++c )
+          {
+            logQuotient[c] += s_ri * logConcentration_i[c];
+          }
+        }
+
+        RealType const rateConstant = params.rateConstantForward( r );
+        RealType const equilibriumConstant = params.equilibriumConstant( r );
+        RealType const * const surfaceAreas_r = surfaceAreas + reactionOffset;
+        for( int c = 0; c < numBlockCells; ++c )
+        {
+          reactionRates_r[c] = rateConstant * surfaceAreas_r[c] * ( 1.0 - exp( logQuotient[c] ) / equilibriumConstant );
+        }
+      }
+    }
+  }
+}
+
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE,
+          bool LOGE_CONCENTRATION >
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
           typename ARRAY_1D,
           typename ARRAY_1D_TO_CONST,
-          typename ARRAY_2D >
-HPCREACT_HOST_DEVICE inline void
+          typename ARRAY_2D,
+          typename GLOBALIZATION >
+HPCREACT_HOST_DEVICE inline nonlinearSolvers::SolverStats
 KineticReactions< REAL_TYPE,
                   INT_TYPE,
                   INDEX_TYPE,
@@ -366,109 +555,193 @@ KineticReactions< REAL_TYPE,
                                                   ARRAY_1D_TO_CONST const & speciesConcentration_n,
                                                   ARRAY_1D & speciesConcentration,
                                                   ARRAY_1D & speciesRates,
-                                                  ARRAY_2D & speciesRatesDerivatives )
+                                                  ARRAY_2D & speciesRatesDerivatives,
+                                                  nonlinearSolvers::SolverControls< PARAMS_DATA::numSpecies() > const & controls,
+                                                  GLOBALIZATION const & globalization )
 {
-//  static constexpr int numReactions = PARAMS_DATA::numReactions();
   static constexpr int numSpecies = PARAMS_DATA::numSpecies();
 
+  double concentration[numSpecies] = { 0.0 };
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    concentration[i] = speciesConcentration[i];
+  }
 
-
-  REAL_TYPE residualNorm = 0.0;
-  for( int k=0; k<20; ++k ) // newton loop
+  // the concentrations at the beginning of the step do not change during the Newton iterations
+  RealType nonLogC_n[numSpecies];
+  for( int i = 0; i < numSpecies; ++i )
   {
-//    printf( "iteration %2d: \n", k );
+    if constexpr( LOGE_CONCENTRATION )
+    {
+      nonLogC_n[i] = exp( speciesConcentration_n[i] );
+    }
+    else
+    {
+      nonLogC_n[i] = speciesConcentration_n[i];
+    }
+  }
 
+  // backward Euler residual c - c_n - dt * R(c) and its jacobian
+  auto computeResidualAndJacobian = [&]( double const (&c)[numSpecies],
+                                         double (& residual)[numSpecies],
+                                         double (& jacobian)[numSpecies][numSpecies] )
+  {
     computeSpeciesRates( temperature,
                          params,
-                         speciesConcentration,
+                         c,
                          speciesRates,
                          speciesRatesDerivatives );
 
-    double residual[numSpecies] = { 0.0 };
-    double deltaPrimarySpeciesConcentration[numSpecies] = { 0.0 };
-
-    // form residual and Jacobian
     for( int i = 0; i < numSpecies; ++i )
     {
-
-
+      // evaluated once and shared by the residual and the diagonal of the jacobian
       RealType nonLogC;
-      RealType nonLogC_n;
       if constexpr( LOGE_CONCENTRATION )
       {
-        nonLogC = exp( speciesConcentration[i] );
-        nonLogC_n = exp( speciesConcentration_n[i] );
+        nonLogC = exp( c[i] );
       }
       else
       {
-        nonLogC = speciesConcentration[i];
-        nonLogC_n = speciesConcentration_n[i];
+        nonLogC = c[i];
       }
-      residual[i] = -(nonLogC - nonLogC_n - dt * speciesRates[i]);
-
+      residual[i] = nonLogC - nonLogC_n[i] - dt * speciesRates[i];
 
       for( int j = 0; j < numSpecies; ++j )
       {
-        speciesRatesDerivatives( i, j ) = -dt * speciesRatesDerivatives( i, j );
+        jacobian[i][j] = -dt * speciesRatesDerivatives( i, j );
       }
       if constexpr( LOGE_CONCENTRATION )
       {
-        speciesRatesDerivatives( i, i ) += nonLogC;
+        jacobian[i][i] += nonLogC;
       }
       else
       {
-        speciesRatesDerivatives( i, i ) += 1.0;
+        jacobian[i][i] += 1.0;
       }
     }
+  };
 
+  nonlinearSolvers::SolverStats const stats =
+    nonlinearSolvers::newtonRaphson< numSpecies, LOGGING_POLICY >( concentration,
+                                                                   computeResidualAndJacobian,
+                                                                   controls,
+                                                                   PivotedLUSolver{},
+                                                                   globalization );
 
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    speciesConcentration[i] = concentration[i];
+  }
+  return stats;
+}
 
-    residualNorm = 0.0;
-    for( int j = 0; j < numSpecies; ++j )
+template< typename REAL_TYPE,
+          typename INT_TYPE,
+          typename INDEX_TYPE,
+          bool LOGE_CONCENTRATION >
+template< typename LOGGING_POLICY,
+          typename PARAMS_DATA,
+          typename ARRAY_1D,
+          typename ARRAY_1D_TO_CONST,
+          typename ARRAY_2D,
+          typename GLOBALIZATION >
+HPCREACT_HOST_DEVICE inline nonlinearSolvers::SolverStats
+KineticReactions< REAL_TYPE,
+                  INT_TYPE,
+                  INDEX_TYPE,
+                  LOGE_CONCENTRATION >::timeStep( RealType const dt,
+                                                  RealType const & temperature,
+                                                  PARAMS_DATA const & params,
+                                                  ARRAY_1D_TO_CONST const & speciesConcentration_n,
+                                                  ARRAY_1D & speciesConcentration,
+                                                  ARRAY_1D & speciesRates,
+                                                  ARRAY_2D & speciesRatesDerivatives,
+                                                  nonlinearSolvers::TimeStepPredictor< double, PARAMS_DATA::numSpecies() > & predictor,
+                                                  nonlinearSolvers::SolverControls< PARAMS_DATA::numSpecies() > const & controls,
+                                                  GLOBALIZATION const & globalization )
+{
+  static constexpr int numSpecies = PARAMS_DATA::numSpecies();
+  // floor of the concentrations in the log space of the predictor
+  constexpr double minConcentration = 1.0e-300;
+
+  auto toLog = [&]( double const value )
+  {
+    if constexpr( LOGE_CONCENTRATION )
     {
-      residualNorm += residual[j] * residual[j];
+      return value;
     }
-    residualNorm = sqrt( residualNorm );
-    if( residualNorm < 1.0e-14 )
+    else
     {
-      break;
+      return log( value > minConcentration ? value : minConcentration );
     }
+  };
 
+  if( predictor.numStates == 0 )
+  {
+    double logC_n[numSpecies];
+    for( int i = 0; i < numSpecies; ++i )
+    {
+      logC_n[i] = toLog( speciesConcentration_n[i] );
+    }
+    predictor.accept( logC_n, 0.0 );
+  }
 
-//     printf( "residual = { " );
-//     for( int i = 0; i < numSpecies; ++i )
-//     {
-//       printf( " %g, ", residual[i] );
-//     }
-//     printf( "}\n" );
-
-//     printf( "Jacobian = { \n" );
-//     for( int i = 0; i < numSpecies; ++i )
-//     {
-//       printf( " { " );
-//       for( int j = 0; j < numSpecies; ++j )
-//       {
-//         printf( " %g ", speciesRatesDerivatives( i, j ) );
-// //        printf( " %g ", speciesRatesDerivatives( i, j ) / exp(speciesConcentration[j]) );
-//         if( j < numSpecies-1 )
-//         {
-//           printf( ", " );
-//         }
-//       }
-//       printf( "}, \n" );
-//     }
-//     printf( "}\n" );
-
-    solveNxN_pivoted< double, numSpecies >( speciesRatesDerivatives.data, residual, deltaPrimarySpeciesConcentration );
-
+  int referenceIterations = 0;
+  if( predictor.measureSavings )
+  {
     for( int i = 0; i < numSpecies; ++i )
     {
-//      printf( "species %2d: concentration = %e, residual = %e, delta = %e \n", i, speciesConcentration[i], residual[i],
-// deltaPrimarySpeciesConcentration[i] );
-      speciesConcentration[i] = speciesConcentration[i] + deltaPrimarySpeciesConcentration[i];
+      speciesConcentration[i] = speciesConcentration_n[i];
+    }
+    referenceIterations = timeStep< LOGGING_POLICY >( dt,
+                                                      temperature,
+                                                      params,
+                                                      speciesConcentration_n,
+                                                      speciesConcentration,
+                                                      speciesRates,
+                                                      speciesRatesDerivatives,
+                                                      controls,
+                                                      globalization ).numIterations;
+  }
+
+  double logC[numSpecies];
+  predictor.predict( dt, logC );
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    if constexpr( LOGE_CONCENTRATION )
+    {
+      speciesConcentration[i] = logC[i];
+    }
+    else
+    {
+      speciesConcentration[i] = exp( logC[i] );
     }
+  }
+
+  nonlinearSolvers::SolverStats stats = timeStep< LOGGING_POLICY >( dt,
+                                                                    temperature,
+                                                                    params,
+                                                                    speciesConcentration_n,
+                                                                    speciesConcentration,
+                                                                    speciesRates,
+                                                                    speciesRatesDerivatives,
+                                                                    controls,
+                                                                    globalization );
+
+  if( predictor.measureSavings )
+  {
+    stats.numIterationsSaved = referenceIterations - stats.numIterations;
+  }
 
+  if( stats.isConverged )
+  {
+    for( int i = 0; i < numSpecies; ++i )
+    {
+      logC[i] = toLog( speciesConcentration[i] );
+    }
+    predictor.accept( logC, dt );
   }
+  return stats;
 }
 } // namespace reactionsSystems
 } // namespace hpcReact
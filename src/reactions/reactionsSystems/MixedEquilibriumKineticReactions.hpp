@@ -105,19 +105,77 @@ public:
                      ARRAY_1D_PRIMARY & aggregateSpeciesRates,
                      ARRAY_2D_PRIMARY & dAggregateSpeciesRates_dLogPrimarySpeciesConcentrations )
   {
-    updateMixedSystem_impl( temperature,
-                            params,
-                            logPrimarySpeciesConcentrations,
-                            surfaceArea,
-                            logSecondarySpeciesConcentrations,
-                            aggregatePrimarySpeciesConcentrations,
-                            mobileAggregatePrimarySpeciesConcentrations,
-                            dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations,
-                            dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations,
-                            reactionRates,
-                            dReactionRates_dLogPrimarySpeciesConcentrations,
-                            aggregateSpeciesRates,
-                            dAggregateSpeciesRates_dLogPrimarySpeciesConcentrations );
+    updateMixedSystem_impl< PARAMS_DATA, true >( temperature,
+                                                 params,
+                                                 logPrimarySpeciesConcentrations,
+                                                 surfaceArea,
+                                                 logSecondarySpeciesConcentrations,
+                                                 aggregatePrimarySpeciesConcentrations,
+                                                 mobileAggregatePrimarySpeciesConcentrations,
+                                                 dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations,
+                                                 dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations,
+                                                 reactionRates,
+                                                 dReactionRates_dLogPrimarySpeciesConcentrations,
+                                                 aggregateSpeciesRates,
+                                                 dAggregateSpeciesRates_dLogPrimarySpeciesConcentrations );
+  }
+
+  /**
+   * @brief Residual-only version of updateMixedSystem.
+   *
+   * @details Computes the same values without any of the derivatives: the mass
+   *          action derivatives, the reaction rate derivatives and their chain
+   *          rule to the primary species are all skipped. Intended for line
+   *          searches, convergence checks and explicit predictors.
+   * @tparam PARAMS_DATA Struct providing all parameter access (stoichiometry, rate constants, etc.)
+   * @tparam ARRAY_1D_TO_CONST Read-only 1D array type for primary log-concentrations
+   * @tparam ARRAY_1D_TO_CONST_KINETIC Read-only 1D array type for the surface areas
+   * @tparam ARRAY_1D_PRIMARY Mutable 1D array type for primary species outputs
+   * @tparam ARRAY_1D_SECONDARY Mutable 1D array type for secondary log-concentrations
+   * @tparam ARRAY_1D_KINETIC Mutable 1D array type for reaction rates
+   *
+   * @param temperature Temperature of the system (in Kelvin)
+   * @param params Parameter object for stoichiometry, rates, etc.
+   * @param logPrimarySpeciesConcentrations Log of primary species concentrations
+   * @param surfaceArea surface Aread for kinetic reactions
+   * @param logSecondarySpeciesConcentrations Output log concentrations for secondary species
+   * @param aggregatePrimarySpeciesConcentrations Output aggregate concentrations (per primary)
+   * @param mobileAggregatePrimarySpeciesConcentrations Output mobile aggregate concentrations (per primary)
+   * @param reactionRates Output vector of kinetic reaction rates
+   * @param aggregateSpeciesRates Output net source/sink for each primary species
+   */
+  template< typename PARAMS_DATA,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_1D_TO_CONST_KINETIC,
+            typename ARRAY_1D_PRIMARY,
+            typename ARRAY_1D_SECONDARY,
+            typename ARRAY_1D_KINETIC >
+  static HPCREACT_HOST_DEVICE inline void
+  updateMixedSystem( RealType const & temperature,
+                     PARAMS_DATA const & params,
+                     ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentrations,
+                     ARRAY_1D_TO_CONST_KINETIC const & surfaceArea,
+                     ARRAY_1D_SECONDARY & logSecondarySpeciesConcentrations,
+                     ARRAY_1D_PRIMARY & aggregatePrimarySpeciesConcentrations,
+                     ARRAY_1D_PRIMARY & mobileAggregatePrimarySpeciesConcentrations,
+                     ARRAY_1D_KINETIC & reactionRates,
+                     ARRAY_1D_PRIMARY & aggregateSpeciesRates )
+  {
+    // placeholder for the derivative arguments, which are not accessed
+    char noDerivatives;
+    updateMixedSystem_impl< PARAMS_DATA, false >( temperature,
+                                                  params,
+                                                  logPrimarySpeciesConcentrations,
+                                                  surfaceArea,
+                                                  logSecondarySpeciesConcentrations,
+                                                  aggregatePrimarySpeciesConcentrations,
+                                                  mobileAggregatePrimarySpeciesConcentrations,
+                                                  noDerivatives,
+                                                  noDerivatives,
+                                                  reactionRates,
+                                                  noDerivatives,
+                                                  aggregateSpeciesRates,
+                                                  noDerivatives );
   }
 
   /**
@@ -153,13 +211,51 @@ public:
                         ARRAY_2D & dReactionRates_dLogPrimarySpeciesConcentrations )
 
   {
-    computeReactionRates_impl( temperature,
-                               params,
-                               logPrimarySpeciesConcentrations,
-                               logSecondarySpeciesConcentrations,
-                               surfaceArea,
-                               reactionRates,
-                               dReactionRates_dLogPrimarySpeciesConcentrations );
+    computeReactionRates_impl< PARAMS_DATA, true >( temperature,
+                                                    params,
+                                                    logPrimarySpeciesConcentrations,
+                                                    logSecondarySpeciesConcentrations,
+                                                    surfaceArea,
+                                                    reactionRates,
+                                                    dReactionRates_dLogPrimarySpeciesConcentrations );
+  }
+
+  /**
+   * @brief Compute reaction rates without their derivatives.
+   *
+   * @tparam PARAMS_DATA Struct providing reaction parameters
+   * @tparam ARRAY_1D_TO_CONST Read-only array of primary species (log-space)
+   * @tparam ARRAY_1D_TO_CONST2 Read-only array of secondary species (log-space)
+   * @tparam ARRAY_1D Output array type for reaction rates
+   *
+   * @param temperature Temperature in Kelvin
+   * @param params Parameter data for the reaction system
+   * @param logPrimarySpeciesConcentrations Log concentrations of primary species
+   * @param logSecondarySpeciesConcentrations Log concentrations of secondary species
+   * @param surfaceArea Surface area for kinetic reactions
+   * @param reactionRates Output reaction rates for each kinetic reaction
+   */
+  template< typename PARAMS_DATA,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_1D_TO_CONST2,
+            typename ARRAY_1D_TO_CONST_KINETIC,
+            typename ARRAY_1D >
+  static HPCREACT_HOST_DEVICE inline void
+  computeReactionRates( RealType const & temperature,
+                        PARAMS_DATA const & params,
+                        ARRAY_1D_TO_CONST const & logPrimarySpeciesConcentrations,
+                        ARRAY_1D_TO_CONST2 const & logSecondarySpeciesConcentrations,
+                        ARRAY_1D_TO_CONST_KINETIC const & surfaceArea,
+                        ARRAY_1D & reactionRates )
+  {
+    char dReactionRates_dLogPrimarySpeciesConcentrations;
+    computeReactionRates_impl< PARAMS_DATA, false >( temperature,
+                                                     params,
+                                                     logPrimarySpeciesConcentrations,
+                                                     logSecondarySpeciesConcentrations,
+                                                     surfaceArea,
+                                                     reactionRates,
+                                                     dReactionRates_dLogPrimarySpeciesConcentrations );
   }
 
   /**
@@ -207,13 +303,52 @@ public:
                                                aggregatesRatesDerivatives );
   }
 
+  /**
+   * @brief Compute net reaction rate for each primary species without the derivatives.
+   *
+   * @tparam PARAMS_DATA Struct with stoichiometry and mappings
+   * @tparam ARRAY_1D_TO_CONST Array type for primary species concentrations
+   * @tparam ARRAY_1D_TO_CONST2 Array type for reaction rates
+   * @tparam ARRAY_1D Output type for net species rates
+   *
+   * @param params Reaction parameters
+   * @param speciesConcentration Current concentrations of primary species
+   * @param reactionRates Computed reaction rates
+   * @param aggregatesRates Output: net rate for each primary species
+   */
+  template< typename PARAMS_DATA,
+            typename ARRAY_1D_TO_CONST,
+            typename ARRAY_1D_TO_CONST2,
+            typename ARRAY_1D >
+  static HPCREACT_HOST_DEVICE inline void
+  computeAggregateSpeciesRates( PARAMS_DATA const & params,
+                                ARRAY_1D_TO_CONST const & speciesConcentration,
+                                ARRAY_1D_TO_CONST2 const & reactionRates,
+                                ARRAY_1D & aggregatesRates )
+  {
+    char aggregatesRatesDerivatives;
+    computeAggregateSpeciesRates_impl< PARAMS_DATA,
+                                       ARRAY_1D_TO_CONST,
+                                       ARRAY_1D_TO_CONST2,
+                                       char,
+                                       ARRAY_1D,
+                                       char,
+                                       false >( params,
+                                                speciesConcentration,
+                                                reactionRates,
+                                                aggregatesRatesDerivatives,
+                                                aggregatesRates,
+                                                aggregatesRatesDerivatives );
+  }
+
 private:
   /**
    * @brief Internal implementation of updateMixedSystem with template-dispatched logic.
    *
-   * @details Called by the public `updateMixedSystem` function. Handles the complete chain:
+   * @details Called by the public `updateMixedSystem` functions. Handles the complete chain:
    *          secondary speciation, aggregation, reaction rate evaluation, and net source terms.
    * @tparam PARAMS_DATA Struct providing all parameter access (stoichiometry, rate constants, etc.)
+   * @tparam CALCULATE_DERIVATIVES Whether to compute the derivative arrays. If false, they are not accessed.
    * @tparam ARRAY_1D_TO_CONST Read-only 1D array type for primary log-concentrations
    * @tparam ARRAY_1D_PRIMARY Mutable 1D array type for primary species outputs
    * @tparam ARRAY_1D_SECONDARY Mutable 1D array type for secondary log-concentrations
@@ -237,6 +372,7 @@ private:
    * @param dAggregateSpeciesRates_dLogPrimarySpeciesConcentrations Derivatives of aggregate source terms
    */
   template< typename PARAMS_DATA,
+            bool CALCULATE_DERIVATIVES,
             typename ARRAY_1D_TO_CONST,
             typename ARRAY_1D_TO_CONST_KINETIC,
             typename ARRAY_1D_PRIMARY,
@@ -262,6 +398,7 @@ private:
    * @brief Internal implementation of computeReactionRates.
    *
    * @details Handles kinetic rate law evaluation for forward and reverse reactions.
+   * @tparam CALCULATE_DERIVATIVES Whether to compute the derivatives. If false, they are not accessed.
    * @param temperature Temperature in Kelvin
    * @param params Parameter data for the reaction system
    * @param logPrimarySpeciesConcentrations Log concentrations of primary species
@@ -270,6 +407,7 @@ private:
    * @param dReactionRates_dLogPrimarySpeciesConcentrations Derivatives of reaction rates w.r.t. log primary species
    */
   template< typename PARAMS_DATA,
+            bool CALCULATE_DERIVATIVES,
             typename ARRAY_1D_TO_CONST,
             typename ARRAY_1D_TO_CONST2,
             typename ARRAY_1D_TO_CONST_KINETIC,
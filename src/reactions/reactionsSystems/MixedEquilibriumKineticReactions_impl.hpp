@@ -32,6 +32,7 @@ template< typename REAL_TYPE,
           typename INDEX_TYPE,
           bool LOGE_CONCENTRATION >
 template< typename PARAMS_DATA,
+          bool CALCULATE_DERIVATIVES,
           typename ARRAY_1D_TO_CONST,
           typename ARRAY_1D_TO_CONST_KINETIC,
           typename ARRAY_1D_PRIMARY,
@@ -58,18 +59,37 @@ MixedEquilibriumKineticReactions< REAL_TYPE,
                                                              ARRAY_1D_PRIMARY & aggregateSpeciesRates,
                                                              ARRAY_2D_PRIMARY & dAggregateSpeciesRates_dLogPrimarySpeciesConcentrations )
 {
+  if constexpr( !CALCULATE_DERIVATIVES )
+  {
+    HPCREACT_UNUSED_VAR( dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations );
+    HPCREACT_UNUSED_VAR( dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations );
+  }
+
   if constexpr( PARAMS_DATA::numEquilibriumReactions() > 0 )
   {
     // 1. Compute new aggregate species from primary species
-    massActions::calculateTotalAndMobileAggregatePrimaryConcentrationsWrtLogC< REAL_TYPE,
-                                                                               INT_TYPE,
-                                                                               INDEX_TYPE >( params.equilibriumReactionsParameters(),
-                                                                                             logPrimarySpeciesConcentrations,
-                                                                                             logSecondarySpeciesConcentrations,
-                                                                                             aggregatePrimarySpeciesConcentrations,
-                                                                                             mobileAggregatePrimarySpeciesConcentrations,
-                                                                                             dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations,
-                                                                                             dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations );
+    if constexpr( CALCULATE_DERIVATIVES )
+    {
+      massActions::calculateTotalAndMobileAggregatePrimaryConcentrationsWrtLogC< REAL_TYPE,
+                                                                                 INT_TYPE,
+                                                                                 INDEX_TYPE >( params.equilibriumReactionsParameters(),
+                                                                                               logPrimarySpeciesConcentrations,
+                                                                                               logSecondarySpeciesConcentrations,
+                                                                                               aggregatePrimarySpeciesConcentrations,
+                                                                                               mobileAggregatePrimarySpeciesConcentrations,
+                                                                                               dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations,
+                                                                                               dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations );
+    }
+    else
+    {
+      massActions::calculateTotalAndMobileAggregatePrimaryConcentrations< REAL_TYPE,
+                                                                          INT_TYPE,
+                                                                          INDEX_TYPE >( params.equilibriumReactionsParameters(),
+                                                                                        logPrimarySpeciesConcentrations,
+                                                                                        logSecondarySpeciesConcentrations,
+                                                                                        aggregatePrimarySpeciesConcentrations,
+                                                                                        mobileAggregatePrimarySpeciesConcentrations );
+    }
   }
   else
   {
@@ -80,29 +100,38 @@ MixedEquilibriumKineticReactions< REAL_TYPE,
       REAL_TYPE const speciesConcentration_i = exp( logPrimarySpeciesConcentrations[i] );
       aggregatePrimarySpeciesConcentrations[i] = speciesConcentration_i;
       mobileAggregatePrimarySpeciesConcentrations[i] = speciesConcentration_i;
-      dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations( i, i ) = speciesConcentration_i;
-      dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations( i, i ) = speciesConcentration_i;
+      if constexpr( CALCULATE_DERIVATIVES )
+      {
+        dAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations( i, i ) = speciesConcentration_i;
+        dMobileAggregatePrimarySpeciesConcentrations_dLogPrimarySpeciesConcentrations( i, i ) = speciesConcentration_i;
+      }
     }
   }
 
   if constexpr( PARAMS_DATA::numKineticReactions() > 0 )
   {
     // 2. Compute the reaction rates for all kinetic reactions
-    computeReactionRates( temperature,
-                          params,
-                          logPrimarySpeciesConcentrations,
-                          logSecondarySpeciesConcentrations,
-                          surfaceArea,
-                          reactionRates,
-                          dReactionRates_dLogPrimarySpeciesConcentrations );
+    computeReactionRates_impl< PARAMS_DATA, CALCULATE_DERIVATIVES >( temperature,
+                                                                     params,
+                                                                     logPrimarySpeciesConcentrations,
+                                                                     logSecondarySpeciesConcentrations,
+                                                                     surfaceArea,
+                                                                     reactionRates,
+                                                                     dReactionRates_dLogPrimarySpeciesConcentrations );
 
     // 3. Compute aggregate species rates
-    computeAggregateSpeciesRates( params,
-                                  logPrimarySpeciesConcentrations,
-                                  reactionRates,
-                                  dReactionRates_dLogPrimarySpeciesConcentrations,
-                                  aggregateSpeciesRates,
-                                  dAggregateSpeciesRates_dLogPrimarySpeciesConcentrations );
+    computeAggregateSpeciesRates_impl< PARAMS_DATA,
+                                       ARRAY_1D_TO_CONST,
+                                       ARRAY_1D_KINETIC,
+                                       ARRAY_2D_KINETIC,
+                                       ARRAY_1D_PRIMARY,
+                                       ARRAY_2D_PRIMARY,
+                                       CALCULATE_DERIVATIVES >( params,
+                                                                logPrimarySpeciesConcentrations,
+                                                                reactionRates,
+                                                                dReactionRates_dLogPrimarySpeciesConcentrations,
+                                                                aggregateSpeciesRates,
+                                                                dAggregateSpeciesRates_dLogPrimarySpeciesConcentrations );
   }
   else
   {
@@ -116,6 +145,7 @@ template< typename REAL_TYPE,
           typename INDEX_TYPE,
           bool LOGE_CONCENTRATION >
 template< typename PARAMS_DATA,
+          bool CALCULATE_DERIVATIVES,
           typename ARRAY_1D_TO_CONST,
           typename ARRAY_1D_TO_CONST2,
           typename ARRAY_1D_TO_CONST_KINETIC,
@@ -150,36 +180,71 @@ MixedEquilibriumKineticReactions< REAL_TYPE,
     logSpeciesConcentration[i+numSecondarySpecies] = logPrimarySpeciesConcentrations[i];
   }
 
-  for( INDEX_TYPE i = 0; i < numKineticReactions; ++i )
+  if constexpr( !CALCULATE_DERIVATIVES )
+  {
+    HPCREACT_UNUSED_VAR( dReactionRates_dLogPrimarySpeciesConcentrations );
+
+    char reactionRatesDerivatives;
+    kineticReactions::template computeReactionRates< false >( temperature,
+                                                              params.kineticReactionsParameters(),
+                                                              logSpeciesConcentration,
+                                                              surfaceArea,
+                                                              reactionRates,
+                                                              reactionRatesDerivatives );
+  }
+  else
   {
-    for( INDEX_TYPE j = 0; j < numPrimarySpecies; ++j )
+    for( INDEX_TYPE i = 0; i < numKineticReactions; ++i )
     {
-      dReactionRates_dLogPrimarySpeciesConcentrations[i][j] = 0.0;
+      for( INDEX_TYPE j = 0; j < numPrimarySpecies; ++j )
+      {
+        dReactionRates_dLogPrimarySpeciesConcentrations[i][j] = 0.0;
+      }
     }
-  }
-
-  CArrayWrapper< RealType, numKineticReactions, numSpecies > reactionRatesDerivatives;
 
-  kineticReactions::computeReactionRates( temperature,
-                                          params.kineticReactionsParameters(),
-                                          logSpeciesConcentration,
-                                          surfaceArea,
-                                          reactionRates,
-                                          reactionRatesDerivatives );
+    auto const & kineticParams = params.kineticReactionsParameters();
+    auto const & kineticStoichiometry = kineticParams.sparseStoichiometry();
 
-  // Compute the reaction rates derivatives w.r.t. log primary species concentrations
-  for( IntType i = 0; i < numKineticReactions; ++i )
-  {
-    for( IntType j = 0; j < numPrimarySpecies; ++j )
+    // Each kinetic rate only depends on the species of its reaction, so the chain rule through the
+    // secondary species is applied to the sparse derivatives of one reaction at a time, and the
+    // kinetic reactions x species derivative matrix is never stored.
+    RealType reactionRateDerivatives[numSpecies];
+    for( IntType i = 0; i < numKineticReactions; ++i )
     {
-      dReactionRates_dLogPrimarySpeciesConcentrations( i, j ) = reactionRatesDerivatives( i, j + numSecondarySpecies );
+      kineticReactions::computeReactionRate( temperature,
+                                             kineticParams,
+                                             logSpeciesConcentration,
+                                             surfaceArea,
+                                             i,
+                                             reactionRates[i],
+                                             reactionRateDerivatives );
 
-      for( IntType k = 0; k < numSecondarySpecies; ++k )
+      int const iBegin = kineticStoichiometry.reactionBegin( i );
+      for( int n = iBegin; n < kineticStoichiometry.reactionEnd( i ); ++n )
       {
-        RealType const dLogSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentrations = params.stoichiometricMatrix( k, j + numSecondarySpecies );
+        IntType const species = kineticStoichiometry.reactionSpecies( n );
+        RealType const dReactionRate_dLogSpeciesConcentration = reactionRateDerivatives[n-iBegin];
+        if( species >= numSecondarySpecies )
+        {
+          dReactionRates_dLogPrimarySpeciesConcentrations( i, species - numSecondarySpecies ) += dReactionRate_dLogSpeciesConcentration;
+        }
+        else if constexpr( numSecondarySpecies > 0 )
+        {
+          // secondary species k only depends on the primary species in equilibrium reaction k
+          auto const & stoichiometry = params.equilibriumReactionsParameters().sparseStoichiometry();
+          IntType const k = species;
+          for( int m = stoichiometry.reactionBegin( k ); m < stoichiometry.reactionEnd( k ); ++m )
+          {
+            IntType const j = stoichiometry.reactionSpecies( m ) - numSecondarySpecies;
+            if( j >= 0 )
+            {
+              RealType const dLogSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentrations = stoichiometry.reactionCoefficient( m );
 
-        dReactionRates_dLogPrimarySpeciesConcentrations( i, j ) +=
-          reactionRatesDerivatives( i, k ) * dLogSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentrations;
+              dReactionRates_dLogPrimarySpeciesConcentrations( i, j ) +=
+                dReactionRate_dLogSpeciesConcentration * dLogSecondarySpeciesConcentrations_dLogPrimarySpeciesConcentrations;
+            }
+          }
+        }
       }
     }
   }
@@ -224,18 +289,30 @@ MixedEquilibriumKineticReactions< REAL_TYPE,
         aggregatesRatesDerivatives( i, j ) = 0.0;
       }
     }
-    for( IntType r=0; r<numKineticReactions; ++r )
+    if constexpr( numKineticReactions > 0 )
     {
-      RealType const s_ir = params.kineticReactionsParameters().stoichiometricMatrix( r, i+numSecondarySpecies );
-      aggregatesRates[i] += s_ir * reactionRates[r];
-      if constexpr( CALCULATE_DERIVATIVES )
+      // only the kinetic reactions that involve primary species i contribute
+      auto const & stoichiometry = params.kineticReactionsParameters().sparseStoichiometry();
+      for( int m = stoichiometry.speciesBegin( i+numSecondarySpecies ); m < stoichiometry.speciesEnd( i+numSecondarySpecies ); ++m )
       {
-        for( IntType j = 0; j < numPrimarySpecies; ++j )
+        IntType const r = stoichiometry.speciesReaction( m );
+        RealType const s_ir = stoichiometry.speciesCoefficient( m );
+        aggregatesRates[i] += s_ir * reactionRates[r];
+        if constexpr( CALCULATE_DERIVATIVES )
         {
-          aggregatesRatesDerivatives( i, j ) += s_ir * reactionRatesDerivatives( r, j );
+          for( IntType j = 0; j < numPrimarySpecies; ++j )
+          {
+            aggregatesRatesDerivatives( i, j ) += s_ir * reactionRatesDerivatives( r, j );
+          }
         }
       }
     }
+    else
+    {
+      HPCREACT_UNUSED_VAR( params );
+      HPCREACT_UNUSED_VAR( reactionRates );
+      HPCREACT_UNUSED_VAR( reactionRatesDerivatives );
+    }
   }
 
 }
@@ -15,9 +15,12 @@
 #include "common/constants.hpp"
 #include "common/CArrayWrapper.hpp"
 #include "common/macros.hpp"
+#include "SparseStoichiometry.hpp"
 
+#include <cmath>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace hpcReact
@@ -32,13 +35,17 @@ template< typename REAL_TYPE,
           typename INDEX_TYPE,
           int NUM_SPECIES,
           int NUM_REACTIONS,
-          int NUM_SURFACE_REACTIONS = 0 >
+          int NUM_SURFACE_REACTIONS = 0,
+          int NUM_NONZEROS = NUM_REACTIONS * NUM_SPECIES >
 struct EquilibriumReactionsParameters
 {
   using RealType = REAL_TYPE;
   using IntType = INT_TYPE;
   using IndexType = INDEX_TYPE;
 
+  /// The sparse view of the stoichiometric matrix, sized by the number of nonzero coefficients.
+  using SparseStoichiometryType = SparseStoichiometry< IndexType, NUM_REACTIONS, NUM_SPECIES, NUM_NONZEROS >;
+
   HPCREACT_HOST_DEVICE static constexpr IndexType numSpecies() { return NUM_SPECIES; }
 
   HPCREACT_HOST_DEVICE static constexpr IndexType numReactions() { return NUM_REACTIONS; }
@@ -56,32 +63,42 @@ struct EquilibriumReactionsParameters
   EquilibriumReactionsParameters( CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > const & stoichiometricMatrix,
                                   CArrayWrapper< RealType, NUM_REACTIONS > equilibriumConstant,
                                   CArrayWrapper< IntType, NUM_REACTIONS > mobileSecondarySpeciesFlag ):
-    m_stoichiometricMatrix( stoichiometricMatrix ),
     m_equilibriumConstant( equilibriumConstant ),
-    m_mobileSecondarySpeciesFlag( mobileSecondarySpeciesFlag )
+    m_mobileSecondarySpeciesFlag( mobileSecondarySpeciesFlag ),
+    m_stoichiometricMatrix( stoichiometricMatrix ),
+    m_sparseStoichiometry( stoichiometricMatrix )
   {}
 
 
-  HPCREACT_HOST_DEVICE IndexType stoichiometricMatrix( IndexType const r, int const i ) const { return m_stoichiometricMatrix[r][i]; }
+  HPCREACT_HOST_DEVICE constexpr IndexType stoichiometricMatrix( IndexType const r, int const i ) const { return m_stoichiometricMatrix( r, i ); }
+  HPCREACT_HOST_DEVICE constexpr SparseStoichiometryType const & sparseStoichiometry() const { return m_sparseStoichiometry; }
   HPCREACT_HOST_DEVICE RealType equilibriumConstant( IndexType const r ) const { return m_equilibriumConstant[r]; }
   HPCREACT_HOST_DEVICE IntType mobileSecondarySpeciesFlag( IndexType const r ) const { return m_mobileSecondarySpeciesFlag[r]; }
 
-  CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > m_stoichiometricMatrix;
   CArrayWrapper< RealType, NUM_REACTIONS > m_equilibriumConstant;
   CArrayWrapper< IntType, NUM_REACTIONS > m_mobileSecondarySpeciesFlag;
+
+private:
+  // The sparse view is built from the dense matrix at construction, so neither may change afterwards.
+  CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > m_stoichiometricMatrix;
+  SparseStoichiometryType m_sparseStoichiometry;
 };
 
 template< typename REAL_TYPE,
           typename INT_TYPE,
           typename INDEX_TYPE,
           int NUM_SPECIES,
-          int NUM_REACTIONS >
+          int NUM_REACTIONS,
+          int NUM_NONZEROS = NUM_REACTIONS * NUM_SPECIES >
 struct KineticReactionsParameters
 {
   using RealType = REAL_TYPE;
   using IntType = INT_TYPE;
   using IndexType = INDEX_TYPE;
 
+  /// The sparse view of the stoichiometric matrix, sized by the number of nonzero coefficients.
+  using SparseStoichiometryType = SparseStoichiometry< IndexType, NUM_REACTIONS, NUM_SPECIES, NUM_NONZEROS >;
+
   HPCREACT_HOST_DEVICE static constexpr IndexType numSpecies() { return NUM_SPECIES; }
 
   HPCREACT_HOST_DEVICE static constexpr IndexType numReactions() { return NUM_REACTIONS; }
@@ -92,36 +109,54 @@ struct KineticReactionsParameters
                                         CArrayWrapper< RealType, NUM_REACTIONS > const & rateConstantReverse,
                                         CArrayWrapper< RealType, NUM_REACTIONS > const & equilibriumConstant,
                                         IntType const reactionRatesUpdateOption ):
-    m_stoichiometricMatrix( stoichiometricMatrix ),
     m_rateConstantForward( rateConstantForward ),
     m_rateConstantReverse( rateConstantReverse ),
     m_equilibiriumConstant( equilibriumConstant ), // Initialize to empty array
-    m_reactionRatesUpdateOption( reactionRatesUpdateOption )
+    m_reactionRatesUpdateOption( reactionRatesUpdateOption ),
+    m_stoichiometricMatrix( stoichiometricMatrix ),
+    m_sparseStoichiometry( stoichiometricMatrix )
   {}
 
 
-  HPCREACT_HOST_DEVICE IndexType stoichiometricMatrix( IndexType const r, int const i ) const { return m_stoichiometricMatrix[r][i]; }
+  HPCREACT_HOST_DEVICE constexpr IndexType stoichiometricMatrix( IndexType const r, int const i ) const { return m_stoichiometricMatrix( r, i ); }
+  HPCREACT_HOST_DEVICE constexpr SparseStoichiometryType const & sparseStoichiometry() const { return m_sparseStoichiometry; }
   HPCREACT_HOST_DEVICE RealType rateConstantForward( IndexType const r ) const { return m_rateConstantForward[r]; }
   HPCREACT_HOST_DEVICE RealType rateConstantReverse( IndexType const r ) const { return m_rateConstantReverse[r]; }
   HPCREACT_HOST_DEVICE RealType equilibriumConstant( IndexType const r ) const { return m_rateConstantForward[r] / m_rateConstantReverse[r]; }
 
   HPCREACT_HOST_DEVICE IntType reactionRatesUpdateOption() const { return m_reactionRatesUpdateOption; }
 
-  CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > m_stoichiometricMatrix;
   CArrayWrapper< RealType, NUM_REACTIONS > m_rateConstantForward;
   CArrayWrapper< RealType, NUM_REACTIONS > m_rateConstantReverse;
   CArrayWrapper< RealType, NUM_REACTIONS > m_equilibiriumConstant;
 
   IntType m_reactionRatesUpdateOption; // 0: forward and reverse rate. 1: quotient form.
+
+private:
+  // The sparse view is built from the dense matrix at construction, so neither may change afterwards.
+  CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > m_stoichiometricMatrix;
+  SparseStoichiometryType m_sparseStoichiometry;
 };
 
 
+/**
+ * @brief The parameters of a system of equilibrium and kinetic reactions.
+ * @tparam NUM_EQ_REACTIONS The number of equilibrium reactions, which are the first rows of the
+ *   stoichiometric matrix.
+ * @tparam NUM_EQUILIBRIUM_NONZEROS The number of nonzero coefficients in the equilibrium rows, which sizes
+ *   the sparse stoichiometry of the equilibrium sub-system (see countNonzeros()).
+ * @tparam NUM_KINETIC_NONZEROS The number of nonzero coefficients in the kinetic rows.
+ * @details The stoichiometry is only stored in the equilibrium and kinetic sub-systems, which the
+ *   reaction kernels use directly.
+ */
 template< typename REAL_TYPE,
           typename INT_TYPE,
           typename INDEX_TYPE,
           int NUM_SPECIES,
           int NUM_REACTIONS,
-          int NUM_EQ_REACTIONS >
+          int NUM_EQ_REACTIONS,
+          int NUM_EQUILIBRIUM_NONZEROS = NUM_EQ_REACTIONS * NUM_SPECIES,
+          int NUM_KINETIC_NONZEROS = ( NUM_REACTIONS - NUM_EQ_REACTIONS ) * NUM_SPECIES >
 struct MixedReactionsParameters
 {
 
@@ -137,12 +172,12 @@ struct MixedReactionsParameters
                                       CArrayWrapper< RealType, NUM_REACTIONS > const & rateConstantReverse,
                                       CArrayWrapper< IntType, NUM_REACTIONS > mobileSecondarySpeciesFlag,
                                       IntType const reactionRatesUpdateOption = 1 ):
-    m_stoichiometricMatrix( stoichiometricMatrix ),
     m_equilibriumConstant( equilibriumConstant ),
     m_rateConstantForward( rateConstantForward ),
     m_rateConstantReverse( rateConstantReverse ),
-    m_mobileSecondarySpeciesFlag( mobileSecondarySpeciesFlag ),
-    m_reactionRatesUpdateOption( reactionRatesUpdateOption )
+    m_reactionRatesUpdateOption( reactionRatesUpdateOption ),
+    m_equilibriumReactionsParameters( makeEquilibriumReactionsParameters( stoichiometricMatrix, mobileSecondarySpeciesFlag ) ),
+    m_kineticReactionsParameters( makeKineticReactionsParameters( stoichiometricMatrix ) )
   {}
 
   HPCREACT_HOST_DEVICE static constexpr IndexType numReactions() { return NUM_REACTIONS; }
@@ -157,50 +192,183 @@ struct MixedReactionsParameters
 
   HPCREACT_HOST_DEVICE static constexpr IndexType numSecondarySpecies() { return NUM_EQ_REACTIONS; }
 
+  /// The type of the parameters of the equilibrium reactions of the system.
+  using EquilibriumReactionsParametersType = EquilibriumReactionsParameters< RealType, IntType, IndexType, NUM_SPECIES, NUM_EQ_REACTIONS, 0, NUM_EQUILIBRIUM_NONZEROS >;
+
+  /// The type of the parameters of the kinetic reactions of the system.
+  using KineticReactionsParametersType = KineticReactionsParameters< RealType, IntType, IndexType, NUM_SPECIES, NUM_REACTIONS - NUM_EQ_REACTIONS, NUM_KINETIC_NONZEROS >;
+
+  // The equilibrium and kinetic sub-systems, including their sparse stoichiometries, are built once at
+  // construction, since they are accessed from the per-cell kernels on every Newton iteration. A sub-system
+  // without reactions is stored as a placeholder, since its arrays would have zero size.
+  HPCREACT_HOST_DEVICE
+  constexpr EquilibriumReactionsParametersType const & equilibriumReactionsParameters() const
+  {
+    static_assert( NUM_EQ_REACTIONS > 0, "the system has no equilibrium reactions" );
+    return m_equilibriumReactionsParameters;
+  }
+
+  HPCREACT_HOST_DEVICE
+  constexpr KineticReactionsParametersType const & kineticReactionsParameters() const
+  {
+    static_assert( NUM_REACTIONS - NUM_EQ_REACTIONS > 0, "the system has no kinetic reactions" );
+    return m_kineticReactionsParameters;
+  }
+
+private:
+  using EquilibriumReactionsParametersStorage = std::conditional_t< ( NUM_EQ_REACTIONS > 0 ), EquilibriumReactionsParametersType, char >;
+  using KineticReactionsParametersStorage = std::conditional_t< ( NUM_REACTIONS - NUM_EQ_REACTIONS > 0 ), KineticReactionsParametersType, char >;
+
   HPCREACT_HOST_DEVICE
   constexpr
-  EquilibriumReactionsParameters< RealType, IntType, IndexType, numSpecies(), numEquilibriumReactions() >
-  equilibriumReactionsParameters() const
+  EquilibriumReactionsParametersStorage
+  makeEquilibriumReactionsParameters( CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > const & stoichiometricMatrix,
+                                      CArrayWrapper< IntType, NUM_REACTIONS > const & mobileSecondarySpeciesFlag ) const
   {
-    CArrayWrapper< IndexType, numEquilibriumReactions(), numSpecies() > eqMatrix{};
-    CArrayWrapper< RealType, numEquilibriumReactions() > eqConstants{};
-    CArrayWrapper< IntType, numEquilibriumReactions() > mobileSpeciesFlags{};
+    if constexpr( NUM_EQ_REACTIONS > 0 )
+    {
+      CArrayWrapper< IndexType, numEquilibriumReactions(), numSpecies() > eqMatrix{};
+      CArrayWrapper< RealType, numEquilibriumReactions() > eqConstants{};
+      CArrayWrapper< IntType, numEquilibriumReactions() > mobileSpeciesFlags{};
+
+      for( IntType i = 0; i < numEquilibriumReactions(); ++i )
+      {
+        for( IntType j = 0; j < numSpecies(); ++j )
+        {
+          eqMatrix( i, j ) = stoichiometricMatrix( i, j );
+        }
+        eqConstants( i ) = m_equilibriumConstant( i );
+        mobileSpeciesFlags( i ) = mobileSecondarySpeciesFlag( i );
+      }
 
-    for( IntType i = 0; i < numEquilibriumReactions(); ++i )
+      return { eqMatrix, eqConstants, mobileSpeciesFlags };
+    }
+    else
     {
-      for( IntType j = 0; j < numSpecies(); ++j )
+      HPCREACT_UNUSED_VAR( stoichiometricMatrix );
+      HPCREACT_UNUSED_VAR( mobileSecondarySpeciesFlag );
+      return 0;
+    }
+  }
+
+  HPCREACT_HOST_DEVICE
+  constexpr
+  KineticReactionsParametersStorage
+  makeKineticReactionsParameters( CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > const & stoichiometricMatrix ) const
+  {
+    if constexpr( NUM_REACTIONS - NUM_EQ_REACTIONS > 0 )
+    {
+      CArrayWrapper< IndexType, numKineticReactions(), numSpecies() > kineticMatrix{};
+      CArrayWrapper< RealType, numKineticReactions() > rateConstantForward{};
+      CArrayWrapper< RealType, numKineticReactions() > rateConstantReverse{};
+      CArrayWrapper< RealType, numKineticReactions() > equilibriumConstant{};
+
+      for( IndexType i = 0; i < numKineticReactions(); ++i )
       {
-        eqMatrix( i, j ) = m_stoichiometricMatrix( i, j );
+        for( IndexType j = 0; j < numSpecies(); ++j )
+        {
+          kineticMatrix( i, j ) = stoichiometricMatrix( numEquilibriumReactions() + i, j );
+        }
+        rateConstantForward( i ) = m_rateConstantForward( numEquilibriumReactions() + i );
+        rateConstantReverse( i ) = m_rateConstantReverse( numEquilibriumReactions() + i );
+        equilibriumConstant( i ) = m_equilibriumConstant( numEquilibriumReactions() + i );
       }
-      eqConstants( i ) = m_equilibriumConstant( i );
-      mobileSpeciesFlags( i ) = m_mobileSecondarySpeciesFlag( i );
+
+      return { kineticMatrix, rateConstantForward, rateConstantReverse, equilibriumConstant, m_reactionRatesUpdateOption };
+    }
+    else
+    {
+      HPCREACT_UNUSED_VAR( stoichiometricMatrix );
+      return 0;
     }
+  }
 
-    return { eqMatrix, eqConstants, mobileSpeciesFlags };
+  // Copies the reaction constants into the sub-systems after they have been completed or modified.
+  HPCREACT_HOST_DEVICE
+  void updateSubSystemConstants()
+  {
+    if constexpr( NUM_EQ_REACTIONS > 0 )
+    {
+      for( IntType i = 0; i < numEquilibriumReactions(); ++i )
+      {
+        m_equilibriumReactionsParameters.m_equilibriumConstant( i ) = m_equilibriumConstant( i );
+      }
+    }
+    if constexpr( NUM_REACTIONS - NUM_EQ_REACTIONS > 0 )
+    {
+      for( IntType i = 0; i < numKineticReactions(); ++i )
+      {
+        m_kineticReactionsParameters.m_rateConstantForward( i ) = m_rateConstantForward( numEquilibriumReactions() + i );
+        m_kineticReactionsParameters.m_rateConstantReverse( i ) = m_rateConstantReverse( numEquilibriumReactions() + i );
+        m_kineticReactionsParameters.m_equilibiriumConstant( i ) = m_equilibriumConstant( numEquilibriumReactions() + i );
+      }
+    }
   }
 
+public:
+
+  // Structural nonzeros of the Jacobian of the aggregate primary species equations with respect to the log
+  // primary species concentrations, d( T - dt * R ) / dlogCp, as assembled from updateMixedSystem.
   HPCREACT_HOST_DEVICE
   constexpr
-  KineticReactionsParameters< RealType, IntType, IndexType, numSpecies(), numKineticReactions() >
-  kineticReactionsParameters() const
+  CArrayWrapper< bool, numPrimarySpecies(), numPrimarySpecies() >
+  aggregateJacobianSparsityPattern() const
   {
-    CArrayWrapper< IndexType, numKineticReactions(), numSpecies() > kineticMatrix{};
-    CArrayWrapper< RealType, numKineticReactions() > rateConstantForward{};
-    CArrayWrapper< RealType, numKineticReactions() > rateConstantReverse{};
-    CArrayWrapper< RealType, numKineticReactions() > equilibriumConstant{};
+    constexpr int numSec = numSecondarySpecies();
+    CArrayWrapper< bool, numPrimarySpecies(), numPrimarySpecies() > pattern{};
+
+    for( int i = 0; i < numPrimarySpecies(); ++i )
+    {
+      pattern( i, i ) = true;
+    }
 
-    for( IndexType i = 0; i < numKineticReactions(); ++i )
+    // the aggregate concentrations couple all primary species of an equilibrium reaction
+    for( int r = 0; r < numEquilibriumReactions(); ++r )
     {
-      for( IndexType j = 0; j < numSpecies(); ++j )
+      for( int i = 0; i < numPrimarySpecies(); ++i )
       {
-        kineticMatrix( i, j ) = m_stoichiometricMatrix( numEquilibriumReactions() + i, j );
+        for( int j = 0; j < numPrimarySpecies(); ++j )
+        {
+          if( stoichiometricMatrix( r, numSec + i ) != 0 && stoichiometricMatrix( r, numSec + j ) != 0 )
+          {
+            pattern( i, j ) = true;
+          }
+        }
       }
-      rateConstantForward( i ) = m_rateConstantForward( numEquilibriumReactions() + i );
-      rateConstantReverse( i ) = m_rateConstantReverse( numEquilibriumReactions() + i );
-      equilibriumConstant( i ) = m_equilibriumConstant( numEquilibriumReactions() + i );
     }
 
-    return { kineticMatrix, rateConstantForward, rateConstantReverse, equilibriumConstant, m_reactionRatesUpdateOption };
+    // a kinetic rate depends on the primary species of the reaction, and on the primary species of the
+    // equilibrium reactions defining each secondary species in the reaction.
+    for( int r = numEquilibriumReactions(); r < numReactions(); ++r )
+    {
+      CArrayWrapper< bool, numPrimarySpecies() > dependsOn{};
+      for( int j = 0; j < numPrimarySpecies(); ++j )
+      {
+        dependsOn( j ) = stoichiometricMatrix( r, numSec + j ) != 0;
+      }
+      for( int k = 0; k < numSec; ++k )
+      {
+        if( stoichiometricMatrix( r, k ) != 0 )
+        {
+          for( int j = 0; j < numPrimarySpecies(); ++j )
+          {
+            dependsOn( j ) = dependsOn( j ) || stoichiometricMatrix( k, numSec + j ) != 0;
+          }
+        }
+      }
+
+      for( int i = 0; i < numPrimarySpecies(); ++i )
+      {
+        if( stoichiometricMatrix( r, numSec + i ) != 0 )
+        {
+          for( int j = 0; j < numPrimarySpecies(); ++j )
+          {
+            pattern( i, j ) = pattern( i, j ) || dependsOn( j );
+          }
+        }
+      }
+    }
+    return pattern;
   }
 
   HPCREACT_HOST_DEVICE
@@ -237,20 +405,40 @@ struct MixedReactionsParameters
         }
       }
     }
+    updateSubSystemConstants();
   }
 
-  HPCREACT_HOST_DEVICE IndexType stoichiometricMatrix( IndexType const r, int const i ) const { return m_stoichiometricMatrix[r][i]; }
+  // Reaction r of the full system, with the equilibrium reactions first.
+  HPCREACT_HOST_DEVICE
+  constexpr IndexType stoichiometricMatrix( IndexType const r, int const i ) const
+  {
+    if constexpr( NUM_EQ_REACTIONS == 0 )
+    {
+      return m_kineticReactionsParameters.stoichiometricMatrix( r, i );
+    }
+    else if constexpr( NUM_REACTIONS == NUM_EQ_REACTIONS )
+    {
+      return m_equilibriumReactionsParameters.stoichiometricMatrix( r, i );
+    }
+    else
+    {
+      return r < NUM_EQ_REACTIONS ? m_equilibriumReactionsParameters.stoichiometricMatrix( r, i )
+                                  : m_kineticReactionsParameters.stoichiometricMatrix( r - NUM_EQ_REACTIONS, i );
+    }
+  }
   HPCREACT_HOST_DEVICE RealType equilibriumConstant( IndexType const r ) const { return m_equilibriumConstant[r]; }
   HPCREACT_HOST_DEVICE RealType rateConstantForward( IndexType const r ) const { return m_rateConstantForward[r]; }
   HPCREACT_HOST_DEVICE RealType rateConstantReverse( IndexType const r ) const { return m_rateConstantReverse[r]; }
 
-  CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > m_stoichiometricMatrix;
+private:
   CArrayWrapper< RealType, NUM_REACTIONS > m_equilibriumConstant;
   CArrayWrapper< RealType, NUM_REACTIONS > m_rateConstantForward;
   CArrayWrapper< RealType, NUM_REACTIONS > m_rateConstantReverse;
-  CArrayWrapper< IntType, NUM_REACTIONS > m_mobileSecondarySpeciesFlag;
 
   IntType m_reactionRatesUpdateOption; // 0: forward and reverse rate. 1: quotient form.
+
+  EquilibriumReactionsParametersStorage m_equilibriumReactionsParameters;
+  KineticReactionsParametersStorage m_kineticReactionsParameters;
 };
 
 
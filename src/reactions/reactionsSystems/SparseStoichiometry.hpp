@@ -0,0 +1,220 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "common/CArrayWrapper.hpp"
+#include "common/macros.hpp"
+
+/** @file SparseStoichiometry.hpp
+ *  @brief Compressed row/column view of a stoichiometric matrix.
+ *  @author HPC-REACT Team
+ *  @date 2025
+ */
+
+namespace hpcReact
+{
+namespace reactionsSystems
+{
+
+/**
+ * @brief The number of nonzero entries in a range of rows of a stoichiometric matrix.
+ * @tparam INDEX_TYPE The type of the stoichiometric coefficients.
+ * @tparam NUM_REACTIONS The number of reactions (rows of the dense matrix).
+ * @tparam NUM_SPECIES The number of species (columns of the dense matrix).
+ * @param stoichiometricMatrix The dense (reactions x species) stoichiometric matrix.
+ * @param firstReaction The first row counted.
+ * @param lastReaction One past the last row counted.
+ * @return The number of nonzeros in rows [firstReaction, lastReaction).
+ * @details Used to size the SparseStoichiometry of a constexpr matrix exactly.
+ */
+template< typename INDEX_TYPE, int NUM_REACTIONS, int NUM_SPECIES >
+HPCREACT_HOST_DEVICE
+constexpr int countNonzeros( CArrayWrapper< INDEX_TYPE, NUM_REACTIONS, NUM_SPECIES > const & stoichiometricMatrix,
+                             int const firstReaction = 0,
+                             int const lastReaction = NUM_REACTIONS )
+{
+  int count = 0;
+  for( int r = firstReaction; r < lastReaction; ++r )
+  {
+    for( int i = 0; i < NUM_SPECIES; ++i )
+    {
+      count += stoichiometricMatrix( r, i ) != 0 ? 1 : 0;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Compressed storage of the nonzero entries of a stoichiometric matrix.
+ * @tparam INDEX_TYPE The type used to store the stoichiometric coefficients and
+ *         the species/reaction indices.
+ * @tparam NUM_REACTIONS The number of reactions (rows of the dense matrix).
+ * @tparam NUM_SPECIES The number of species (columns of the dense matrix).
+ * @tparam MAX_NONZEROS The capacity of the entry arrays. It must be at least the
+ *         number of nonzeros of the matrix, e.g. countNonzeros() of a constexpr
+ *         matrix. A constexpr object with too small a capacity does not compile.
+ * @details
+ *   Geochemical stoichiometric matrices are mostly zeros (e.g. the ultramafic
+ *   system has ~10% nonzeros), so kernels that loop over the dense matrix spend
+ *   most of their time skipping zeros. This struct holds two compressed views
+ *   of the same matrix:
+ *   - a reaction-major (CSR) view listing, for each reaction, the species that
+ *     participate in it along with their coefficients.
+ *   - a species-major (CSC) view listing, for each species, the reactions it
+ *     participates in along with their coefficients.
+ *
+ *   Both views list their entries in ascending index order, so sums evaluated
+ *   over the sparse views accumulate in the same order as the dense loops.
+ *
+ *   The constructor is constexpr, so when the parameter object is a constexpr
+ *   global the sparse view is generated at compile time. The arrays are private,
+ *   so the view can only be built from a complete matrix.
+ */
+template< typename INDEX_TYPE, int NUM_REACTIONS, int NUM_SPECIES, int MAX_NONZEROS = NUM_REACTIONS * NUM_SPECIES >
+struct SparseStoichiometry
+{
+  /// Type alias for the coefficient/index type.
+  using IndexType = INDEX_TYPE;
+
+  /**
+   * @brief The maximum number of nonzeros that can be stored.
+   * @return MAX_NONZEROS
+   */
+  HPCREACT_HOST_DEVICE static constexpr int capacity() { return MAX_NONZEROS; }
+
+  /// Default constructor
+  constexpr SparseStoichiometry() = default;
+
+  /**
+   * @brief Construct the compressed views from a dense stoichiometric matrix.
+   * @param stoichiometricMatrix The dense (reactions x species) stoichiometric matrix.
+   */
+  HPCREACT_HOST_DEVICE
+  constexpr SparseStoichiometry( CArrayWrapper< IndexType, NUM_REACTIONS, NUM_SPECIES > const & stoichiometricMatrix )
+  {
+    int count = 0;
+    for( int r = 0; r < NUM_REACTIONS; ++r )
+    {
+      m_reactionOffsets[r] = count;
+      for( int i = 0; i < NUM_SPECIES; ++i )
+      {
+        if( stoichiometricMatrix( r, i ) != 0 )
+        {
+          m_reactionSpecies[count] = i;
+          m_reactionCoefficients[count] = stoichiometricMatrix( r, i );
+          ++count;
+        }
+      }
+    }
+    m_reactionOffsets[NUM_REACTIONS] = count;
+
+    count = 0;
+    for( int i = 0; i < NUM_SPECIES; ++i )
+    {
+      m_speciesOffsets[i] = count;
+      for( int r = 0; r < NUM_REACTIONS; ++r )
+      {
+        if( stoichiometricMatrix( r, i ) != 0 )
+        {
+          m_speciesReactions[count] = r;
+          m_speciesCoefficients[count] = stoichiometricMatrix( r, i );
+          ++count;
+        }
+      }
+    }
+    m_speciesOffsets[NUM_SPECIES] = count;
+  }
+
+  /**
+   * @brief The number of nonzero entries in the stoichiometric matrix.
+   * @return the number of nonzeros.
+   */
+  HPCREACT_HOST_DEVICE constexpr int numNonzeros() const { return m_reactionOffsets[NUM_REACTIONS]; }
+
+  /**
+   * @brief First entry of reaction @p r in the reaction-major view.
+   * @param r The reaction index.
+   * @return The index of the first entry.
+   */
+  HPCREACT_HOST_DEVICE constexpr int reactionBegin( int const r ) const { return m_reactionOffsets[r]; }
+
+  /**
+   * @brief One past the last entry of reaction @p r in the reaction-major view.
+   * @param r The reaction index.
+   * @return The index one past the last entry.
+   */
+  HPCREACT_HOST_DEVICE constexpr int reactionEnd( int const r ) const { return m_reactionOffsets[r+1]; }
+
+  /**
+   * @brief The species index of entry @p k in the reaction-major view.
+   * @param k The entry index.
+   * @return The species index.
+   */
+  HPCREACT_HOST_DEVICE constexpr IndexType reactionSpecies( int const k ) const { return m_reactionSpecies[k]; }
+
+  /**
+   * @brief The stoichiometric coefficient of entry @p k in the reaction-major view.
+   * @param k The entry index.
+   * @return The stoichiometric coefficient.
+   */
+  HPCREACT_HOST_DEVICE constexpr IndexType reactionCoefficient( int const k ) const { return m_reactionCoefficients[k]; }
+
+  /**
+   * @brief First entry of species @p i in the species-major view.
+   * @param i The species index.
+   * @return The index of the first entry.
+   */
+  HPCREACT_HOST_DEVICE constexpr int speciesBegin( int const i ) const { return m_speciesOffsets[i]; }
+
+  /**
+   * @brief One past the last entry of species @p i in the species-major view.
+   * @param i The species index.
+   * @return The index one past the last entry.
+   */
+  HPCREACT_HOST_DEVICE constexpr int speciesEnd( int const i ) const { return m_speciesOffsets[i+1]; }
+
+  /**
+   * @brief The reaction index of entry @p k in the species-major view.
+   * @param k The entry index.
+   * @return The reaction index.
+   */
+  HPCREACT_HOST_DEVICE constexpr IndexType speciesReaction( int const k ) const { return m_speciesReactions[k]; }
+
+  /**
+   * @brief The stoichiometric coefficient of entry @p k in the species-major view.
+   * @param k The entry index.
+   * @return The stoichiometric coefficient.
+   */
+  HPCREACT_HOST_DEVICE constexpr IndexType speciesCoefficient( int const k ) const { return m_speciesCoefficients[k]; }
+
+private:
+  /// Offsets into the reaction-major arrays. Reaction r occupies [m_reactionOffsets[r], m_reactionOffsets[r+1]).
+  CArrayWrapper< int, NUM_REACTIONS + 1 > m_reactionOffsets;
+
+  /// Species index of each reaction-major entry.
+  CArrayWrapper< IndexType, capacity() > m_reactionSpecies;
+
+  /// Stoichiometric coefficient of each reaction-major entry.
+  CArrayWrapper< IndexType, capacity() > m_reactionCoefficients;
+
+  /// Offsets into the species-major arrays. Species i occupies [m_speciesOffsets[i], m_speciesOffsets[i+1]).
+  CArrayWrapper< int, NUM_SPECIES + 1 > m_speciesOffsets;
+
+  /// Reaction index of each species-major entry.
+  CArrayWrapper< IndexType, capacity() > m_speciesReactions;
+
+  /// Stoichiometric coefficient of each species-major entry.
+  CArrayWrapper< IndexType, capacity() > m_speciesCoefficients;
+};
+
+} // namespace reactionsSystems
+} // namespace hpcReact
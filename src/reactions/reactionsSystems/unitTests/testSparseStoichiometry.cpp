@@ -0,0 +1,138 @@
+/*
+ * ------------------------------------------------------------------------------------------------------------
+ * SPDX-License-Identifier: (BSD-3-Clause)
+ *
+ * Copyright (c) 2025- Lawrence Livermore National Security LLC
+ * All rights reserved
+ *
+ * See top level LICENSE files for details.
+ * ------------------------------------------------------------------------------------------------------------
+ */
+
+#include "../SparseStoichiometry.hpp"
+#include "reactions/geochemistry/GeochemicalSystems.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace hpcReact;
+using namespace hpcReact::reactionsSystems;
+using namespace hpcReact::geochemistry;
+
+// the sparse views are built at compile time for constexpr parameter objects, and sized by their nonzeros
+static_assert( ultramaficSystem.equilibriumReactionsParameters().sparseStoichiometry().numNonzeros() > 0 );
+static_assert( ultramaficSystem.equilibriumReactionsParameters().sparseStoichiometry().numNonzeros() ==
+               ultramaficSystem.equilibriumReactionsParameters().sparseStoichiometry().capacity() );
+static_assert( ultramaficSystem.kineticReactionsParameters().sparseStoichiometry().numNonzeros() ==
+               ultramaficSystem.kineticReactionsParameters().sparseStoichiometry().capacity() );
+static_assert( forgeSystem.kineticReactionsParameters().sparseStoichiometry().capacity() <
+               forgeSystemType::numKineticReactions() * forgeSystemType::numSpecies() );
+
+// the mixed system returns the rows of its sub-systems, equilibrium reactions first
+template< typename PARAMS, typename MATRIX >
+void checkMixedStoichiometricMatrix( PARAMS const & params, MATRIX const & stoichiometricMatrix )
+{
+  for( int r = 0; r < PARAMS::numReactions(); ++r )
+  {
+    for( int i = 0; i < PARAMS::numSpecies(); ++i )
+    {
+      EXPECT_EQ( params.stoichiometricMatrix( r, i ), stoichiometricMatrix( r, i ) );
+    }
+  }
+}
+
+template< typename PARAMS >
+void checkSparseStoichiometry( PARAMS const & params )
+{
+  constexpr int numReactions = PARAMS::numReactions();
+  constexpr int numSpecies = PARAMS::numSpecies();
+  auto const & stoichiometry = params.sparseStoichiometry();
+
+  int numNonzeros = 0;
+  for( int r = 0; r < numReactions; ++r )
+  {
+    for( int i = 0; i < numSpecies; ++i )
+    {
+      if( params.stoichiometricMatrix( r, i ) != 0 )
+      {
+        ++numNonzeros;
+      }
+    }
+  }
+  EXPECT_EQ( stoichiometry.numNonzeros(), numNonzeros );
+  EXPECT_EQ( stoichiometry.reactionEnd( numReactions - 1 ), numNonzeros );
+  EXPECT_EQ( stoichiometry.speciesEnd( numSpecies - 1 ), numNonzeros );
+
+  // expand the reaction-major view and compare with the dense matrix
+  int dense[numReactions][numSpecies] = {};
+  for( int r = 0; r < numReactions; ++r )
+  {
+    for( int k = stoichiometry.reactionBegin( r ); k < stoichiometry.reactionEnd( r ); ++k )
+    {
+      if( k > stoichiometry.reactionBegin( r ) )
+      {
+        EXPECT_LT( stoichiometry.reactionSpecies( k - 1 ), stoichiometry.reactionSpecies( k ) );
+      }
+      dense[r][stoichiometry.reactionSpecies( k )] = stoichiometry.reactionCoefficient( k );
+    }
+  }
+  for( int r = 0; r < numReactions; ++r )
+  {
+    for( int i = 0; i < numSpecies; ++i )
+    {
+      EXPECT_EQ( dense[r][i], params.stoichiometricMatrix( r, i ) );
+      dense[r][i] = 0;
+    }
+  }
+
+  // expand the species-major view and compare with the dense matrix
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    for( int k = stoichiometry.speciesBegin( i ); k < stoichiometry.speciesEnd( i ); ++k )
+    {
+      if( k > stoichiometry.speciesBegin( i ) )
+      {
+        EXPECT_LT( stoichiometry.speciesReaction( k - 1 ), stoichiometry.speciesReaction( k ) );
+      }
+      dense[stoichiometry.speciesReaction( k )][i] = stoichiometry.speciesCoefficient( k );
+    }
+  }
+  for( int r = 0; r < numReactions; ++r )
+  {
+    for( int i = 0; i < numSpecies; ++i )
+    {
+      EXPECT_EQ( dense[r][i], params.stoichiometricMatrix( r, i ) );
+    }
+  }
+}
+
+TEST( testSparseStoichiometry, testUltramafics )
+{
+  checkSparseStoichiometry( ultramaficSystem.equilibriumReactionsParameters() );
+  checkSparseStoichiometry( ultramaficSystem.kineticReactionsParameters() );
+  checkMixedStoichiometricMatrix( ultramaficSystem, ultramafics::stoichMatrix );
+}
+
+TEST( testSparseStoichiometry, testCarbonate )
+{
+  checkSparseStoichiometry( carbonateSystem.equilibriumReactionsParameters() );
+  checkSparseStoichiometry( carbonateSystem.kineticReactionsParameters() );
+  checkSparseStoichiometry( carbonateSystemAllEquilibrium.equilibriumReactionsParameters() );
+  checkSparseStoichiometry( carbonateSystemAllKinetic.kineticReactionsParameters() );
+  checkMixedStoichiometricMatrix( carbonateSystem, carbonate::stoichMatrixNosolid );
+  checkMixedStoichiometricMatrix( carbonateSystemAllEquilibrium, carbonate::stoichMatrix );
+  checkMixedStoichiometricMatrix( carbonateSystemAllKinetic, carbonate::stoichMatrix );
+}
+
+TEST( testSparseStoichiometry, testForge )
+{
+  checkSparseStoichiometry( forgeSystem.equilibriumReactionsParameters() );
+  checkSparseStoichiometry( forgeSystem.kineticReactionsParameters() );
+  checkMixedStoichiometricMatrix( forgeSystem, forge::soichMatrix );
+}
+
+int main( int argc, char * * argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  int const result = RUN_ALL_TESTS();
+  return result;
+}
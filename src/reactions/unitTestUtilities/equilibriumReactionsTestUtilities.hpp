@@ -117,6 +117,9 @@ struct TestEnforceEquilibriumData
 
   /// The final species concentrations
   double speciesConcentration[numSpecies];
+
+  /// The statistics of the equilibrium solve
+  nonlinearSolvers::SolverStats stats;
 };
 
 template< typename REAL_TYPE,
@@ -142,12 +145,17 @@ void testEnforceEquilibrium( PARAMS_DATA const & params,
 
   pmpl::genericKernelWrapper( 1, &data, [params, temperature] HPCREACT_DEVICE ( auto * const dataCopy )
       {
-        EquilibriumReactionsType::enforceEquilibrium_Extents( temperature,
-                                                              params,
-                                                              dataCopy->speciesConcentration0,
-                                                              dataCopy->speciesConcentration );
+        dataCopy->stats = EquilibriumReactionsType::enforceEquilibrium_Extents( temperature,
+                                                                                params,
+                                                                                dataCopy->speciesConcentration0,
+                                                                                dataCopy->speciesConcentration );
       } );
 
+  EXPECT_TRUE( data.stats.isConverged );
+  EXPECT_EQ( data.stats.numLinearSolves, data.stats.numIterations );
+  EXPECT_EQ( data.stats.numResidualEvaluations, data.stats.numIterations + data.stats.numBacktracks + 1 );
+  EXPECT_LT( data.stats.finalResidualNorm, 1.0e-12 );
+
   for( int r=0; r<numSpecies; ++r )
   {
 //    printf( "c[%d] = %22.14e\n", r, speciesConcentration[r] );
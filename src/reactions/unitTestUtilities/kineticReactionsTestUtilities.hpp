@@ -232,12 +232,15 @@ struct TimeStepTestData
 
 template< typename REAL_TYPE,
           bool LOGE_CONCENTRATION,
-          typename PARAMS_DATA >
+          typename PARAMS_DATA,
+          typename GLOBALIZATION = nonlinearSolvers::FullNewtonStep >
 void timeStepTest( PARAMS_DATA const & params,
                    REAL_TYPE const dt,
                    int const numSteps,
                    REAL_TYPE const (&initialSpeciesConcentration)[PARAMS_DATA::numSpecies()],
-                   REAL_TYPE const (&expectedSpeciesConcentrations)[PARAMS_DATA::numSpecies()] )
+                   REAL_TYPE const (&expectedSpeciesConcentrations)[PARAMS_DATA::numSpecies()],
+                   nonlinearSolvers::SolverControls< PARAMS_DATA::numSpecies() > const & controls = nonlinearSolvers::SolverControls< PARAMS_DATA::numSpecies() >( 20, 1.0e-14 ),
+                   GLOBALIZATION const & globalization = GLOBALIZATION{} )
 {
   using KineticReactionsType = reactionsSystems::KineticReactions< REAL_TYPE,
                                                                    int,
@@ -266,7 +269,7 @@ void timeStepTest( PARAMS_DATA const & params,
 
   data.time = 0.0;
 
-  pmpl::genericKernelWrapper( 1, &data, [params, temperature, dt, numSteps] HPCREACT_DEVICE ( auto * const dataCopy )
+  pmpl::genericKernelWrapper( 1, &data, [params, temperature, dt, numSteps, controls, globalization] HPCREACT_DEVICE ( auto * const dataCopy )
       {
         double speciesConcentration_n[numSpecies];
         double speciesRates[numSpecies] = { 0.0 };
@@ -285,7 +288,9 @@ void timeStepTest( PARAMS_DATA const & params,
                                           speciesConcentration_n,
                                           dataCopy->speciesConcentration,
                                           speciesRates,
-                                          speciesRatesDerivatives );
+                                          speciesRatesDerivatives,
+                                          controls,
+                                          globalization );
           dataCopy->time += dt;
         }
       } );
@@ -303,5 +308,177 @@ void timeStepTest( PARAMS_DATA const & params,
   }
 }
 
+/**
+ * POD struct for transferring data between host and device for timeStepPredictorTest.
+ * @tparam numSpecies Number of species.
+ */
+template< int numSpecies >
+struct TimeStepPredictorTestData
+{
+  /// The species concentrations
+  double speciesConcentration[numSpecies];
+
+  /// The extrapolation of the initial guesses
+  nonlinearSolvers::TimeStepPredictor< double, numSpecies > predictor;
+
+  /// The statistics accumulated over the time steps
+  nonlinearSolvers::SolverStats stats;
+};
+
+template< typename REAL_TYPE,
+          typename PARAMS_DATA >
+nonlinearSolvers::SolverStats
+timeStepPredictorTest( PARAMS_DATA const & params,
+                       REAL_TYPE const dt,
+                       int const numSteps,
+                       int const order,
+                       REAL_TYPE const (&initialSpeciesConcentration)[PARAMS_DATA::numSpecies()],
+                       REAL_TYPE const (&expectedSpeciesConcentrations)[PARAMS_DATA::numSpecies()] )
+{
+  using KineticReactionsType = reactionsSystems::KineticReactions< REAL_TYPE,
+                                                                   int,
+                                                                   int,
+                                                                   false >;
+
+  static constexpr int numSpecies = PARAMS_DATA::numSpecies();
+  double const temperature = 298.15;
+  TimeStepPredictorTestData< numSpecies > data;
+  data.predictor.order = order;
+  data.predictor.measureSavings = true;
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    data.speciesConcentration[i] = initialSpeciesConcentration[i];
+  }
+
+  pmpl::genericKernelWrapper( 1, &data, [params, temperature, dt, numSteps] HPCREACT_DEVICE ( auto * const dataCopy )
+      {
+        double speciesConcentration_n[numSpecies];
+        double speciesRates[numSpecies] = { 0.0 };
+        CArrayWrapper< double, numSpecies, numSpecies > speciesRatesDerivatives;
+
+        for( int t = 0; t < numSteps; ++t )
+        {
+          for( int i=0; i<numSpecies; ++i )
+          {
+            speciesConcentration_n[i] = dataCopy->speciesConcentration[i];
+          }
+          nonlinearSolvers::accumulate( dataCopy->stats,
+                                        KineticReactionsType::timeStep( dt,
+                                                                        temperature,
+                                                                        params,
+                                                                        speciesConcentration_n,
+                                                                        dataCopy->speciesConcentration,
+                                                                        speciesRates,
+                                                                        speciesRatesDerivatives,
+                                                                        dataCopy->predictor ) );
+        }
+      } );
+
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    EXPECT_NEAR( data.speciesConcentration[i], expectedSpeciesConcentrations[i], 1.0e-4 );
+  }
+  return data.stats;
+}
+
+//******************************************************************************
+
+/**
+ * POD struct for transferring data between host and device for computeReactionRatesBatchedTest.
+ * @tparam numReactions Number of reactions.
+ * @tparam numSpecies Number of species.
+ * @tparam numCells Number of cells in the batch.
+ */
+template< int numReactions, int numSpecies, int numCells >
+struct ComputeReactionRatesBatchedTestData
+{
+  /// The log species concentrations of the batch, species-major
+  double logSpeciesConcentration[numSpecies * numCells];
+
+  /// The surface areas of the batch, reaction-major
+  double surfaceArea[numReactions * numCells];
+
+  /// The reaction rates of the batch, reaction-major
+  double reactionRates[numReactions * numCells] = { 0.0 };
+
+  /// The reaction rates evaluated one cell at a time, reaction-major
+  double expectedReactionRates[numReactions * numCells] = { 0.0 };
+};
+
+template< typename REAL_TYPE,
+          int numCells,
+          typename PARAMS_DATA >
+void computeReactionRatesBatchedTest( PARAMS_DATA const & params,
+                                      REAL_TYPE const (&speciesConcentration)[PARAMS_DATA::numSpecies()] )
+{
+  using KineticReactionsType = reactionsSystems::KineticReactions< REAL_TYPE,
+                                                                   int,
+                                                                   int,
+                                                                   true >;
+
+  static constexpr int numSpecies = PARAMS_DATA::numSpecies();
+  static constexpr int numReactions = PARAMS_DATA::numReactions();
+
+  double const temperature = 298.15;
+  ComputeReactionRatesBatchedTestData< numReactions, numSpecies, numCells > data;
+
+  // perturb the concentrations of each cell so that no two cells are the same
+  for( int i = 0; i < numSpecies; ++i )
+  {
+    for( int c = 0; c < numCells; ++c )
+    {
+      data.logSpeciesConcentration[i * numCells + c] = log( speciesConcentration[i] * ( 1.0 + 0.01 * ( ( i + c ) % 7 ) ) );
+    }
+  }
+  for( int r = 0; r < numReactions; ++r )
+  {
+    for( int c = 0; c < numCells; ++c )
+    {
+      data.surfaceArea[r * numCells + c] = 1.0 + 0.1 * ( ( r + 2 * c ) % 5 );
+    }
+  }
+
+  pmpl::genericKernelWrapper( 1, &data, [params, temperature] HPCREACT_DEVICE ( auto * const dataCopy )
+      {
+        KineticReactionsType::computeReactionRatesBatched( temperature,
+                                                           params,
+                                                           numCells,
+                                                           dataCopy->logSpeciesConcentration,
+                                                           dataCopy->surfaceArea,
+                                                           dataCopy->reactionRates );
+
+        for( int c = 0; c < numCells; ++c )
+        {
+          double logConcentration[numSpecies];
+          double surfaceArea[numReactions];
+          double reactionRates[numReactions];
+          char reactionRatesDerivatives;
+          for( int i = 0; i < numSpecies; ++i )
+          {
+            logConcentration[i] = dataCopy->logSpeciesConcentration[i * numCells + c];
+          }
+          for( int r = 0; r < numReactions; ++r )
+          {
+            surfaceArea[r] = dataCopy->surfaceArea[r * numCells + c];
+          }
+          KineticReactionsType::template computeReactionRates< false >( temperature,
+                                                                        params,
+                                                                        logConcentration,
+                                                                        surfaceArea,
+                                                                        reactionRates,
+                                                                        reactionRatesDerivatives );
+          for( int r = 0; r < numReactions; ++r )
+          {
+            dataCopy->expectedReactionRates[r * numCells + c] = reactionRates[r];
+          }
+        }
+      } );
+
+  for( int k = 0; k < numReactions * numCells; ++k )
+  {
+    EXPECT_DOUBLE_EQ( data.reactionRates[k], data.expectedReactionRates[k] );
+  }
+}
+
 } // namespace unitTest_utilities
 } // namespace hpcReact
@@ -17,6 +17,7 @@
 #include "common/printers.hpp"
 #include "common/nonlinearSolvers.hpp"
 #include "common/pmpl.hpp"
+#include "common/SparseDirectSystemSolve.hpp"
 
 #include <gtest/gtest.h>
 
@@ -29,16 +30,16 @@ namespace unitTest_utilities
 //******************************************************************************
 template< typename REAL_TYPE,
           bool LOGE_CONCENTRATION,
-          typename PARAMS_DATA >
+          typename PARAMS_DATA,
+          typename LINEAR_SOLVER = PivotedLUSolver >
 void timeStepTest( PARAMS_DATA const & params,
                    REAL_TYPE const dt,
                    int const numSteps,
                    REAL_TYPE const (&initialSpeciesConcentration)[PARAMS_DATA::numPrimarySpecies()],
                    REAL_TYPE const (&surfaceArea)[PARAMS_DATA::numKineticReactions()],
-                   REAL_TYPE const (&expectedSpeciesConcentrations)[PARAMS_DATA::numPrimarySpecies()] )
+                   REAL_TYPE const (&expectedSpeciesConcentrations)[PARAMS_DATA::numPrimarySpecies()],
+                   LINEAR_SOLVER const & linearSolver = LINEAR_SOLVER{} )
 {
-  HPCREACT_UNUSED_VAR( expectedSpeciesConcentrations );
-
   CArrayWrapper< REAL_TYPE, PARAMS_DATA::numPrimarySpecies() > primarySpeciesConcentration;
 
   for( int i = 0; i < PARAMS_DATA::numPrimarySpecies(); ++i )
@@ -130,7 +131,10 @@ void timeStepTest( PARAMS_DATA const & params,
         }
       };
 
-          nonlinearSolvers::newtonRaphson< numPrimarySpecies >( logPrimarySpeciesConcentration, computeResidualAndJacobian );
+          nonlinearSolvers::newtonRaphson< numPrimarySpecies >( logPrimarySpeciesConcentration,
+                                                                computeResidualAndJacobian,
+                                                                nonlinearSolvers::SolverControls< numPrimarySpecies >(),
+                                                                linearSolver );
 
           time += dt;
         }
@@ -147,6 +151,399 @@ void timeStepTest( PARAMS_DATA const & params,
   }
 }
 
+//******************************************************************************
+
+/**
+ * POD struct for transferring data between host and device for warmStartTimeStepTest.
+ * @tparam numPrimarySpecies Number of primary species.
+ * @tparam numKineticReactions Number of kinetic reactions.
+ */
+template< int numPrimarySpecies, int numKineticReactions >
+struct WarmStartTimeStepTestData
+{
+  /// The primary species concentrations
+  double primarySpeciesConcentration[numPrimarySpecies];
+  /// The surface areas of the kinetic reactions
+  double surfaceArea[numKineticReactions];
+
+  /// The solution and Jacobian factorization persisted across the time steps
+  nonlinearSolvers::WarmStartState< double, numPrimarySpecies > warmStart;
+
+  /// The extrapolation of the initial guesses
+  nonlinearSolvers::TimeStepPredictor< double, numPrimarySpecies > predictor;
+
+  /// The statistics accumulated over the time steps
+  nonlinearSolvers::SolverStats stats;
+};
+
+template< typename PARAMS_DATA >
+nonlinearSolvers::SolverStats
+warmStartTimeStepTest( PARAMS_DATA const & params,
+                       double const dt,
+                       int const numSteps,
+                       bool const usePredictor,
+                       double const (&initialSpeciesConcentration)[PARAMS_DATA::numPrimarySpecies()],
+                       double const (&surfaceArea)[PARAMS_DATA::numKineticReactions()],
+                       double const (&expectedSpeciesConcentrations)[PARAMS_DATA::numPrimarySpecies()],
+                       int & numFactorizations )
+{
+  using MixedReactionsType = reactionsSystems::MixedEquilibriumKineticReactions< double,
+                                                                                 int,
+                                                                                 int,
+                                                                                 true >;
+  using EquilibriumReactionsType = reactionsSystems::EquilibriumReactions< double,
+                                                                           int,
+                                                                           int >;
+
+  static constexpr int numPrimarySpecies   = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
+  static constexpr int numKineticReactions = PARAMS_DATA::numKineticReactions();
+
+  WarmStartTimeStepTestData< numPrimarySpecies, numKineticReactions > data;
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    data.primarySpeciesConcentration[i] = initialSpeciesConcentration[i];
+  }
+  for( int r = 0; r < numKineticReactions; ++r )
+  {
+    data.surfaceArea[r] = surfaceArea[r];
+  }
+
+  pmpl::genericKernelWrapper( 1, &data, [params, dt, numSteps, usePredictor] HPCREACT_DEVICE ( auto * const dataCopy )
+      {
+        double const temperature = 298.15;
+        double logPrimarySpeciesConcentration[numPrimarySpecies];
+        CArrayWrapper< double, numSecondarySpecies > logSecondarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies > aggregatePrimarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies > aggregatePrimarySpeciesConcentration_n;
+        CArrayWrapper< double, numPrimarySpecies > mobileAggregatePrimarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregatePrimarySpeciesConcentrations_dlogPrimarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dMobileAggregatePrimarySpeciesConcentrations_dlogPrimarySpeciesConcentration;
+        CArrayWrapper< double, numKineticReactions > reactionRates;
+        CArrayWrapper< double, numKineticReactions, numPrimarySpecies > dReactionRates_dlogPrimarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies > aggregateSpeciesRates;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregateSpeciesRates_dlogPrimarySpeciesConcentration;
+
+        for( int i = 0; i < numPrimarySpecies; ++i )
+        {
+          logPrimarySpeciesConcentration[i] = log( dataCopy->primarySpeciesConcentration[i] );
+          aggregatePrimarySpeciesConcentration[i] = dataCopy->primarySpeciesConcentration[i];
+        }
+
+        EquilibriumReactionsType::enforceEquilibrium_LogAggregate( temperature,
+                                                                   params.equilibriumReactionsParameters(),
+                                                                   logPrimarySpeciesConcentration,
+                                                                   logPrimarySpeciesConcentration );
+        dataCopy->predictor.accept( logPrimarySpeciesConcentration, 0.0 );
+
+        for( int t = 0; t < numSteps; ++t )
+        {
+          for( int i=0; i < numPrimarySpecies; ++i )
+          {
+            aggregatePrimarySpeciesConcentration_n[i] = aggregatePrimarySpeciesConcentration[i];
+          }
+
+          auto computeResidual = [&] ( double const (&X)[numPrimarySpecies],
+                                       double ( & r )[numPrimarySpecies] )
+          {
+            MixedReactionsType::updateMixedSystem( temperature,
+                                                   params,
+                                                   X,
+                                                   dataCopy->surfaceArea,
+                                                   logSecondarySpeciesConcentration,
+                                                   aggregatePrimarySpeciesConcentration,
+                                                   mobileAggregatePrimarySpeciesConcentration,
+                                                   reactionRates,
+                                                   aggregateSpeciesRates );
+
+            for( int i = 0; i < numPrimarySpecies; ++i )
+            {
+              r[i] = ( aggregatePrimarySpeciesConcentration[i] - aggregatePrimarySpeciesConcentration_n[i] ) - aggregateSpeciesRates[i] * dt;
+            }
+          };
+
+          auto computeResidualAndJacobian = [&] ( double const (&X)[numPrimarySpecies],
+                                                  double ( & r )[numPrimarySpecies],
+                                                  double ( & J )[numPrimarySpecies][numPrimarySpecies] )
+          {
+            MixedReactionsType::updateMixedSystem( temperature,
+                                                   params,
+                                                   X,
+                                                   dataCopy->surfaceArea,
+                                                   logSecondarySpeciesConcentration,
+                                                   aggregatePrimarySpeciesConcentration,
+                                                   mobileAggregatePrimarySpeciesConcentration,
+                                                   dAggregatePrimarySpeciesConcentrations_dlogPrimarySpeciesConcentration,
+                                                   dMobileAggregatePrimarySpeciesConcentrations_dlogPrimarySpeciesConcentration,
+                                                   reactionRates,
+                                                   dReactionRates_dlogPrimarySpeciesConcentration,
+                                                   aggregateSpeciesRates,
+                                                   dAggregateSpeciesRates_dlogPrimarySpeciesConcentration );
+
+            for( int i = 0; i < numPrimarySpecies; ++i )
+            {
+              r[i] = ( aggregatePrimarySpeciesConcentration[i] - aggregatePrimarySpeciesConcentration_n[i] ) - aggregateSpeciesRates[i] * dt;
+              for( int j = 0; j < numPrimarySpecies; ++j )
+              {
+                J[i][j] = dAggregatePrimarySpeciesConcentrations_dlogPrimarySpeciesConcentration[i][j] - dAggregateSpeciesRates_dlogPrimarySpeciesConcentration[i][j] * dt;
+              }
+            }
+          };
+
+          // the warm start begins from the extrapolated solution instead of the last one
+          if( usePredictor && dataCopy->warmStart.hasSolution )
+          {
+            dataCopy->predictor.predict( dt, dataCopy->warmStart.solution );
+          }
+          nonlinearSolvers::SolverStats const stats =
+            nonlinearSolvers::newtonRaphsonWarmStart< numPrimarySpecies >( logPrimarySpeciesConcentration,
+                                                                           computeResidual,
+                                                                           computeResidualAndJacobian,
+                                                                           dataCopy->warmStart,
+                                                                           nonlinearSolvers::SolverControls< numPrimarySpecies >( 12, 1e-12 ) );
+          dataCopy->warmStart.lastStepSize = dt;
+          if( stats.isConverged )
+          {
+            dataCopy->predictor.accept( logPrimarySpeciesConcentration, dt );
+          }
+          nonlinearSolvers::accumulate( dataCopy->stats, stats );
+        }
+
+        for( int i = 0; i < numPrimarySpecies; ++i )
+        {
+          dataCopy->primarySpeciesConcentration[i] = exp( logPrimarySpeciesConcentration[i] );
+        }
+      } );
+
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    EXPECT_NEAR( data.primarySpeciesConcentration[i], expectedSpeciesConcentrations[i], 1.0e-8 * expectedSpeciesConcentrations[i] );
+  }
+  numFactorizations = data.warmStart.chord.numFactorizations;
+  return data.stats;
+}
+
+//******************************************************************************
+
+/**
+ * POD struct for transferring data between host and device for sparseJacobianSolveTest.
+ * @tparam numPrimarySpecies Number of primary species.
+ * @tparam numKineticReactions Number of kinetic reactions.
+ */
+template< int numPrimarySpecies, int numKineticReactions >
+struct SparseJacobianSolveTestData
+{
+  /// The log primary species concentrations
+  double logPrimarySpeciesConcentration[numPrimarySpecies];
+  /// The surface areas of the kinetic reactions
+  double surfaceArea[numKineticReactions];
+
+  /// The Jacobian of the time step residual
+  double jacobian[numPrimarySpecies][numPrimarySpecies];
+  /// The right hand side, the time step residual
+  double residual[numPrimarySpecies];
+
+  /// The solution with the sparse LU
+  double xSparse[numPrimarySpecies];
+  /// The solution with the dense pivoted LU
+  double xPivoted[numPrimarySpecies];
+  /// Whether the sparse LU accepted its fixed pivot sequence
+  bool isSparseFactorAccepted;
+};
+
+template< typename PARAMS_DATA >
+void sparseJacobianSolveTest( PARAMS_DATA const & params,
+                              SparseLUSymbolic< PARAMS_DATA::numPrimarySpecies() > const & symbolic,
+                              double const dt,
+                              double const (&primarySpeciesConcentration)[PARAMS_DATA::numPrimarySpecies()],
+                              double const (&surfaceArea)[PARAMS_DATA::numKineticReactions()] )
+{
+  using MixedReactionsType = reactionsSystems::MixedEquilibriumKineticReactions< double,
+                                                                                 int,
+                                                                                 int,
+                                                                                 true >;
+
+  static constexpr int numPrimarySpecies   = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
+  static constexpr int numKineticReactions = PARAMS_DATA::numKineticReactions();
+
+  SparseJacobianSolveTestData< numPrimarySpecies, numKineticReactions > data;
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    data.logPrimarySpeciesConcentration[i] = log( primarySpeciesConcentration[i] );
+  }
+  for( int r = 0; r < numKineticReactions; ++r )
+  {
+    data.surfaceArea[r] = surfaceArea[r];
+  }
+
+  pmpl::genericKernelWrapper( 1, &data, [params, symbolic, dt] HPCREACT_DEVICE ( auto * const dataCopy )
+      {
+        double const temperature = 298.15;
+        CArrayWrapper< double, numSecondarySpecies > logSecondarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies > aggregatePrimarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies > mobileAggregatePrimarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregatePrimarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dMobileAggregatePrimarySpeciesConcentration;
+        CArrayWrapper< double, numKineticReactions > reactionRates;
+        CArrayWrapper< double, numKineticReactions, numPrimarySpecies > dReactionRates;
+        CArrayWrapper< double, numPrimarySpecies > aggregateSpeciesRates;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregateSpeciesRates;
+
+        MixedReactionsType::updateMixedSystem( temperature,
+                                               params,
+                                               dataCopy->logPrimarySpeciesConcentration,
+                                               dataCopy->surfaceArea,
+                                               logSecondarySpeciesConcentration,
+                                               aggregatePrimarySpeciesConcentration,
+                                               mobileAggregatePrimarySpeciesConcentration,
+                                               dAggregatePrimarySpeciesConcentration,
+                                               dMobileAggregatePrimarySpeciesConcentration,
+                                               reactionRates,
+                                               dReactionRates,
+                                               aggregateSpeciesRates,
+                                               dAggregateSpeciesRates );
+
+        // the Jacobian of a time step from the unreacted state, as assembled in timeStepTest
+        for( int i = 0; i < numPrimarySpecies; ++i )
+        {
+          dataCopy->residual[i] = -aggregateSpeciesRates[i] * dt;
+          for( int j = 0; j < numPrimarySpecies; ++j )
+          {
+            dataCopy->jacobian[i][j] = dAggregatePrimarySpeciesConcentration[i][j] - dAggregateSpeciesRates[i][j] * dt;
+          }
+        }
+
+        dataCopy->isSparseFactorAccepted = solveNxN_sparse( symbolic, dataCopy->jacobian, dataCopy->residual, dataCopy->xSparse );
+        solveNxN_pivoted( dataCopy->jacobian, dataCopy->residual, dataCopy->xPivoted );
+      } );
+
+  // the pattern holds every nonzero of the assembled Jacobian
+  CArrayWrapper< bool, numPrimarySpecies, numPrimarySpecies > const pattern = params.aggregateJacobianSparsityPattern();
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    for( int j = 0; j < numPrimarySpecies; ++j )
+    {
+      if( !pattern( i, j ) )
+      {
+        EXPECT_EQ( data.jacobian[i][j], 0.0 );
+      }
+    }
+  }
+
+  EXPECT_TRUE( data.isSparseFactorAccepted );
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    EXPECT_NEAR( data.xSparse[i], data.xPivoted[i], 1.0e-10 * fabs( data.xPivoted[i] ) + 1.0e-14 );
+  }
+}
+
+//******************************************************************************
+
+/**
+ * POD struct for transferring data between host and device for residualOnlyTest.
+ * @tparam numPrimarySpecies Number of primary species.
+ * @tparam numSecondarySpecies Number of secondary species.
+ * @tparam numKineticReactions Number of kinetic reactions.
+ */
+template< int numPrimarySpecies, int numSecondarySpecies, int numKineticReactions >
+struct ResidualOnlyTestData
+{
+  /// The log primary species concentrations
+  double logPrimarySpeciesConcentration[numPrimarySpecies];
+  /// The surface areas of the kinetic reactions
+  double surfaceArea[numKineticReactions];
+
+  /// The outputs of the full path
+  double logSecondarySpeciesConcentration[numSecondarySpecies];
+  double aggregatePrimarySpeciesConcentration[numPrimarySpecies];
+  double mobileAggregatePrimarySpeciesConcentration[numPrimarySpecies];
+  double reactionRates[numKineticReactions];
+  double aggregateSpeciesRates[numPrimarySpecies];
+
+  /// The outputs of the residual-only path
+  double logSecondarySpeciesConcentrationResidual[numSecondarySpecies];
+  double aggregatePrimarySpeciesConcentrationResidual[numPrimarySpecies];
+  double mobileAggregatePrimarySpeciesConcentrationResidual[numPrimarySpecies];
+  double reactionRatesResidual[numKineticReactions];
+  double aggregateSpeciesRatesResidual[numPrimarySpecies];
+};
+
+template< typename REAL_TYPE,
+          typename PARAMS_DATA >
+void residualOnlyTest( PARAMS_DATA const & params,
+                       REAL_TYPE const (&primarySpeciesConcentration)[PARAMS_DATA::numPrimarySpecies()],
+                       REAL_TYPE const (&surfaceArea)[PARAMS_DATA::numKineticReactions()] )
+{
+  using MixedReactionsType = reactionsSystems::MixedEquilibriumKineticReactions< REAL_TYPE,
+                                                                                 int,
+                                                                                 int,
+                                                                                 true >;
+
+  static constexpr int numPrimarySpecies   = PARAMS_DATA::numPrimarySpecies();
+  static constexpr int numSecondarySpecies = PARAMS_DATA::numSecondarySpecies();
+  static constexpr int numKineticReactions = PARAMS_DATA::numKineticReactions();
+
+  ResidualOnlyTestData< numPrimarySpecies, numSecondarySpecies, numKineticReactions > data;
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    data.logPrimarySpeciesConcentration[i] = log( primarySpeciesConcentration[i] );
+  }
+  for( int r = 0; r < numKineticReactions; ++r )
+  {
+    data.surfaceArea[r] = surfaceArea[r];
+  }
+
+  pmpl::genericKernelWrapper( 1, &data, [params] HPCREACT_DEVICE ( auto * const dataCopy )
+      {
+        double const temperature = 298.15;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregatePrimarySpeciesConcentration;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dMobileAggregatePrimarySpeciesConcentration;
+        CArrayWrapper< double, numKineticReactions, numPrimarySpecies > dReactionRates;
+        CArrayWrapper< double, numPrimarySpecies, numPrimarySpecies > dAggregateSpeciesRates;
+
+        MixedReactionsType::updateMixedSystem( temperature,
+                                               params,
+                                               dataCopy->logPrimarySpeciesConcentration,
+                                               dataCopy->surfaceArea,
+                                               dataCopy->logSecondarySpeciesConcentration,
+                                               dataCopy->aggregatePrimarySpeciesConcentration,
+                                               dataCopy->mobileAggregatePrimarySpeciesConcentration,
+                                               dAggregatePrimarySpeciesConcentration,
+                                               dMobileAggregatePrimarySpeciesConcentration,
+                                               dataCopy->reactionRates,
+                                               dReactionRates,
+                                               dataCopy->aggregateSpeciesRates,
+                                               dAggregateSpeciesRates );
+
+        MixedReactionsType::updateMixedSystem( temperature,
+                                               params,
+                                               dataCopy->logPrimarySpeciesConcentration,
+                                               dataCopy->surfaceArea,
+                                               dataCopy->logSecondarySpeciesConcentrationResidual,
+                                               dataCopy->aggregatePrimarySpeciesConcentrationResidual,
+                                               dataCopy->mobileAggregatePrimarySpeciesConcentrationResidual,
+                                               dataCopy->reactionRatesResidual,
+                                               dataCopy->aggregateSpeciesRatesResidual );
+      } );
+
+  // both paths perform the same operations on the values
+  for( int i = 0; i < numSecondarySpecies; ++i )
+  {
+    EXPECT_DOUBLE_EQ( data.logSecondarySpeciesConcentrationResidual[i], data.logSecondarySpeciesConcentration[i] );
+  }
+  for( int i = 0; i < numPrimarySpecies; ++i )
+  {
+    EXPECT_DOUBLE_EQ( data.aggregatePrimarySpeciesConcentrationResidual[i], data.aggregatePrimarySpeciesConcentration[i] );
+    EXPECT_DOUBLE_EQ( data.mobileAggregatePrimarySpeciesConcentrationResidual[i], data.mobileAggregatePrimarySpeciesConcentration[i] );
+    EXPECT_DOUBLE_EQ( data.aggregateSpeciesRatesResidual[i], data.aggregateSpeciesRates[i] );
+  }
+  for( int r = 0; r < numKineticReactions; ++r )
+  {
+    EXPECT_DOUBLE_EQ( data.reactionRatesResidual[r], data.reactionRates[r] );
+  }
+}
+
 
 } // namespace unitTest_utilities
 } // namespace hpcReact